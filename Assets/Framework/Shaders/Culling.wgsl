@@ -0,0 +1,216 @@
+const PHASE_EARLY = 1u;
+const PHASE_LATE = 2u;
+
+struct CullParams
+{
+  planes: array<vec4<f32>, 6>,
+  view_proj: mat4x4<f32>,
+  num_instances: u32,
+  payload_size: u32,
+  phase: u32,
+  num_levels: u32,
+  pyramid_width: u32,
+  pyramid_height: u32
+};
+
+struct CullStats
+{
+  num_frustum_culled: atomic<u32>,
+  num_occluded: atomic<u32>,
+  num_early: atomic<u32>,
+  num_late: atomic<u32>
+};
+
+struct Instance
+{
+  center: vec3<f32>,
+  draw_index: u32,
+  extents: vec3<f32>,
+  payload_index: u32
+};
+
+struct DrawArgs
+{
+  index_count: u32,
+  instance_count: atomic<u32>,
+  first_index: u32,
+  base_vertex: i32,
+  first_instance: u32
+};
+
+@group(0)
+@binding(0)
+var<uniform> params: CullParams;
+
+@group(0)
+@binding(1)
+var<storage, read> instances: array<Instance>;
+
+@group(0)
+@binding(2)
+var<storage, read> payloads: array<vec4<f32>>;
+
+@group(0)
+@binding(3)
+var<storage, read> first_outputs: array<u32>;
+
+@group(0)
+@binding(4)
+var<storage, read_write> draws: array<DrawArgs>;
+
+@group(0)
+@binding(5)
+var<storage, read_write> outputs: array<vec4<f32>>;
+
+@group(0)
+@binding(6)
+var<storage, read_write> visibility: array<u32>;
+
+@group(0)
+@binding(7)
+var<storage, read_write> stats: CullStats;
+
+@group(0)
+@binding(8)
+var depth_pyramid: texture_2d<f32>;
+
+fn is_visible(instance: Instance) -> bool
+{
+  for (var idx = 0u; idx < 6u; idx++)
+  {
+    let plane = params.planes[idx];
+    let distance = dot(instance.center, plane.xyz) + plane.w;
+    let radius = dot(instance.extents, abs(plane.xyz));
+
+    if (distance + radius < 0.0)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+fn is_occluded(instance: Instance) -> bool
+{
+  var rect_min = vec2<f32>(1.0);
+  var rect_max = vec2<f32>(-1.0);
+  var min_depth = 1.0;
+
+  for (var idx = 0u; idx < 8u; idx++)
+  {
+    let corner = vec3<f32>(
+      select(-1.0, 1.0, (idx & 1u) != 0u),
+      select(-1.0, 1.0, (idx & 2u) != 0u),
+      select(-1.0, 1.0, (idx & 4u) != 0u));
+
+    let clip = params.view_proj * vec4<f32>(instance.center + instance.extents * corner, 1.0);
+
+    // boxes crossing the near plane can't be projected, they're always drawn
+    if (clip.w <= 0.0)
+    {
+      return false;
+    }
+
+    let ndc = clip.xyz / clip.w;
+    rect_min = min(rect_min, ndc.xy);
+    rect_max = max(rect_max, ndc.xy);
+    min_depth = min(min_depth, ndc.z);
+  }
+
+  let uv_min = clamp(vec2<f32>(rect_min.x, -rect_max.y) * 0.5 + 0.5, vec2<f32>(0.0), vec2<f32>(1.0));
+  let uv_max = clamp(vec2<f32>(rect_max.x, -rect_min.y) * 0.5 + 0.5, vec2<f32>(0.0), vec2<f32>(1.0));
+
+  // the level where the rect covers at most one texel, so 2x2 texels always enclose it
+  let size = (uv_max - uv_min) * vec2<f32>(f32(params.pyramid_width), f32(params.pyramid_height));
+  let level = min(u32(ceil(log2(max(max(size.x, size.y), 1.0)))), params.num_levels - 1u);
+  let last = vec2<i32>(textureDimensions(depth_pyramid, level)) - 1;
+
+  let texel_min = clamp(vec2<i32>(uv_min * vec2<f32>(last + 1)), vec2<i32>(0), last);
+  let texel_max = clamp(vec2<i32>(uv_max * vec2<f32>(last + 1)), vec2<i32>(0), last);
+
+  let d0 = textureLoad(depth_pyramid, texel_min, i32(level)).r;
+  let d1 = textureLoad(depth_pyramid, vec2<i32>(texel_max.x, texel_min.y), i32(level)).r;
+  let d2 = textureLoad(depth_pyramid, vec2<i32>(texel_min.x, texel_max.y), i32(level)).r;
+  let d3 = textureLoad(depth_pyramid, texel_max, i32(level)).r;
+
+  return min_depth > max(max(d0, d1), max(d2, d3));
+}
+
+fn emit(instance: Instance)
+{
+  let slot = atomicAdd(&draws[instance.draw_index].instance_count, 1u);
+  let dst = (first_outputs[instance.draw_index] + slot) * params.payload_size;
+  let src = instance.payload_index * params.payload_size;
+
+  for (var idx = 0u; idx < params.payload_size; idx++)
+  {
+    outputs[dst + idx] = payloads[src + idx];
+  }
+}
+
+@compute
+@workgroup_size(64)
+fn cs_main(@builtin(global_invocation_id) id: vec3<u32>)
+{
+  if (id.x >= params.num_instances)
+  {
+    return;
+  }
+
+  let instance = instances[id.x];
+  if (is_visible(instance))
+  {
+    emit(instance);
+  }
+}
+
+@compute
+@workgroup_size(64)
+fn cs_occlusion(@builtin(global_invocation_id) id: vec3<u32>)
+{
+  if (id.x >= params.num_instances)
+  {
+    return;
+  }
+
+  let instance = instances[id.x];
+  let in_frustum = is_visible(instance);
+  let drawn_early = in_frustum && visibility[id.x] != 0u;
+
+  // the early phase redraws what was visible last frame, which becomes the depth the pyramid is built from
+  if (params.phase == PHASE_EARLY)
+  {
+    if (drawn_early)
+    {
+      atomicAdd(&stats.num_early, 1u);
+      emit(instance);
+    }
+
+    return;
+  }
+
+  // the late phase re-tests against this frame's pyramid, draws what the early phase missed
+  // and leaves the result for the next frame
+  if (!in_frustum)
+  {
+    atomicAdd(&stats.num_frustum_culled, 1u);
+    visibility[id.x] = 0u;
+    return;
+  }
+
+  if (is_occluded(instance))
+  {
+    atomicAdd(&stats.num_occluded, 1u);
+    visibility[id.x] = 0u;
+    return;
+  }
+
+  if (!drawn_early)
+  {
+    atomicAdd(&stats.num_late, 1u);
+    emit(instance);
+  }
+
+  visibility[id.x] = 1u;
+}
@@ -47,6 +47,7 @@ namespace Trinity
 		virtual bool create(const std::string& fileName, ResourceCache& cache, bool loadContent = true) override;
 		virtual void destroy() override;
 		virtual bool write() override;
+		virtual bool canReadAsync() const override;
 
 		virtual std::type_index getType() const override;
 
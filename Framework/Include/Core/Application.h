@@ -14,6 +14,8 @@ namespace Trinity
     class FileSystem;
     class Input;
     class GraphicsDevice;
+    class BlobCache;
+    class PipelineCache;
     class RenderPass;
     class ImGuiRenderer;
     class ResourceCache;
@@ -27,6 +29,11 @@ namespace Trinity
         uint32_t height{ 768 };
         DisplayMode displayMode{ DisplayMode::Windowed };
         std::string configFile;
+#ifdef __EMSCRIPTEN__
+        std::string cacheFolder;
+#else
+        std::string cacheFolder{ "Cache" };
+#endif
     };
 
     class Application : public Singleton<Application>
@@ -92,6 +99,16 @@ namespace Trinity
             return mResourceCache.get();
         }
 
+        PipelineCache* getPipelineCache() const
+        {
+            return mPipelineCache.get();
+        }
+
+        BlobCache* getBlobCache() const
+        {
+            return mBlobCache.get();
+        }
+
         RenderPass* getMainPass() const
         {
             return mMainPass.get();
@@ -128,8 +145,10 @@ namespace Trinity
         std::unique_ptr<Window> mWindow{ nullptr };
         std::unique_ptr<FileSystem> mFileSystem{ nullptr };
         std::unique_ptr<Input> mInput{ nullptr };
+        std::unique_ptr<BlobCache> mBlobCache{ nullptr };
         std::unique_ptr<GraphicsDevice> mGraphicsDevice{ nullptr };
         std::unique_ptr<ResourceCache> mResourceCache{ nullptr };
+        std::unique_ptr<PipelineCache> mPipelineCache{ nullptr };
         std::unique_ptr<RenderPass> mMainPass{ nullptr };
         std::unique_ptr<ImGuiRenderer> mImGuiRenderer{ nullptr };
     };
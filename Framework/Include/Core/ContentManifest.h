@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Core/Resource.h"
+#include <cstdint>
+#include <map>
+
+namespace Trinity
+{
+	struct ContentEntry
+	{
+		uint64_t hash{ 0 };
+		std::string fileName;
+	};
+
+	class ContentManifest : public Resource
+	{
+	public:
+
+		static constexpr const char* kFileName = "Content.tman";
+
+		ContentManifest() = default;
+		virtual ~ContentManifest() = default;
+
+		ContentManifest(const ContentManifest&) = delete;
+		ContentManifest& operator = (const ContentManifest&) = delete;
+
+		ContentManifest(ContentManifest&&) = default;
+		ContentManifest& operator = (ContentManifest&&) = default;
+
+		const std::map<std::string, ContentEntry>& getEntries() const
+		{
+			return mEntries;
+		}
+
+		virtual bool create(const std::string& fileName, ResourceCache& cache, bool loadContent = true) override;
+		virtual void destroy() override;
+		virtual bool write() override;
+
+		virtual std::type_index getType() const override;
+
+		virtual bool hasEntry(const std::string& name) const;
+		virtual uint64_t getHash(const std::string& name) const;
+		virtual std::string getFileName(const std::string& name) const;
+		virtual void setEntry(const std::string& name, uint64_t hash, const std::string& fileName);
+		virtual void removeMissing();
+
+	protected:
+
+		virtual bool read(FileReader& reader, ResourceCache& cache) override;
+		virtual bool write(FileWriter& writer) override;
+
+	public:
+
+		static ContentManifest* getOrCreate(const std::string& fileName, ResourceCache& cache);
+
+	protected:
+
+		std::map<std::string, ContentEntry> mEntries;
+	};
+}
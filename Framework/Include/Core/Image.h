@@ -68,14 +68,18 @@ namespace Trinity
 		virtual bool create(const std::string& fileName, ResourceCache& cache, bool loadContent = true) override;
 		virtual void destroy() override;
 		virtual bool write() override;
+		virtual bool canReadAsync() const override;
 
 		virtual std::type_index getType() const override;
+		virtual uint64_t getCpuMemorySize() const override;
 
 		virtual bool load(const std::string& filePath);
 		virtual bool load(const std::vector<uint8_t>& data);
 		virtual bool load(uint32_t width, uint32_t height, uint32_t depth, uint32_t channels,
 			ImageType type, const uint8_t* data = nullptr);
 
+		virtual uint64_t getContentHash() const;
+		virtual bool isSameContent(const Image& other) const;
 		virtual std::vector<Mipmap> generateMipmaps() const;
 		virtual glm::vec4 getPixel(uint32_t x, uint32_t y) const;
 		virtual uint32_t getPixelAsRGBA(uint32_t x, uint32_t y) const;
@@ -90,6 +94,10 @@ namespace Trinity
 		virtual bool read(FileReader& reader, ResourceCache& cache) override;
 		virtual bool write(FileWriter& writer) override;
 
+	public:
+
+		static std::string getContentFileName(const Image& image, const std::string& imagesPath, ResourceCache& cache);
+
 	protected:
 
 		ImageType mImageType{ ImageType::TwoD };
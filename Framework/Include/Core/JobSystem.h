@@ -0,0 +1,55 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Trinity
+{
+	class JobSystem
+	{
+	public:
+
+		using Job = std::function<void(uint32_t)>;
+
+		JobSystem() = default;
+		virtual ~JobSystem();
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator = (const JobSystem&) = delete;
+
+		JobSystem(JobSystem&&) = delete;
+		JobSystem& operator = (JobSystem&&) = delete;
+
+		uint32_t getNumThreads() const
+		{
+			return (uint32_t)mThreads.size();
+		}
+
+		virtual bool create(uint32_t numThreads);
+		virtual void destroy();
+
+		virtual void run(uint32_t numJobs, const Job& job);
+
+	protected:
+
+		bool runNext();
+		void execute();
+
+	protected:
+
+		std::vector<std::thread> mThreads;
+		std::mutex mMutex;
+		std::condition_variable mJobsCondition;
+		std::condition_variable mDoneCondition;
+		const Job* mJob{ nullptr };
+		uint32_t mNumJobs{ 0 };
+		uint32_t mNextJob{ 0 };
+		uint32_t mNumDone{ 0 };
+		uint64_t mGeneration{ 0 };
+		bool mExit{ false };
+	};
+}
\ No newline at end of file
@@ -1,28 +1,41 @@
 #pragma once
 
 #include <cstdint>
-#include <string>
-#include <vector>
-#include <unordered_map>
 #include <functional>
+#include <list>
 #include <memory>
-#include <optional>
+#include <unordered_map>
+#include <utility>
 
 namespace Trinity
 {
-	template <typename Key, typename Type, int MaxCacheSize>
+	template <typename Key, typename Type, int MaxCacheSize, typename Hash = std::hash<Key>,
+		typename Allocator = std::allocator<Type>>
 	class ObjectCache
 	{
 	public:
 
+		static_assert(MaxCacheSize > 0, "ObjectCache needs room for at least one object");
+
 		struct CachedObject
 		{
 			std::shared_ptr<Type> object;
 			Key key;
-			uint32_t cacheHit{ 0 };
 		};
 
+		using ObjectAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<CachedObject>;
+		using ObjectList = std::list<CachedObject, ObjectAllocator>;
+		using ObjectIterator = typename ObjectList::iterator;
+		using ObjectMapAllocator = typename std::allocator_traits<Allocator>::template
+			rebind_alloc<std::pair<const Key, ObjectIterator>>;
+		using ObjectMap = std::unordered_map<Key, ObjectIterator, Hash, std::equal_to<Key>, ObjectMapAllocator>;
+
 		ObjectCache() = default;
+		explicit ObjectCache(const Allocator& allocator)
+			: mAllocator(allocator), mObjects(ObjectAllocator(allocator)), mCache(ObjectMapAllocator(allocator))
+		{
+		}
+
 		~ObjectCache()
 		{
 			destroy();
@@ -34,38 +47,77 @@ namespace Trinity
 		ObjectCache(ObjectCache&&) = default;
 		ObjectCache& operator = (ObjectCache&&) = default;
 
+		uint32_t getSize() const
+		{
+			return (uint32_t)mCache.size();
+		}
+
+		uint32_t getCapacity() const
+		{
+			return (uint32_t)MaxCacheSize;
+		}
+
+		uint64_t getNumHits() const
+		{
+			return mNumHits;
+		}
+
+		uint64_t getNumMisses() const
+		{
+			return mNumMisses;
+		}
+
+		uint64_t getNumEvictions() const
+		{
+			return mNumEvictions;
+		}
+
+		const Allocator& getAllocator() const
+		{
+			return mAllocator;
+		}
+
 		void destroy()
 		{
 			mCache.clear();
-			mCacheArray.clear();
+			mObjects.clear();
 		}
 
-		bool exists(const Key& key)
+		bool exists(const Key& key) const
 		{
 			return mCache.find(key) != mCache.end();
 		}
 
-		std::weak_ptr<Type> get(const Key& key) const
+		std::weak_ptr<Type> peek(const Key& key) const
 		{
 			auto it = mCache.find(key);
 			if (it != mCache.end())
 			{
-				return mCacheArray[it->second].object;
+				return it->second->object;
 			}
 
 			return {};
 		}
 
-		template <typename V>
-		std::weak_ptr<V> getAs(const Key& key) const
+		std::weak_ptr<Type> get(const Key& key)
 		{
 			auto it = mCache.find(key);
-			if (it != mCache.end())
+			if (it == mCache.end())
 			{
-				return std::dynamic_pointer_cast<V>(mCacheArray[it->second].object);
+				mNumMisses++;
+				return {};
 			}
 
-			return {};
+			mNumHits++;
+			mObjects.splice(mObjects.begin(), mObjects, it->second);
+
+			return it->second->object;
+		}
+
+		template <typename V>
+		std::weak_ptr<V> getAs(const Key& key)
+		{
+			return std::dynamic_pointer_cast<V>(get(key).lock());
 		}
 
 		std::weak_ptr<Type> add(const Key& key, std::shared_ptr<Type> object)
@@ -73,58 +125,54 @@ namespace Trinity
 			auto it = mCache.find(key);
 			if (it != mCache.end())
 			{
-				CachedObject& cachedObject = mCacheArray[it->second];
-				cachedObject.cacheHit = mHitCounter++;
-
-				return cachedObject.object;
+				mObjects.splice(mObjects.begin(), mObjects, it->second);
+				return it->second->object;
 			}
 
-			if (mCacheArray.size() >= MaxCacheSize)
+			if (mCache.size() >= (size_t)MaxCacheSize)
 			{
-				uint32_t oldCacheHit = mHitCounter;
-				uint32_t oldCacheIdx = MaxCacheSize;
-				std::string oldCacheKey;
-
-				for (uint32_t idx = 0; idx < static_cast<uint32_t>(mCacheArray.size()); idx++)
-				{
-					CachedObject& cachedObject = mCacheArray[idx];
-					if (cachedObject.cacheHit < oldCacheHit)
-					{
-						oldCacheHit = cachedObject.cacheHit;
-						oldCacheKey = cachedObject.key;
-						oldCacheIdx = idx;
-					}
-				}
-
-				if (oldCacheIdx != MaxCacheSize)
-				{
-					CachedObject& cachedObject = mCacheArray[oldCacheIdx];
-					cachedObject.object = std::move(object);
-					cachedObject.cacheHit = mHitCounter++;
-					cachedObject.key = key;
-
-					mCache.erase(mCache.find(oldCacheKey));
-					mCache.insert({ key, oldCacheIdx });
-
-					return cachedObject.object;
-				}
+				auto& oldest = mObjects.back();
+				mCache.erase(oldest.key);
+
+				oldest.object = std::move(object);
+				oldest.key = key;
+
+				mObjects.splice(mObjects.begin(), mObjects, std::prev(mObjects.end()));
+				mNumEvictions++;
 			}
 			else
 			{
-				const uint32_t cacheIdx = static_cast<uint32_t>(mCacheArray.size());
-				mCacheArray.push_back({
+				mObjects.push_front({
 					.object = std::move(object),
-					.key = key,
-					.cacheHit = mHitCounter++
+					.key = key
 				});
+			}
 
-				mCache.insert({ key, cacheIdx });
+			mCache.insert({ key, mObjects.begin() });
+			return mObjects.front().object;
+		}
 
-				CachedObject& cachedObject = mCacheArray[cacheIdx];
-				return cachedObject.object;
+		template <typename... Args>
+		std::weak_ptr<Type> emplace(const Key& key, Args&&... args)
+		{
+			return add(key, std::allocate_shared<Type>(mAllocator, std::forward<Args>(args)...));
+		}
+
+		template <typename Creator>
+		std::weak_ptr<Type> getOrCreate(const Key& key, Creator&& creator)
+		{
+			if (auto object = get(key).lock(); object != nullptr)
+			{
+				return object;
 			}
 
-			return {};
+			std::shared_ptr<Type> object = creator();
+			if (object == nullptr)
+			{
+				return {};
+			}
+
+			return add(key, std::move(object));
 		}
 
 		void remove(const Key& key)
@@ -132,23 +180,32 @@ namespace Trinity
 			auto it = mCache.find(key);
 			if (it != mCache.end())
 			{
-				mCacheArray.erase(mCacheArray.begin() + it->second);
+				mObjects.erase(it->second);
 				mCache.erase(it);
 			}
 		}
 
 		void clear()
 		{
-			mCacheArray.clear();
+			mObjects.clear();
 			mCache.clear();
-			mHitCounter = 0;
+			resetStats();
+		}
+
+		void resetStats()
+		{
+			mNumHits = 0;
+			mNumMisses = 0;
+			mNumEvictions = 0;
 		}
 
 	private:
 
-		uint32_t mHitCounter{ 0 };
-		Allocator mAllocator;
-		std::unordered_map<Key, uint32_t> mCache;
-		std::vector<CachedObject> mCacheArray;
+		Allocator mAllocator{};
+		ObjectList mObjects{ ObjectAllocator(mAllocator) };
+		ObjectMap mCache{ 0, Hash(), std::equal_to<Key>(), ObjectMapAllocator(mAllocator) };
+		uint64_t mNumHits{ 0 };
+		uint64_t mNumMisses{ 0 };
+		uint64_t mNumEvictions{ 0 };
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Core/Resource.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Trinity
+{
+	class PreloadManifest : public Resource
+	{
+	public:
+
+		static constexpr const char* kExtension = "tpre";
+
+		struct Entry
+		{
+			std::string fileName;
+			std::string type;
+			uint64_t size{ 0 };
+		};
+
+		PreloadManifest() = default;
+		virtual ~PreloadManifest() = default;
+
+		PreloadManifest(const PreloadManifest&) = delete;
+		PreloadManifest& operator = (const PreloadManifest&) = delete;
+
+		PreloadManifest(PreloadManifest&&) = default;
+		PreloadManifest& operator = (PreloadManifest&&) = default;
+
+		const std::vector<Entry>& getEntries() const
+		{
+			return mEntries;
+		}
+
+		uint64_t getTotalSize() const
+		{
+			return mTotalSize;
+		}
+
+		virtual bool create(const std::string& fileName, ResourceCache& cache, bool loadContent = true) override;
+		virtual void destroy() override;
+		virtual bool write() override;
+
+		virtual std::type_index getType() const override;
+
+		virtual void addEntry(const std::string& fileName, const std::string& type, uint64_t size);
+		virtual void addResources(const ResourceCache& cache);
+
+	protected:
+
+		virtual bool read(FileReader& reader, ResourceCache& cache) override;
+		virtual bool write(FileWriter& writer) override;
+
+	public:
+
+		static std::string getManifestFileName(const std::string& fileName);
+
+	protected:
+
+		std::vector<Entry> mEntries;
+		uint64_t mTotalSize{ 0 };
+	};
+}
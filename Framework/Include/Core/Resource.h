@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <typeindex>
@@ -8,9 +10,20 @@
 namespace Trinity
 {
 	class ResourceCache;
+	class Resource;
+	class File;
 	class FileReader;
 	class FileWriter;
 
+	using ResourceCreator = std::function<std::unique_ptr<Resource>()>;
+
+	struct ResourceDependency
+	{
+		std::string fileName;
+		ResourceCreator creator;
+		bool createResource{ true };
+	};
+
 	class Resource
 	{
 	public:
@@ -34,21 +47,63 @@ namespace Trinity
 			return mFileName;
 		}
 
+		uint32_t getRefCount() const
+		{
+			return mRefCount;
+		}
+
+		bool isReferenced() const
+		{
+			return mRefCount > 0;
+		}
+
+		bool wasReferenced() const
+		{
+			return mWasReferenced;
+		}
+
+		void addRef()
+		{
+			mRefCount++;
+			mWasReferenced = true;
+		}
+
+		void release()
+		{
+			if (mRefCount > 0)
+			{
+				mRefCount--;
+			}
+		}
+
 		virtual void setName(const std::string& name);
 		virtual void setFileName(const std::string& fileName);
 		virtual std::type_index getType() const = 0;
 
 		virtual bool create(const std::string& fileName, ResourceCache& cache, bool loadContent = true);
+
+		// the cache calls this when it removes a resource and the destructor calls it again,
+		// so overrides have to be safe to run twice
 		virtual void destroy();
 		virtual bool write();
 
+		virtual uint64_t getCpuMemorySize() const;
+		virtual uint64_t getGpuMemorySize() const;
+		virtual uint32_t getEvictionPriority() const;
+
+		virtual bool canReadAsync() const;
+		virtual bool getDependencies(FileReader& reader, std::vector<ResourceDependency>& dependencies);
+		virtual bool readFile(File& file, ResourceCache& cache);
+
 	protected:
 
 		virtual bool read(FileReader& reader, ResourceCache& cache);
 		virtual bool write(FileWriter& writer);
+		virtual bool writeFile(const std::string& fileName);
 
 	public:
 
+		static bool isContentEqual(const std::string& fileName, const std::string& otherFileName);
 		static std::string getReadPath(const std::string& basePath, const std::string& fileName);
 		static std::string getWritePath(const std::string& basePath, const std::string& fileName);
 
@@ -56,5 +111,29 @@ namespace Trinity
 
 		std::string mName;
 		std::string mFileName;
+		uint32_t mRefCount{ 0 };
+		bool mWasReferenced{ false };
 	};
+
+	template <typename T>
+	void setResourceRef(T*& target, T* resource)
+	{
+		if (resource != nullptr)
+		{
+			resource->addRef();
+		}
+
+		if (target != nullptr)
+		{
+			target->release();
+		}
+
+		target = resource;
+	}
+
+	template <typename T>
+	void releaseResourceRef(T*& target)
+	{
+		setResourceRef(target, (T*)nullptr);
+	}
 }
\ No newline at end of file
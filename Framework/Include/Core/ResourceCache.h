@@ -1,15 +1,30 @@
 #pragma once
 
 #include "Core/Resource.h"
+#include "Core/ResourceHandle.h"
+#include "Core/ResourceLoader.h"
 #include <algorithm>
+#include <deque>
+#include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <typeindex>
 #include <unordered_map>
 #include <vector>
 
 namespace Trinity
 {
+	class PreloadManifest;
+
+	struct ResourceStats
+	{
+		uint32_t numResources{ 0 };
+		uint32_t numReferenced{ 0 };
+		uint64_t cpuMemory{ 0 };
+		uint64_t gpuMemory{ 0 };
+	};
+
 	class ResourceCache
 	{
 	public:
@@ -23,6 +38,26 @@ namespace Trinity
 		ResourceCache(ResourceCache&&) = default;
 		ResourceCache& operator = (ResourceCache&&) = default;
 
+		uint64_t getFrameIndex() const
+		{
+			return mFrameIndex;
+		}
+
+		uint64_t getMemoryBudget() const
+		{
+			return mMemoryBudget;
+		}
+
+		uint32_t getNumEvicted() const
+		{
+			return mNumEvicted;
+		}
+
+		bool isUsageTracking() const
+		{
+			return mUsageTracking;
+		}
+
 		bool hasResource(const std::type_index& type) const;
 		bool isLoaded(const std::type_index& type, const std::string& fileName) const;
 
@@ -31,28 +66,141 @@ namespace Trinity
 
 		const std::vector<std::unique_ptr<Resource>>& getResources(const std::type_index& type) const;
 
+		PathId getPathId(std::string_view fileName) const;
+		PathId internPath(std::string_view fileName);
+		const std::string& getPath(PathId pathId) const;
+
+		bool isLoading() const;
+		std::shared_ptr<ResourceLoadHandle> loadAsync(const std::string& fileName, const ResourceCreator& creator);
+		virtual void update();
+
 		virtual void addResource(std::unique_ptr<Resource> resource);
 		virtual void setResources(const std::type_index& type, std::vector<std::unique_ptr<Resource>> resources);
 		virtual void clear();
 
+		virtual bool unload(const std::type_index& type, const std::string& fileName);
+		virtual uint32_t unloadUnused(uint64_t minUnusedFrames = 0);
+		virtual void setMemoryBudget(uint64_t memoryBudget);
+		virtual void setUsageTracking(bool enabled);
+
+		ResourceStats getStats(const std::type_index& type) const;
+		ResourceStats getStats() const;
+
+		bool preload(const PreloadManifest& manifest);
+		void visitResources(const std::function<void(const Resource&)>& visitor) const;
+
+		static uint32_t getTypeId(const std::type_index& type);
+
 	public:
 
 		template <typename T>
-		bool isLoaded(const std::string& fileName) const
+		static uint32_t getTypeId()
+		{
+			static const uint32_t typeId = getTypeId(typeid(T));
+			return typeId;
+		}
+
+		template <typename T>
+		bool isLoaded(std::string_view fileName) const
+		{
+			return getHandle<T>(fileName).isValid();
+		}
+
+		template <typename T>
+		std::shared_ptr<ResourceLoadHandle> loadAsync(const std::string& fileName)
+		{
+			return loadAsync(fileName, []() -> std::unique_ptr<Resource> {
+				return std::make_unique<T>();
+			});
+		}
+
+		template <typename T>
+		ResourceHandle<T> getHandle(PathId pathId) const
+		{
+			auto* storage = getStorage(getTypeId<T>());
+			if (storage != nullptr)
+			{
+				auto it = storage->pathSlots.find(pathId);
+				if (it != storage->pathSlots.end())
+				{
+					return { it->second, storage->slots[it->second].generation };
+				}
+			}
+
+			return {};
+		}
+
+		template <typename T>
+		ResourceHandle<T> getHandle(std::string_view fileName) const
+		{
+			return getHandle<T>(getPathId(fileName));
+		}
+
+		template <typename T>
+		ResourceHandle<T> getHandleAt(uint32_t id) const
+		{
+			auto* storage = getStorage(getTypeId<T>());
+			if (storage != nullptr && id < (uint32_t)storage->indices.size())
+			{
+				auto slot = storage->indices[id];
+				return { slot, storage->slots[slot].generation };
+			}
+
+			return {};
+		}
+
+		template <typename T>
+		T* getResource(ResourceHandle<T> handle) const
 		{
-			return isLoaded(typeid(T), fileName);
+			auto* storage = getStorage(getTypeId<T>());
+			if (storage == nullptr || handle.getIndex() >= (uint32_t)storage->slots.size())
+			{
+				return nullptr;
+			}
+
+			auto& slot = storage->slots[handle.getIndex()];
+			if (slot.generation != handle.getGeneration())
+			{
+				return nullptr;
+			}
+
+			slot.lastUsed = mFrameIndex;
+			return static_cast<T*>(storage->resources[slot.index].get());
+		}
+
+		template <typename T>
+		bool unload(ResourceHandle<T> handle)
+		{
+			if (getResource(handle) == nullptr)
+			{
+				return false;
+			}
+
+			return unloadSlot(getTypeId<T>(), handle.getIndex());
+		}
+
+		template <typename T>
+		ResourceStats getStats() const
+		{
+			return getStats(typeid(T));
 		}
 
 		template <typename T>
 		T* getResource(uint32_t id = 0) const
 		{
-			return dynamic_cast<T*>(getResource(typeid(T), id));
+			auto* storage = getStorage(getTypeId<T>());
+			if (storage != nullptr && id < (uint32_t)storage->resources.size())
+			{
+				return static_cast<T*>(storage->resources[id].get());
+			}
+
+			return nullptr;
 		}
 
 		template <typename T>
-		T* getResource(const std::string& fileName) const
+		T* getResource(std::string_view fileName) const
 		{
-			return dynamic_cast<T*>(getResource(typeid(T), fileName));
+			return getResource(getHandle<T>(fileName));
 		}
 
 		template <typename T>
@@ -79,14 +227,12 @@ namespace Trinity
 		{
 			std::vector<T*> result;
 
-			if (hasResource(typeid(T)))
+			if (auto* storage = getStorage(getTypeId<T>()); storage != nullptr)
 			{
-				auto& resources = getResources(typeid(T));
-
-				result.resize(resources.size());
-				std::transform(resources.begin(), resources.end(), result.begin(),
+				result.resize(storage->resources.size());
+				std::transform(storage->resources.begin(), storage->resources.end(), result.begin(),
 					[](const std::unique_ptr<Resource>& resource) -> T* {
-						return dynamic_cast<T*>(resource.get());
+						return static_cast<T*>(resource.get());
 					}
 				);
 			}
@@ -94,15 +240,84 @@ namespace Trinity
 			return result;
 		}
 
+		template <typename T>
+		uint32_t getNumResources() const
+		{
+			auto* storage = getStorage(getTypeId<T>());
+			return storage != nullptr ? (uint32_t)storage->resources.size() : 0;
+		}
+
+		template <typename T, typename Func>
+		void forEachResource(Func&& func) const
+		{
+			if (auto* storage = getStorage(getTypeId<T>()); storage != nullptr)
+			{
+				for (const auto& resource : storage->resources)
+				{
+					func(*static_cast<T*>(resource.get()));
+				}
+			}
+		}
+
 		template <typename T>
 		bool hasResource() const
 		{
-			return hasResource(typeid(T));
+			return getNumResources<T>() > 0;
 		}
 
 	protected:
 
-		std::unordered_map<std::type_index, std::vector<std::unique_ptr<Resource>>> mResources;
-		std::unordered_map<std::type_index, std::unordered_map<std::string, Resource*>> mFileResourceMap;
+		struct ResourceSlot
+		{
+			uint32_t index{ 0 };
+			uint32_t generation{ 0 };
+			uint64_t lastUsed{ 0 };
+		};
+
+		struct ResourceStorage
+		{
+			std::vector<std::unique_ptr<Resource>> resources;
+			std::vector<uint32_t> indices;
+			std::vector<ResourceSlot> slots;
+			std::vector<uint32_t> freeSlots;
+			std::unordered_map<PathId, uint32_t> pathSlots;
+		};
+
+		struct PathHash
+		{
+			using is_transparent = void;
+
+			size_t operator()(std::string_view path) const
+			{
+				return std::hash<std::string_view>{}(path);
+			}
+		};
+
+		ResourceStorage* getStorage(uint32_t typeId) const
+		{
+			return typeId < (uint32_t)mStorages.size() ? mStorages[typeId].get() : nullptr;
+		}
+
+		ResourceStorage& getOrCreateStorage(uint32_t typeId);
+		void insertResource(ResourceStorage& storage, std::unique_ptr<Resource> resource);
+		void removeResource(ResourceStorage& storage, uint32_t slotIndex);
+		void resetStorage(ResourceStorage& storage);
+
+		bool unloadSlot(uint32_t typeId, uint32_t slotIndex);
+		uint32_t unloadOrphans();
+		uint64_t trackUsage();
+		void evict(uint64_t memoryUsage);
+
+	protected:
+
+		std::vector<std::unique_ptr<ResourceStorage>> mStorages;
+		std::unordered_map<std::string, PathId, PathHash, std::equal_to<>> mPathIds;
+		std::deque<std::string> mPaths;
+		std::unique_ptr<ResourceLoader> mLoader{ nullptr };
+		uint64_t mFrameIndex{ 0 };
+		uint64_t mMemoryBudget{ 0 };
+		uint32_t mNumEvicted{ 0 };
+		bool mUsageTracking{ false };
+		std::vector<std::string> mPreloadedFiles;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace Trinity
+{
+	using PathId = uint32_t;
+	static constexpr PathId kInvalidPathId = std::numeric_limits<PathId>::max();
+
+	template <typename T>
+	class ResourceHandle
+	{
+	public:
+
+		static constexpr uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+
+		ResourceHandle() = default;
+		ResourceHandle(uint32_t index, uint32_t generation)
+			: mIndex(index), mGeneration(generation)
+		{
+		}
+
+		uint32_t getIndex() const
+		{
+			return mIndex;
+		}
+
+		uint32_t getGeneration() const
+		{
+			return mGeneration;
+		}
+
+		bool isValid() const
+		{
+			return mIndex != kInvalidIndex;
+		}
+
+		bool operator == (const ResourceHandle&) const = default;
+
+	private:
+
+		uint32_t mIndex{ kInvalidIndex };
+		uint32_t mGeneration{ 0 };
+	};
+}
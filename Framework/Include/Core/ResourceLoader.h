@@ -0,0 +1,165 @@
+#pragma once
+
+#include "Core/Resource.h"
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace Trinity
+{
+	class ResourceCache;
+
+	enum class ResourceLoadState : uint32_t
+	{
+		Loading,
+		Loaded,
+		Failed
+	};
+
+	class ResourceLoadHandle
+	{
+	public:
+
+		ResourceLoadHandle() = default;
+		~ResourceLoadHandle() = default;
+
+		ResourceLoadHandle(const ResourceLoadHandle&) = delete;
+		ResourceLoadHandle& operator = (const ResourceLoadHandle&) = delete;
+
+		ResourceLoadHandle(ResourceLoadHandle&&) = delete;
+		ResourceLoadHandle& operator = (ResourceLoadHandle&&) = delete;
+
+		ResourceLoadState getState() const
+		{
+			return mState;
+		}
+
+		bool isDone() const
+		{
+			return mState != ResourceLoadState::Loading;
+		}
+
+		uint32_t getNumLoaded() const
+		{
+			return mNumLoaded;
+		}
+
+		uint32_t getNumTotal() const
+		{
+			return mNumTotal;
+		}
+
+		float getProgress() const
+		{
+			return mNumTotal > 0 ? (float)mNumLoaded / (float)mNumTotal : 0.0f;
+		}
+
+		Resource* getResource() const
+		{
+			return mResource;
+		}
+
+		const std::shared_future<Resource*>& getFuture() const
+		{
+			return mFuture;
+		}
+
+		template <typename T>
+		T* getResource() const
+		{
+			return dynamic_cast<T*>(mResource);
+		}
+
+	private:
+
+		friend class ResourceLoader;
+
+		ResourceLoadState mState{ ResourceLoadState::Loading };
+		uint32_t mNumLoaded{ 0 };
+		uint32_t mNumTotal{ 0 };
+		Resource* mResource{ nullptr };
+		std::promise<Resource*> mPromise;
+		std::shared_future<Resource*> mFuture{ mPromise.get_future().share() };
+		std::vector<std::string> mMemoryFiles;
+	};
+
+	class ResourceLoader
+	{
+	public:
+
+		ResourceLoader() = default;
+		virtual ~ResourceLoader();
+
+		ResourceLoader(const ResourceLoader&) = delete;
+		ResourceLoader& operator = (const ResourceLoader&) = delete;
+
+		ResourceLoader(ResourceLoader&&) = delete;
+		ResourceLoader& operator = (ResourceLoader&&) = delete;
+
+		uint32_t getNumThreads() const
+		{
+			return (uint32_t)mThreads.size();
+		}
+
+		bool isLoading() const
+		{
+			return !mNodes.empty();
+		}
+
+		virtual bool create(uint32_t numThreads);
+		virtual void destroy();
+
+		virtual std::shared_ptr<ResourceLoadHandle> load(const std::string& fileName, 
+			const ResourceCreator& creator, ResourceCache& cache);
+
+		virtual void update(ResourceCache& cache);
+
+	protected:
+
+		struct LoadNode
+		{
+			std::string fileName;
+			std::type_index type{ typeid(Resource) };
+			std::unique_ptr<Resource> resource{ nullptr };
+			std::vector<uint8_t> data;
+			std::vector<ResourceDependency> dependencies;
+			std::vector<LoadNode*> parents;
+			std::vector<LoadNode*> children;
+			std::vector<std::shared_ptr<ResourceLoadHandle>> handles;
+			std::vector<std::shared_ptr<ResourceLoadHandle>> roots;
+			uint32_t numPending{ 0 };
+			bool createResource{ true };
+			bool prefetched{ false };
+			bool readAsync{ false };
+			bool failed{ false };
+		};
+
+		virtual LoadNode* addNode(const std::string& fileName, const ResourceCreator& creator, bool createResource,
+			const std::vector<std::shared_ptr<ResourceLoadHandle>>& handles, ResourceCache& cache);
+
+		virtual void addHandle(LoadNode& node, const std::shared_ptr<ResourceLoadHandle>& handle);
+
+		virtual void prefetch(LoadNode& node);
+		virtual void finalize(LoadNode& node, ResourceCache& cache);
+		virtual void execute();
+
+	protected:
+
+		std::unordered_map<std::type_index, std::unordered_map<std::string, std::unique_ptr<LoadNode>>> mNodes;
+		std::deque<LoadNode*> mReady;
+		std::vector<std::thread> mThreads;
+		std::deque<LoadNode*> mJobs;
+		std::vector<LoadNode*> mCompleted;
+		std::mutex mJobsMutex;
+		std::mutex mCompletedMutex;
+		std::condition_variable mJobsCondition;
+		bool mExit{ false };
+	};
+}
@@ -35,6 +35,16 @@ namespace Trinity
         const Texture& texture;
     };
 
+    struct TextureViewBindingResource
+    {
+        TextureViewBindingResource(const wgpu::TextureView& inView)
+            : view(inView)
+        {
+        }
+
+        const wgpu::TextureView& view;
+    };
+
     struct SamplerBindingResource
     {
         SamplerBindingResource(const Sampler& inSampler)
@@ -58,6 +68,7 @@ namespace Trinity
         std::variant<
             BufferBindingResource,
             TextureBindingResource,
+            TextureViewBindingResource,
             SamplerBindingResource,
             EmptyBindingResource> resource;
     };
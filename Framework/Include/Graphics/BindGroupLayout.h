@@ -25,6 +25,13 @@ namespace Trinity
         wgpu::SamplerBindingType type{ wgpu::SamplerBindingType::Undefined };
     };
 
+    struct StorageTextureBindingLayout
+    {
+        wgpu::StorageTextureAccess access{ wgpu::StorageTextureAccess::WriteOnly };
+        wgpu::TextureFormat format{ wgpu::TextureFormat::Undefined };
+        wgpu::TextureViewDimension viewDimension{ wgpu::TextureViewDimension::e2D };
+    };
+
     struct BindGroupLayoutItem
     {
         uint32_t binding{ 0 };
@@ -32,7 +39,8 @@ namespace Trinity
         std::variant<
             BufferBindingLayout,
             TextureBindingLayout,
-            SamplerBindingLayout> bindingLayout;
+            SamplerBindingLayout,
+            StorageTextureBindingLayout> bindingLayout;
     };
 
     class BindGroupLayout : public Resource
@@ -53,6 +61,11 @@ namespace Trinity
             return mHandle;
         }
 
+        const std::vector<BindGroupLayoutItem>& getItems() const
+        {
+            return mItems;
+        }
+
         bool create(const std::vector<BindGroupLayoutItem>& items);
         bool isValid() const;
 
@@ -62,5 +75,6 @@ namespace Trinity
     private:
 
         wgpu::BindGroupLayout mHandle{ nullptr };
+        std::vector<BindGroupLayoutItem> mItems;
     };
 }
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+
+namespace Trinity
+{
+    class BlobCache
+    {
+    public:
+
+        static constexpr const char* kCacheAlias = "/Cache";
+        static constexpr const char* kBlobExtension = ".blob";
+
+        BlobCache() = default;
+        ~BlobCache();
+
+        BlobCache(const BlobCache&) = delete;
+        BlobCache& operator = (const BlobCache&) = delete;
+
+        BlobCache(BlobCache&&) = delete;
+        BlobCache& operator = (BlobCache&&) = delete;
+
+        uint32_t getNumHits() const
+        {
+            return mNumHits;
+        }
+
+        uint32_t getNumMisses() const
+        {
+            return mNumMisses;
+        }
+
+        uint32_t getNumStored() const
+        {
+            return mNumStored;
+        }
+
+        bool isWarm() const
+        {
+            return mNumHits > 0 && mNumMisses == 0;
+        }
+
+        bool create(const std::string& path);
+        void destroy();
+
+        size_t load(const void* key, size_t keySize, void* value, size_t valueSize);
+        void store(const void* key, size_t keySize, const void* value, size_t valueSize);
+
+    public:
+
+        static size_t loadData(const void* key, size_t keySize, void* value, size_t valueSize, void* userData);
+        static void storeData(const void* key, size_t keySize, const void* value, size_t valueSize, void* userData);
+
+    protected:
+
+        std::string getFileName(const void* key, size_t keySize) const;
+        bool readBlob(const std::string& fileName, const void* key, size_t keySize, std::vector<uint8_t>& value) const;
+
+    protected:
+
+        std::string mPath;
+        std::unordered_map<std::string, std::vector<uint8_t>> mPending;
+        std::mutex mMutex;
+        uint32_t mNumHits{ 0 };
+        uint32_t mNumMisses{ 0 };
+        uint32_t mNumStored{ 0 };
+    };
+}
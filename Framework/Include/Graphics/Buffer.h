@@ -30,8 +30,9 @@ namespace Trinity
         }
 
         virtual std::type_index getType() const override;
+        virtual uint64_t getGpuMemorySize() const override;
 
-        void mapAsync(uint32_t offset, uint32_t size);
+        void mapAsync(uint32_t offset, uint32_t size, wgpu::MapMode mode = wgpu::MapMode::Write);
         void unmap();
 
         void write(uint32_t offset, uint32_t size, const void* data) const;
@@ -43,5 +44,6 @@ namespace Trinity
     protected:
 
         wgpu::Buffer mHandle{};
+        wgpu::MapMode mMapMode{ wgpu::MapMode::None };
     };
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Core/Resource.h"
+#include "Graphics/ComputePipeline.h"
+#include "Graphics/BindGroup.h"
 #include <webgpu/webgpu_cpp.h>
 
 namespace Trinity
@@ -25,6 +27,14 @@ namespace Trinity
         virtual void end();
         virtual void submit();
 
+        virtual void dispatch(uint32_t workgroupCountX, uint32_t workgroupCountY = 1,
+            uint32_t workgroupCountZ = 1) const;
+
+        virtual void setBindGroup(uint32_t groupIndex, const BindGroup& bindGroup) const;
+        virtual void setBindGroup(uint32_t groupIndex, const BindGroup& bindGroup, uint32_t dynamicOffsetCount,
+            const uint32_t* dynamicOffsets) const;
+        virtual void setPipeline(const ComputePipeline& pipeline) const;
+
 	protected:
 
 		wgpu::CommandEncoder mCommandEncoder{ nullptr };
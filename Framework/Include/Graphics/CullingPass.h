@@ -0,0 +1,170 @@
+#pragma once
+
+#include "Graphics/ComputePass.h"
+#include "Graphics/RenderPass.h"
+#include "Graphics/StorageBuffer.h"
+#include "Graphics/UniformBuffer.h"
+#include "Graphics/ReadbackBuffer.h"
+#include "Math/Frustum.h"
+#include <memory>
+#include <vector>
+
+namespace Trinity
+{
+    class DepthPyramid;
+
+    enum class CullingPhase : uint32_t
+    {
+        All = 0,
+        Early,
+        Late
+    };
+
+    class CullingPass : public ComputePass
+    {
+    public:
+
+        static constexpr const char* kDefaultShader = "/Assets/Framework/Shaders/Culling.wgsl";
+        static constexpr uint32_t kWorkgroupSize = 64;
+
+        struct InstanceData
+        {
+            glm::vec3 center{ 0.0f };
+            uint32_t drawIndex{ 0 };
+            glm::vec3 extents{ 0.0f };
+            uint32_t payloadIndex{ 0 };
+        };
+
+        struct DrawData
+        {
+            DrawIndexedIndirectArgs args;
+            uint32_t firstOutput{ 0 };
+        };
+
+        struct ParamsBufferData
+        {
+            glm::vec4 planes[6];
+            glm::mat4 viewProj{ 1.0f };
+            uint32_t numInstances{ 0 };
+            uint32_t payloadSize{ 0 };
+            uint32_t phase{ 0 };
+            uint32_t numLevels{ 0 };
+            uint32_t pyramidWidth{ 0 };
+            uint32_t pyramidHeight{ 0 };
+            uint32_t padding[2]{ 0 };
+        };
+
+        struct Stats
+        {
+            uint32_t numFrustumCulled{ 0 };
+            uint32_t numOccluded{ 0 };
+            uint32_t numEarly{ 0 };
+            uint32_t numLate{ 0 };
+        };
+
+        CullingPass() = default;
+        virtual ~CullingPass() = default;
+
+        CullingPass(const CullingPass&) = delete;
+        CullingPass& operator = (const CullingPass&) = delete;
+
+        CullingPass(CullingPass&&) = default;
+        CullingPass& operator = (CullingPass&&) = default;
+
+        uint32_t getNumInstances() const
+        {
+            return (uint32_t)mInstances.size();
+        }
+
+        uint32_t getNumDraws() const
+        {
+            return (uint32_t)mDraws.size();
+        }
+
+        const InstanceData& getInstance(uint32_t index) const
+        {
+            return mInstances[index];
+        }
+
+        const StorageBuffer* getArgsBuffer() const
+        {
+            return mArgsBuffer.get();
+        }
+
+        const StorageBuffer* getOutputBuffer() const
+        {
+            return mOutputBuffer.get();
+        }
+
+        const Stats& getStats() const
+        {
+            return mStats;
+        }
+
+        bool isOcclusionEnabled() const
+        {
+            return mDepthPyramid != nullptr;
+        }
+
+        virtual void destroy() override;
+        virtual std::type_index getType() const override;
+
+        bool create(uint32_t numInstances, uint32_t payloadSize, std::vector<DrawData>&& draws,
+            uint32_t outputSize, wgpu::BufferUsage outputUsage = wgpu::BufferUsage::None);
+
+        void setInstance(uint32_t index, const InstanceData& instance);
+        void setPayload(uint32_t index, const void* data);
+
+        bool setDepthPyramid(const DepthPyramid* depthPyramid);
+
+        bool cull(const Frustum& frustum);
+        bool cull(const Frustum& frustum, const glm::mat4& viewProj, CullingPhase phase);
+        void cullReference(const Frustum& frustum, std::vector<DrawIndexedIndirectArgs>& args,
+            std::vector<uint32_t>& outputs) const;
+
+    public:
+
+        static bool isVisible(const Frustum& frustum, const InstanceData& instance);
+        static void cullReference(const Frustum& frustum, const std::vector<InstanceData>& instances,
+            const std::vector<DrawData>& draws, std::vector<DrawIndexedIndirectArgs>& args, std::vector<uint32_t>& outputs);
+
+    protected:
+
+        bool createPipeline();
+        bool createOcclusionPipeline();
+        void upload();
+        void readStats();
+
+        std::vector<BindGroupLayoutItem> getLayoutItems() const;
+        std::vector<BindGroupItem> getBindGroupItems() const;
+
+    protected:
+
+        std::vector<InstanceData> mInstances;
+        std::vector<uint8_t> mPayloads;
+        std::vector<DrawData> mDraws;
+        std::vector<DrawIndexedIndirectArgs> mArgs;
+        uint32_t mPayloadSize{ 0 };
+        uint32_t mDirtyBegin{ 0 };
+        uint32_t mDirtyEnd{ 0 };
+        std::unique_ptr<Shader> mShader{ nullptr };
+        std::unique_ptr<BindGroupLayout> mBindGroupLayout{ nullptr };
+        std::unique_ptr<BindGroup> mBindGroup{ nullptr };
+        std::unique_ptr<ComputePipeline> mPipeline{ nullptr };
+        std::unique_ptr<UniformBuffer> mParamsBuffer{ nullptr };
+        std::unique_ptr<StorageBuffer> mInstanceBuffer{ nullptr };
+        std::unique_ptr<StorageBuffer> mPayloadBuffer{ nullptr };
+        std::unique_ptr<StorageBuffer> mFirstOutputBuffer{ nullptr };
+        std::unique_ptr<StorageBuffer> mArgsBuffer{ nullptr };
+        std::unique_ptr<StorageBuffer> mOutputBuffer{ nullptr };
+        const DepthPyramid* mDepthPyramid{ nullptr };
+        std::unique_ptr<BindGroupLayout> mOcclusionBindGroupLayout{ nullptr };
+        std::unique_ptr<BindGroup> mOcclusionBindGroup{ nullptr };
+        std::unique_ptr<ComputePipeline> mOcclusionPipeline{ nullptr };
+        std::unique_ptr<StorageBuffer> mVisibilityBuffer{ nullptr };
+        std::unique_ptr<StorageBuffer> mStatsBuffer{ nullptr };
+        std::unique_ptr<ReadbackBuffer> mStatsReadbackBuffer{ nullptr };
+        Stats mStats;
+        bool mStatsPending{ false };
+    };
+}
\ No newline at end of file
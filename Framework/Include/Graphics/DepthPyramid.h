@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Graphics/ComputePass.h"
+#include <memory>
+#include <vector>
+
+namespace Trinity
+{
+    class DepthPyramid : public ComputePass
+    {
+    public:
+
+        static constexpr const char* kDefaultShader = "/Assets/Framework/Shaders/HiZ.wgsl";
+        static constexpr uint32_t kWorkgroupSize = 8;
+
+        DepthPyramid() = default;
+        virtual ~DepthPyramid() = default;
+
+        DepthPyramid(const DepthPyramid&) = delete;
+        DepthPyramid& operator = (const DepthPyramid&) = delete;
+
+        DepthPyramid(DepthPyramid&&) = default;
+        DepthPyramid& operator = (DepthPyramid&&) = default;
+
+        uint32_t getWidth() const
+        {
+            return mWidth;
+        }
+
+        uint32_t getHeight() const
+        {
+            return mHeight;
+        }
+
+        uint32_t getNumLevels() const
+        {
+            return (uint32_t)mLevelViews.size();
+        }
+
+        uint32_t getDepthWidth() const
+        {
+            return mDepthWidth;
+        }
+
+        uint32_t getDepthHeight() const
+        {
+            return mDepthHeight;
+        }
+
+        const wgpu::TextureView& getView() const
+        {
+            return mView;
+        }
+
+        virtual void destroy() override;
+        virtual std::type_index getType() const override;
+
+        bool create(uint32_t depthWidth, uint32_t depthHeight);
+        bool build(const wgpu::TextureView& depthView);
+
+    protected:
+
+        bool createPipelines();
+
+    protected:
+
+        uint32_t mWidth{ 0 };
+        uint32_t mHeight{ 0 };
+        uint32_t mDepthWidth{ 0 };
+        uint32_t mDepthHeight{ 0 };
+        wgpu::Texture mTexture{ nullptr };
+        wgpu::TextureView mView{ nullptr };
+        wgpu::TextureView mDepthView{ nullptr };
+        std::vector<wgpu::TextureView> mLevelViews;
+        std::vector<std::unique_ptr<BindGroup>> mBindGroups;
+        std::unique_ptr<Shader> mShader{ nullptr };
+        std::unique_ptr<BindGroupLayout> mCopyBindGroupLayout{ nullptr };
+        std::unique_ptr<BindGroupLayout> mReduceBindGroupLayout{ nullptr };
+        std::unique_ptr<ComputePipeline> mCopyPipeline{ nullptr };
+        std::unique_ptr<ComputePipeline> mReducePipeline{ nullptr };
+    };
+}
\ No newline at end of file
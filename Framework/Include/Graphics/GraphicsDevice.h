@@ -11,6 +11,8 @@
 
 namespace Trinity
 {
+    class BlobCache;
+
     class GraphicsDevice : public Singleton<GraphicsDevice>
     {
     public:
@@ -44,6 +46,11 @@ namespace Trinity
             return mSwapChain;
         }
 
+        BlobCache* getBlobCache() const
+        {
+            return mBlobCache;
+        }
+
         operator const wgpu::Device& () const
         {
             return mDevice;
@@ -51,6 +58,7 @@ namespace Trinity
 
         virtual void create(const Window& window);
         virtual void destroy();
+        virtual void setBlobCache(BlobCache* blobCache);
 
         virtual bool setupSwapChain(const Window& window, wgpu::PresentMode presentMode,
             wgpu::TextureFormat depthFormat);
@@ -76,5 +84,6 @@ namespace Trinity
         wgpu::Device mDevice;
         wgpu::Queue mQueue;
         SwapChain mSwapChain;
+        BlobCache* mBlobCache{ nullptr };
     };
 }
\ No newline at end of file
@@ -32,7 +32,8 @@ namespace Trinity
             return mNumIndices;
         }
 
-        bool create(wgpu::IndexFormat indexFormat, uint32_t numIndices, const void* data = nullptr);
+        bool create(wgpu::IndexFormat indexFormat, uint32_t numIndices, const void* data = nullptr,
+            wgpu::BufferUsage usage = wgpu::BufferUsage::None);
         void destroy();
 
     private:
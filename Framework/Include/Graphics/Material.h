@@ -96,6 +96,7 @@ namespace Trinity
 
 		MaterialTexture* getTexture(const std::string& name);
 		virtual std::type_index getType() const override;
+		virtual bool getDependencies(FileReader& reader, std::vector<ResourceDependency>& dependencies) override;
 
 		virtual void setEmissive(const glm::vec3& emissive);
 		virtual void setDoubleSided(bool doubleSided);
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Graphics/ComputePass.h"
+#include "Graphics/RenderPass.h"
+#include "Graphics/StorageBuffer.h"
+#include "Graphics/IndexBuffer.h"
+#include "Graphics/UniformBuffer.h"
+#include "Graphics/ReadbackBuffer.h"
+#include "Math/Frustum.h"
+#include <memory>
+#include <vector>
+
+namespace Trinity
+{
+    class MeshletCullingPass : public ComputePass
+    {
+    public:
+
+        static constexpr const char* kDefaultShader = "/Assets/Framework/Shaders/MeshletCulling.wgsl";
+        static constexpr uint32_t kWorkgroupSize = 64;
+
+        // the index range points into the indices handed to create()
+        struct MeshletData
+        {
+            glm::vec3 center{ 0.0f };
+            float radius{ 0.0f };
+            glm::vec3 coneAxis{ 0.0f };
+            float coneCutoff{ 1.0f };
+            uint32_t firstIndex{ 0 };
+            uint32_t numIndices{ 0 };
+            uint32_t groupIndex{ 0 };
+            uint32_t padding{ 0 };
+        };
+
+        struct GroupData
+        {
+            glm::mat4 transform{ 1.0f };
+            glm::mat4 rotation{ 1.0f };
+        };
+
+        struct ParamsBufferData
+        {
+            glm::vec4 planes[6];
+            glm::vec3 cameraPos{ 0.0f };
+            uint32_t numMeshlets{ 0 };
+            glm::vec3 cameraDir{ 0.0f };
+            uint32_t perspective{ 0 };
+        };
+
+        struct Stats
+        {
+            uint32_t numFrustumCulled{ 0 };
+            uint32_t numConeCulled{ 0 };
+        };
+
+        MeshletCullingPass() = default;
+        virtual ~MeshletCullingPass() = default;
+
+        MeshletCullingPass(const MeshletCullingPass&) = delete;
+        MeshletCullingPass& operator = (const MeshletCullingPass&) = delete;
+
+        MeshletCullingPass(MeshletCullingPass&&) = default;
+        MeshletCullingPass& operator = (MeshletCullingPass&&) = default;
+
+        uint32_t getNumMeshlets() const
+        {
+            return (uint32_t)mMeshlets.size();
+        }
+
+        uint32_t getNumGroups() const
+        {
+            return (uint32_t)mGroups.size();
+        }
+
+        const StorageBuffer* getArgsBuffer() const
+        {
+            return mArgsBuffer.get();
+        }
+
+        const IndexBuffer* getIndexBuffer() const
+        {
+            return mIndexBuffer.get();
+        }
+
+        const Stats& getStats() const
+        {
+            return mStats;
+        }
+
+        virtual void destroy() override;
+        virtual std::type_index getType() const override;
+
+        bool create(std::vector<MeshletData>&& meshlets, const std::vector<uint32_t>& indices, uint32_t numGroups);
+        void setGroup(uint32_t index, const GroupData& group);
+
+        bool cull(const Frustum& frustum, const glm::vec3& cameraPos, const glm::vec3& cameraDir, bool perspective);
+
+    protected:
+
+        bool createPipeline();
+        void upload();
+        void readStats();
+
+    protected:
+
+        std::vector<MeshletData> mMeshlets;
+        std::vector<GroupData> mGroups;
+        std::vector<DrawIndexedIndirectArgs> mArgs;
+        uint32_t mDirtyBegin{ 0 };
+        uint32_t mDirtyEnd{ 0 };
+        std::unique_ptr<Shader> mShader{ nullptr };
+        std::unique_ptr<BindGroupLayout> mBindGroupLayout{ nullptr };
+        std::unique_ptr<BindGroup> mBindGroup{ nullptr };
+        std::unique_ptr<ComputePipeline> mPipeline{ nullptr };
+        std::unique_ptr<UniformBuffer> mParamsBuffer{ nullptr };
+        std::unique_ptr<StorageBuffer> mMeshletBuffer{ nullptr };
+        std::unique_ptr<StorageBuffer> mGroupBuffer{ nullptr };
+        std::unique_ptr<StorageBuffer> mArgsBuffer{ nullptr };
+        std::unique_ptr<StorageBuffer> mSourceBuffer{ nullptr };
+        std::unique_ptr<IndexBuffer> mIndexBuffer{ nullptr };
+        std::unique_ptr<StorageBuffer> mStatsBuffer{ nullptr };
+        std::unique_ptr<ReadbackBuffer> mStatsReadbackBuffer{ nullptr };
+        Stats mStats;
+        bool mStatsPending{ false };
+    };
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Core/Singleton.h"
+#include "Core/Clock.h"
+#include "Graphics/RenderPipeline.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Trinity
+{
+    class PipelineCache : public Singleton<PipelineCache>
+    {
+    public:
+
+        PipelineCache() = default;
+        ~PipelineCache();
+
+        PipelineCache(const PipelineCache&) = delete;
+        PipelineCache& operator = (const PipelineCache&) = delete;
+
+        PipelineCache(PipelineCache&&) = delete;
+        PipelineCache& operator = (PipelineCache&&) = delete;
+
+        uint32_t getNumCreated() const
+        {
+            return mNumCreated;
+        }
+
+        uint32_t getNumReused() const
+        {
+            return mNumReused;
+        }
+
+        float getCreateTime() const
+        {
+            return mCreateTime;
+        }
+
+        RenderPipeline* getRenderPipeline(const RenderPipelineProperties& renderProps);
+        void destroy();
+
+    public:
+
+        static uint64_t getHash(const RenderPipelineProperties& renderProps);
+        static void getKey(const RenderPipelineProperties& renderProps, std::vector<uint8_t>& key);
+
+    private:
+
+        struct PipelineEntry
+        {
+            std::vector<uint8_t> key;
+            std::string shaderSource;
+            std::unique_ptr<RenderPipeline> pipeline{ nullptr };
+        };
+
+        std::unordered_map<uint64_t, std::vector<PipelineEntry>> mPipelines;
+        uint32_t mNumCreated{ 0 };
+        uint32_t mNumReused{ 0 };
+        float mCreateTime{ 0.0f };
+    };
+}
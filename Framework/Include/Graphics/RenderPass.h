@@ -10,6 +10,23 @@
 
 namespace Trinity
 {
+    struct DrawIndirectArgs
+    {
+        uint32_t vertexCount{ 0 };
+        uint32_t instanceCount{ 0 };
+        uint32_t firstVertex{ 0 };
+        uint32_t firstInstance{ 0 };
+    };
+
+    struct DrawIndexedIndirectArgs
+    {
+        uint32_t indexCount{ 0 };
+        uint32_t instanceCount{ 0 };
+        uint32_t firstIndex{ 0 };
+        int32_t baseVertex{ 0 };
+        uint32_t firstInstance{ 0 };
+    };
+
     class RenderPass : public Resource
     {
     public:
@@ -28,6 +45,7 @@ namespace Trinity
 
         virtual bool begin(const FrameBuffer& frameBuffer);
         virtual bool begin();
+        virtual bool resume();
         
         virtual void end();
         virtual void submit();
@@ -38,7 +56,12 @@ namespace Trinity
         virtual void drawIndexed(uint32_t indexCount, uint32_t instanceCount = 1, uint32_t firstIndex = 0,
             int32_t baseVertex = 0, uint32_t firstInstance = 0) const;
 
+        virtual void drawIndirect(const Buffer& indirectBuffer, uint64_t indirectOffset = 0) const;
+        virtual void drawIndexedIndirect(const Buffer& indirectBuffer, uint64_t indirectOffset = 0) const;
+
         virtual void setBindGroup(uint32_t groupIndex, const BindGroup& bindGroup) const;
+        virtual void setBindGroup(uint32_t groupIndex, const BindGroup& bindGroup, uint32_t dynamicOffsetCount,
+            const uint32_t* dynamicOffsets) const;
         virtual void setPipeline(const RenderPipeline& pipeline) const;
         virtual void setVertexBuffer(uint32_t slot, const VertexBuffer& vertexBuffer) const;
         virtual void setIndexBuffer(const IndexBuffer& indexBuffer) const;
@@ -48,6 +71,11 @@ namespace Trinity
 
     protected:
 
+        bool begin(const wgpu::RenderPassDescriptor& renderPassDesc);
+
+    protected:
+
+        const FrameBuffer* mFrameBuffer{ nullptr };
         wgpu::CommandEncoder mCommandEncoder{ nullptr };
         wgpu::RenderPassEncoder mRenderPassEncoder{ nullptr };
     };
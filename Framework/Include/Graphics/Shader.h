@@ -54,6 +54,16 @@ namespace Trinity
             return mHandle;
         }
 
+        const std::string& getSource() const
+        {
+            return mSource;
+        }
+
+        uint64_t getSourceHash() const
+        {
+            return mSourceHash;
+        }
+
         bool isValid() const
         {
             return mHandle != nullptr;
@@ -71,5 +81,7 @@ namespace Trinity
     protected:
 
         wgpu::ShaderModule mHandle;
+        std::string mSource;
+        uint64_t mSourceHash{ 0 };
     };
 }
\ No newline at end of file
@@ -22,7 +22,7 @@ namespace Trinity
 			return mSize;
 		}
 
-		bool create(uint32_t size, const void* data = nullptr);
+		bool create(uint32_t size, const void* data = nullptr, wgpu::BufferUsage usage = wgpu::BufferUsage::None);
 		void destroy();
 
 	private:
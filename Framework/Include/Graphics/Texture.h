@@ -57,6 +57,11 @@ namespace Trinity
 		virtual bool write() override;
 
         virtual std::type_index getType() const override;
+        virtual uint64_t getGpuMemorySize() const override;
+        virtual uint32_t getEvictionPriority() const override;
+        virtual bool getDependencies(FileReader& reader, std::vector<ResourceDependency>& dependencies) override;
+
+        static uint32_t getBitsPerPixel(wgpu::TextureFormat format);
 
     protected:
 
@@ -31,6 +31,7 @@ namespace Trinity
 		virtual bool create(const std::string& fileName, ResourceCache& cache, bool loadContent = true) override;
 		virtual void destroy() override;
 		virtual bool write() override;
+		virtual bool getDependencies(FileReader& reader, std::vector<ResourceDependency>& dependencies) override;
 
         virtual bool create(uint32_t width, uint32_t height, wgpu::TextureFormat format, wgpu::TextureUsage usage);
 		virtual bool load(Image* image, wgpu::TextureFormat format, bool mipmaps = false);
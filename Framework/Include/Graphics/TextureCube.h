@@ -39,6 +39,7 @@ namespace Trinity
 		virtual bool create(const std::string& fileName, ResourceCache& cache, bool loadContent = true) override;
 		virtual void destroy() override;
 		virtual bool write() override;
+		virtual bool getDependencies(FileReader& reader, std::vector<ResourceDependency>& dependencies) override;
 
 		virtual bool load(Image* image, wgpu::TextureFormat format);
 		virtual bool load(const std::vector<Image*>& images, wgpu::TextureFormat format);
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Graphics/UniformBuffer.h"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace Trinity
+{
+    class UniformAllocator
+    {
+    public:
+
+        static constexpr uint32_t kAlignment = 256;
+        static constexpr uint32_t kFramesInFlight = 2;
+        static constexpr uint32_t kInvalidOffset = std::numeric_limits<uint32_t>::max();
+
+        UniformAllocator() = default;
+        ~UniformAllocator();
+
+        UniformAllocator(const UniformAllocator&) = delete;
+        UniformAllocator& operator = (const UniformAllocator&) = delete;
+
+        UniformAllocator(UniformAllocator&&) = default;
+        UniformAllocator& operator = (UniformAllocator&&) = default;
+
+        const UniformBuffer* getBuffer() const
+        {
+            return mBuffer.get();
+        }
+
+        uint32_t getFrameSize() const
+        {
+            return mFrameSize;
+        }
+
+        uint32_t getUsedSize() const
+        {
+            return mHead;
+        }
+
+        bool create(uint32_t frameSize, uint32_t maxBindingSize = 0);
+        void destroy();
+
+        void begin();
+        void* allocate(uint32_t size, uint32_t& offset);
+        uint32_t allocate(uint32_t size, const void* data);
+        void upload();
+
+    public:
+
+        static uint32_t align(uint32_t size)
+        {
+            return (size + kAlignment - 1) & ~(kAlignment - 1);
+        }
+
+    private:
+
+        std::unique_ptr<UniformBuffer> mBuffer{ nullptr };
+        std::vector<uint8_t> mData;
+        uint32_t mFrameSize{ 0 };
+        uint32_t mFrameIndex{ 0 };
+        uint32_t mHead{ 0 };
+    };
+}
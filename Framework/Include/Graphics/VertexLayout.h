@@ -29,7 +29,7 @@ namespace Trinity
         }
 
         virtual std::type_index getType() const override;
-        virtual void setAttributes(std::vector<wgpu::VertexAttribute> attributes);
+        virtual void setAttributes(std::vector<wgpu::VertexAttribute> attributes, uint32_t stride = 0);
 
     private:
 
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Math/BoundingBox.h"
+#include "Math/Frustum.h"
+#include <cstdint>
+#include <vector>
+
+namespace Trinity
+{
+	class BoundingBoxBatch
+	{
+	public:
+
+		static constexpr uint32_t kBatchWidth = 8;
+
+		BoundingBoxBatch() = default;
+		virtual ~BoundingBoxBatch() = default;
+
+		BoundingBoxBatch(const BoundingBoxBatch&) = delete;
+		BoundingBoxBatch& operator = (const BoundingBoxBatch&) = delete;
+
+		BoundingBoxBatch(BoundingBoxBatch&&) = default;
+		BoundingBoxBatch& operator = (BoundingBoxBatch&&) = default;
+
+		uint32_t getSize() const
+		{
+			return mSize;
+		}
+
+		const float* getCenters(uint32_t axis) const
+		{
+			return mCenters[axis].data();
+		}
+
+		const float* getExtents(uint32_t axis) const
+		{
+			return mExtents[axis].data();
+		}
+
+		void clear();
+		void resize(uint32_t size);
+		void add(const BoundingBox& box);
+		void set(uint32_t idx, const BoundingBox& box);
+
+		void cull(const Frustum& frustum, std::vector<uint64_t>& visibility) const;
+		void cullScalar(const Frustum& frustum, std::vector<uint64_t>& visibility) const;
+
+	public:
+
+		static bool isVisible(const std::vector<uint64_t>& visibility, uint32_t idx)
+		{
+			return (visibility[idx >> 6] >> (idx & 63)) & 1;
+		}
+
+	protected:
+
+		void prepareVisibility(std::vector<uint64_t>& visibility) const;
+
+	protected:
+
+		std::vector<float> mCenters[3];
+		std::vector<float> mExtents[3];
+		uint32_t mSize{ 0 };
+	};
+}
@@ -0,0 +1,221 @@
+#pragma once
+
+#include "Math/BoundingBox.h"
+#include "Math/Frustum.h"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace Trinity
+{
+	class BoundingVolumeHierarchy
+	{
+	public:
+
+		static constexpr uint32_t kNullNode = std::numeric_limits<uint32_t>::max();
+		static constexpr uint32_t kMaxStackSize = 256;
+		static constexpr uint32_t kInsideFlag = 1u << 31;
+
+		struct Node
+		{
+			BoundingBox bounds;
+			uint32_t parent{ kNullNode };
+			uint32_t left{ kNullNode };
+			uint32_t right{ kNullNode };
+			int32_t height{ -1 };
+			uint32_t userData{ 0 };
+
+			bool isLeaf() const
+			{
+				return left == kNullNode;
+			}
+		};
+
+		BoundingVolumeHierarchy() = default;
+		virtual ~BoundingVolumeHierarchy() = default;
+
+		BoundingVolumeHierarchy(const BoundingVolumeHierarchy&) = delete;
+		BoundingVolumeHierarchy& operator = (const BoundingVolumeHierarchy&) = delete;
+
+		BoundingVolumeHierarchy(BoundingVolumeHierarchy&&) = default;
+		BoundingVolumeHierarchy& operator = (BoundingVolumeHierarchy&&) = default;
+
+		uint32_t getNumProxies() const
+		{
+			return mNumProxies;
+		}
+
+		uint32_t getNumNodes() const
+		{
+			return (uint32_t)mNodes.size() - mNumFreeNodes;
+		}
+
+		uint32_t getHeight() const
+		{
+			return mRoot != kNullNode ? (uint32_t)mNodes[mRoot].height : 0;
+		}
+
+		float getMargin() const
+		{
+			return mMargin;
+		}
+
+		uint32_t getUserData(uint32_t proxyId) const
+		{
+			return mNodes[proxyId].userData;
+		}
+
+		const BoundingBox& getFatBounds(uint32_t proxyId) const
+		{
+			return mNodes[proxyId].bounds;
+		}
+
+		uint32_t createProxy(const BoundingBox& bounds, uint32_t userData);
+		void destroyProxy(uint32_t proxyId);
+		bool moveProxy(uint32_t proxyId, const BoundingBox& bounds);
+
+		void setMargin(float margin);
+		void clear();
+
+	public:
+
+		template <typename Func>
+		void query(const BoundingBox& bounds, Func&& func) const
+		{
+			if (mRoot == kNullNode)
+			{
+				return;
+			}
+
+			uint32_t stack[kMaxStackSize];
+			uint32_t stackSize{ 0 };
+			stack[stackSize++] = mRoot;
+
+			while (stackSize > 0)
+			{
+				const auto& node = mNodes[stack[--stackSize]];
+				if (!node.bounds.isIntersecting(bounds))
+				{
+					continue;
+				}
+
+				if (node.isLeaf())
+				{
+					func(node.userData);
+				}
+				else
+				{
+					stack[stackSize++] = node.left;
+					stack[stackSize++] = node.right;
+				}
+			}
+		}
+
+		template <typename Func>
+		void query(const Frustum& frustum, Func&& func) const
+		{
+			if (mRoot == kNullNode)
+			{
+				return;
+			}
+
+			uint32_t stack[kMaxStackSize];
+			uint32_t stackSize{ 0 };
+			stack[stackSize++] = mRoot;
+
+			while (stackSize > 0)
+			{
+				const uint32_t entry = stack[--stackSize];
+				const auto& node = mNodes[entry & ~kInsideFlag];
+
+				uint32_t inside = entry & kInsideFlag;
+				if (inside == 0)
+				{
+					auto result = frustum.intersect(node.bounds);
+					if (result == Intersection::Outside)
+					{
+						continue;
+					}
+
+					if (result == Intersection::Inside)
+					{
+						inside = kInsideFlag;
+					}
+				}
+
+				if (node.isLeaf())
+				{
+					func(node.userData);
+				}
+				else
+				{
+					stack[stackSize++] = node.left | inside;
+					stack[stackSize++] = node.right | inside;
+				}
+			}
+		}
+
+		template <typename Func>
+		void raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Func&& func) const
+		{
+			if (mRoot == kNullNode)
+			{
+				return;
+			}
+
+			const glm::vec3 invDirection = 1.0f / direction;
+
+			uint32_t stack[kMaxStackSize];
+			uint32_t stackSize{ 0 };
+			stack[stackSize++] = mRoot;
+
+			while (stackSize > 0)
+			{
+				const auto& node = mNodes[stack[--stackSize]];
+
+				float distance{ 0.0f };
+				if (!intersectRay(node.bounds, origin, invDirection, maxDistance, distance))
+				{
+					continue;
+				}
+
+				if (node.isLeaf())
+				{
+					// the callback returns the new clip distance, 0 stops the traversal
+					maxDistance = func(node.userData, distance);
+					if (maxDistance <= 0.0f)
+					{
+						return;
+					}
+				}
+				else
+				{
+					stack[stackSize++] = node.left;
+					stack[stackSize++] = node.right;
+				}
+			}
+		}
+
+	public:
+
+		static bool intersectRay(const BoundingBox& bounds, const glm::vec3& origin, const glm::vec3& invDirection,
+			float maxDistance, float& distance);
+
+	protected:
+
+		uint32_t allocateNode();
+		void freeNode(uint32_t nodeId);
+		void insertLeaf(uint32_t leaf);
+		void removeLeaf(uint32_t leaf);
+		uint32_t balance(uint32_t nodeId);
+
+	protected:
+
+		std::vector<Node> mNodes;
+		uint32_t mRoot{ kNullNode };
+		uint32_t mFreeList{ kNullNode };
+		uint32_t mNumFreeNodes{ 0 };
+		uint32_t mNumProxies{ 0 };
+		float mMargin{ 0.1f };
+	};
+}
@@ -4,6 +4,13 @@
 
 namespace Trinity
 {
+	enum class Intersection
+	{
+		Outside,
+		Intersecting,
+		Inside
+	};
+
 	class Frustum
 	{
 	public:
@@ -12,6 +19,7 @@ namespace Trinity
 		Frustum(const glm::mat4& m);
 
 		bool contains(const BoundingBox& box) const;
+		Intersection intersect(const BoundingBox& box) const;
 		void fromMatrix(const glm::mat4& m);
 
 	public:
@@ -34,6 +34,7 @@ namespace Trinity
 		virtual std::string getTypeStr() const = 0;
 
 		virtual void setName(const std::string& name);
+		virtual void destroy();
 		virtual bool read(FileReader& reader, ResourceCache& cache, Scene& scene);
 		virtual bool write(FileWriter& writer, Scene& scene);
 
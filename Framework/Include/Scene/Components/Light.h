@@ -53,6 +53,11 @@ namespace Trinity
 			return mProperties;
 		}
 
+		uint32_t getVersion() const
+		{
+			return mVersion;
+		}
+
 		virtual std::type_index getType() const override;
 		virtual std::string getTypeStr() const override;
 
@@ -72,5 +77,6 @@ namespace Trinity
 		Node* mNode{ nullptr };
 		LightType mLightType{ LightType::Directional };
 		LightProperties mProperties;
+		uint32_t mVersion{ 0 };
 	};
 }
\ No newline at end of file
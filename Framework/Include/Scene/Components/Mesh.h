@@ -51,6 +51,7 @@ namespace Trinity
 		const std::vector<glm::mat4>& getBindPose() const;
 
 		virtual bool isAnimated() const;
+		virtual void destroy() override;
 		virtual bool load(const std::string& modelFileName, ResourceCache& cache, Scene& scene);
 		virtual std::type_index getType() const override;
 		virtual std::string getTypeStr() const override;
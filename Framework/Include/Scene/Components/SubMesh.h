@@ -5,6 +5,8 @@
 #include "Graphics/IndexBuffer.h"
 #include "Graphics/Material.h"
 #include "Graphics/Shader.h"
+#include "Math/BoundingBox.h"
+#include "Scene/Model.h"
 
 namespace Trinity
 {
@@ -36,6 +38,11 @@ namespace Trinity
 			return mVertexBuffer;
 		}
 
+		VertexLayout* getPositionLayout() const
+		{
+			return mPositionLayout;
+		}
+
 		IndexBuffer* getIndexBuffer() const
 		{
 			return mIndexBuffer;
@@ -56,21 +63,61 @@ namespace Trinity
 			return mNumIndices;
 		}
 
+		const BoundingBox& getBounds() const
+		{
+			return mBounds;
+		}
+
+		const std::vector<Model::Lod>& getLods() const
+		{
+			return mLods;
+		}
+
+		uint32_t getNumLods() const
+		{
+			return (uint32_t)mLods.size();
+		}
+
+		const std::vector<Model::Meshlet>& getMeshlets() const
+		{
+			return mMeshlets;
+		}
+
+		uint32_t getNumMeshlets() const
+		{
+			return (uint32_t)mMeshlets.size();
+		}
+
+		const std::vector<uint32_t>& getMeshletIndices() const
+		{
+			return mMeshletIndices;
+		}
+
 		bool hasIndexBuffer() const
 		{
 			return mNumIndices > 0;
 		}
 
+		bool hasPositionLayout() const
+		{
+			return mPositionLayout != nullptr;
+		}
+
 		virtual std::type_index getType() const override;
 		virtual std::string getTypeStr() const override;
 
 		virtual void setMaterial(Material& material);
 		virtual void setVertexLayout(VertexLayout& vertexLayout);
 		virtual void setVertexBuffer(VertexBuffer& vertexBuffer);
+		virtual void setPositionLayout(VertexLayout& positionLayout);
 		virtual void setIndexBuffer(IndexBuffer& indexBuffer);
 		virtual void setNumVertices(uint32_t numVertices);
 		virtual void setIndexOffset(uint32_t indexOffset);
 		virtual void setNumIndices(uint32_t numIndices);
+		virtual void setBounds(const BoundingBox& bounds);
+		virtual void setLods(const std::vector<Model::Lod>& lods);
+		virtual void setMeshlets(const std::vector<Model::Meshlet>& meshlets);
+		virtual void setMeshletIndices(const std::vector<uint32_t>& meshletIndices);
 
 	public:
 
@@ -81,9 +128,14 @@ namespace Trinity
 		Material* mMaterial{ nullptr };
 		VertexLayout* mVertexLayout{ nullptr };
 		VertexBuffer* mVertexBuffer{ nullptr };
+		VertexLayout* mPositionLayout{ nullptr };
 		IndexBuffer* mIndexBuffer{ nullptr };
 		uint32_t mNumVertices{ 0 };
 		uint32_t mIndexOffset{ 0 };
 		uint32_t mNumIndices{ 0 };
+		BoundingBox mBounds;
+		std::vector<Model::Lod> mLods;
+		std::vector<Model::Meshlet> mMeshlets;
+		std::vector<uint32_t> mMeshletIndices;
 	};
 }
\ No newline at end of file
@@ -7,11 +7,14 @@
 namespace Trinity
 {
 	class Node;
+	class TransformHierarchy;
 
 	class Transform : public Component
 	{
 	public:
 
+		friend class TransformHierarchy;
+
 		Transform() = default;
 		virtual ~Transform() = default;
 
@@ -41,19 +44,30 @@ namespace Trinity
 			return mScale;
 		}
 
-		const glm::mat4& getWorldMatrix() const
+		TransformHierarchy* getHierarchy() const
+		{
+			return mHierarchy;
+		}
+
+		uint32_t getHierarchyIndex() const
+		{
+			return mHierarchyIndex;
+		}
+
+		uint32_t getWorldVersion() const
 		{
-			const_cast<Transform*>(this)->updateWorldTransform();
-			return mWorldMatrix;
+			return mWorldVersion;
 		}
 
 		virtual std::type_index getType() const override;
 		virtual std::string getTypeStr() const override;
 
+		const glm::mat4& getWorldMatrix() const;
 		glm::mat4 getMatrix() const;
 		void setMatrix(const glm::mat4& matrix);
 
 		void setNode(Node& node);
+		void setHierarchy(TransformHierarchy* hierarchy, uint32_t index);
 		void setTranslation(const glm::vec3& translation);
 		void setRotation(const glm::quat& rotation);
 		void setScale(const glm::vec3& scale);
@@ -68,7 +82,7 @@ namespace Trinity
 
 	protected:
 
-		void updateWorldTransform();
+		void updateWorldTransform() const;
 
 	protected:
 
@@ -76,10 +90,13 @@ namespace Trinity
 		glm::vec3 mTranslation{ 0.0f, 0.0f, 0.0f };
 		glm::quat mRotation{ 1.0f, 0.0f, 0.0f, 0.0f };
 		glm::vec3 mScale{ 1.0f, 1.0f, 1.0f };
-		glm::mat4 mWorldMatrix{ 1.0f };
+		TransformHierarchy* mHierarchy{ nullptr };
+		uint32_t mHierarchyIndex{ 0 };
+		mutable glm::mat4 mWorldMatrix{ 1.0f };
+		mutable uint32_t mWorldVersion{ 0 };
 
 	private:
 
-		bool mUpdateMatrix{ false };
+		mutable bool mUpdateMatrix{ false };
 	};
 }
\ No newline at end of file
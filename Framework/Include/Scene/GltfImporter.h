@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
@@ -25,6 +26,16 @@ namespace Trinity
 	{
 	public:
 
+		static constexpr uint32_t kMaxLods = 4;
+		static constexpr float kLodReduction = 0.5f;
+		static constexpr float kLodTargetError = 0.05f;
+		static constexpr float kLodMinReduction = 0.9f;
+		static constexpr float kOverdrawThreshold = 1.05f;
+		static constexpr uint32_t kVertexCacheSize = 16;
+		static constexpr uint32_t kMeshletMaxVertices = 64;
+		static constexpr uint32_t kMeshletMaxTriangles = 124;
+		static constexpr float kMeshletConeWeight = 0.25f;
+
 		GltfImporter() = default;
 		~GltfImporter() = default;
 
@@ -34,6 +45,26 @@ namespace Trinity
 		GltfImporter(GltfImporter&&) noexcept = default;
 		GltfImporter& operator = (GltfImporter&&) noexcept = default;
 
+		bool hasCompactVertices() const
+		{
+			return mCompactVertices;
+		}
+
+		void setCompactVertices(bool compactVertices)
+		{
+			mCompactVertices = compactVertices;
+		}
+
+		bool hasMeshlets() const
+		{
+			return mMeshlets;
+		}
+
+		void setMeshlets(bool meshlets)
+		{
+			mMeshlets = meshlets;
+		}
+
 		Scene* importScene(const std::string& inputFileName, const std::string& outputFileName, 
 			ResourceCache& cache, bool loadContent = true);
 
@@ -45,5 +76,10 @@ namespace Trinity
 
 		AnimationClip* importAnimation(const std::string& inputFileName, const std::string& outputFileName,
 			ResourceCache& cache, bool loadContent = true);
+
+	protected:
+
+		bool mCompactVertices{ false };
+		bool mMeshlets{ false };
 	};
 }
\ No newline at end of file
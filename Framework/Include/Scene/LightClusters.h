@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Math/Types.h"
+#include "Math/BoundingBox.h"
+#include "Graphics/StorageBuffer.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Trinity
+{
+	class LightClusters
+	{
+	public:
+
+		static constexpr uint32_t kNumClustersX = 16;
+		static constexpr uint32_t kNumClustersY = 9;
+		static constexpr uint32_t kNumClustersZ = 24;
+		static constexpr uint32_t kNumClusters = kNumClustersX * kNumClustersY * kNumClustersZ;
+		static constexpr uint32_t kMinIndexCapacity = 1024;
+
+		struct LightBounds
+		{
+			glm::vec3 position{ 0.0f };
+			float range{ 0.0f };
+			uint32_t index{ 0 };
+			bool global{ false };
+		};
+
+		LightClusters() = default;
+		virtual ~LightClusters() = default;
+
+		LightClusters(const LightClusters&) = delete;
+		LightClusters& operator = (const LightClusters&) = delete;
+
+		LightClusters(LightClusters&&) = default;
+		LightClusters& operator = (LightClusters&&) = default;
+
+		StorageBuffer* getClustersBuffer() const
+		{
+			return mClustersBuffer.get();
+		}
+
+		StorageBuffer* getIndicesBuffer() const
+		{
+			return mIndicesBuffer.get();
+		}
+
+		uint32_t getNumGlobalLights() const
+		{
+			return mNumGlobalLights;
+		}
+
+		uint32_t getNumIndices() const
+		{
+			return (uint32_t)mIndices.size();
+		}
+
+		const glm::vec2& getTileSize() const
+		{
+			return mTileSize;
+		}
+
+		float getDepthScale() const
+		{
+			return mDepthScale;
+		}
+
+		float getDepthBias() const
+		{
+			return mDepthBias;
+		}
+
+		bool create();
+		void destroy();
+
+		bool update(const glm::mat4& view, const glm::mat4& projection, uint32_t width, uint32_t height,
+			const std::vector<LightBounds>& lights);
+
+	protected:
+
+		void updateClusterBounds(const glm::mat4& projection, uint32_t width, uint32_t height);
+		void assignLight(const glm::mat4& view, const glm::mat4& projection, const LightBounds& light);
+		bool upload();
+
+	protected:
+
+		std::unique_ptr<StorageBuffer> mClustersBuffer{ nullptr };
+		std::unique_ptr<StorageBuffer> mIndicesBuffer{ nullptr };
+		std::vector<BoundingBox> mClusterBounds;
+		std::vector<glm::uvec2> mClusters;
+		std::vector<glm::uvec2> mPairs;
+		std::vector<uint32_t> mIndices;
+		glm::mat4 mProjection{ 0.0f };
+		glm::uvec2 mSize{ 0 };
+		glm::vec2 mTileSize{ 1.0f };
+		float mNearPlane{ 0.0f };
+		float mFarPlane{ 0.0f };
+		float mDepthScale{ 0.0f };
+		float mDepthBias{ 0.0f };
+		uint32_t mNumGlobalLights{ 0 };
+		bool mPerspective{ false };
+	};
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Core/Resource.h"
+#include "Math/BoundingBox.h"
 
 namespace Trinity
 {
@@ -17,6 +18,28 @@ namespace Trinity
 	{
 	public:
 
+		// files written before versioning start with the material count instead of the magic
+		static constexpr uint32_t kMagic = 0x4C444D54;
+		static constexpr uint32_t kVersion = 1;
+
+		struct Lod
+		{
+			uint32_t firstIndex{ 0 };
+			uint32_t numIndices{ 0 };
+			float error{ 0.0f };
+		};
+
+		// a range of the full detail lod, its bounding sphere and normal cone are in model space
+		struct Meshlet
+		{
+			glm::vec3 center{ 0.0f };
+			float radius{ 0.0f };
+			glm::vec3 coneAxis{ 0.0f };
+			float coneCutoff{ 1.0f };
+			uint32_t firstIndex{ 0 };
+			uint32_t numIndices{ 0 };
+		};
+
 		struct Mesh
 		{
 			std::string name;
@@ -24,12 +47,16 @@ namespace Trinity
 			std::vector<uint8_t> indexData;
 			VertexLayout* vertexLayout{ nullptr };
 			VertexBuffer* vertexBuffer{ nullptr };
+			VertexLayout* positionLayout{ nullptr };
 			IndexBuffer* indexBuffer{ nullptr };
 			uint32_t vertexSize{ 0 };
 			uint32_t indexSize{ 0 };
 			uint32_t numVertices{ 0 };
 			uint32_t numIndices{ 0 };
 			uint32_t materialIndex{ (uint32_t)-1 };
+			std::vector<Lod> lods;
+			std::vector<Meshlet> meshlets;
+			BoundingBox bounds;
 		};
 
 		Model() = default;
@@ -81,17 +108,31 @@ namespace Trinity
 			return mSkeleton != nullptr;
 		}
 
+		bool hasCompactVertices() const
+		{
+			return mCompactVertices;
+		}
+
 		virtual bool create(const std::string& fileName, ResourceCache& cache, bool loadContent = true) override;
 		virtual void destroy() override;
 		virtual bool write() override;
 
 		virtual std::type_index getType() const override;
+		virtual uint64_t getCpuMemorySize() const override;
+		virtual uint32_t getEvictionPriority() const override;
+		virtual bool getDependencies(FileReader& reader, std::vector<ResourceDependency>& dependencies) override;
 		
 		virtual void setMeshes(std::vector<Mesh>&& meshes);
 		virtual void setMaterials(std::vector<Material*>&& materials);
 		virtual void setSkeleton(Skeleton& skeleton);
 		virtual void setClips(std::vector<AnimationClip*>&& clips);
 		virtual void addClip(AnimationClip& clip);
+		virtual void setCompactVertices(bool compactVertices);
+
+	public:
+
+		static BoundingBox computeBounds(const Mesh& mesh);
+		static bool readHeader(FileReader& reader, uint32_t& version, uint32_t& numMaterials);
 
 	protected:
 
@@ -104,5 +145,6 @@ namespace Trinity
 		std::vector<Material*> mMaterials; 
 		Skeleton* mSkeleton{ nullptr };
 		std::vector<AnimationClip*> mClips;
+		bool mCompactVertices{ false };
 	};
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "Scene/Component.h"
 #include "Scene/Node.h"
 #include "Scene/Components/Light.h"
+#include "Scene/TransformHierarchy.h"
 #include <algorithm>
 #include <memory>
 #include <string>
@@ -41,6 +42,23 @@ namespace Trinity
 			glm::vec4 weight;
 		};
 
+		// positions stay full precision, normals are octahedral snorm16 and uvs are half floats
+		struct VertexCompact
+		{
+			glm::vec3 position;
+			int16_t normal[2];
+			uint16_t uv[2];
+		};
+
+		struct VertexSkinnedCompact
+		{
+			glm::vec3 position;
+			int16_t normal[2];
+			uint16_t uv[2];
+			uint8_t joint[4];
+			uint16_t weight[4];
+		};
+
 		Scene() = default;
 		virtual ~Scene() = default;
 
@@ -60,12 +78,24 @@ namespace Trinity
 			return *mComponentFactory;
 		}
 
+		TransformHierarchy& getTransformHierarchy()
+		{
+			return mTransformHierarchy;
+		}
+
+		std::vector<ResourceDependency>* getPendingDependencies() const
+		{
+			return mPendingDependencies;
+		}
+
 		virtual bool create(const std::string& fileName, ResourceCache& cache, bool loadContent = true) override;
 		virtual void destroy() override;
 		virtual bool write() override;
 
 		virtual std::type_index getType() const override;
+		virtual bool getDependencies(FileReader& reader, std::vector<ResourceDependency>& dependencies) override;
 		virtual void registerDefaultComponents();
+		virtual void updateTransforms();
 
 		virtual bool hasComponent(const std::type_index& type) const;
 		virtual Node* findNode(const std::string& name);
@@ -160,7 +190,9 @@ namespace Trinity
 
 		Node* mRoot{ nullptr };
 		std::unique_ptr<ComponentFactory> mComponentFactory{ nullptr };
+		TransformHierarchy mTransformHierarchy;
 		std::vector<std::unique_ptr<Node>> mNodes;
 		std::unordered_map<std::type_index, std::vector<std::unique_ptr<Component>>> mComponents;
+		std::vector<ResourceDependency>* mPendingDependencies{ nullptr };
 	};
 }
\ No newline at end of file
@@ -1,19 +1,32 @@
 #pragma once
 
 #include "Math/Types.h"
+#include "Math/BoundingBox.h"
+#include "Math/BoundingVolumeHierarchy.h"
+#include "Math/BoundingBoxBatch.h"
+#include "Graphics/UniformAllocator.h"
+#include "Graphics/CullingPass.h"
+#include "Graphics/MeshletCullingPass.h"
+#include "Graphics/DepthPyramid.h"
+#include "Graphics/BindGroup.h"
+#include "Scene/LightClusters.h"
+#include <memory>
 #include <vector>
 #include <string>
-#include <map>
+#include <unordered_map>
 
 namespace Trinity
 {
 	class Material;
+	class Shader;
 	class BindGroupLayout;
 	class BindGroup;
 	class RenderPipeline;
+	struct RenderPipelineProperties;
 	class SubMesh;
 	class Mesh;
 	class Node;
+	class Transform;
 	class Scene;
 	class Camera;
 	class Light;
@@ -21,6 +34,8 @@ namespace Trinity
 	class RenderPass;
 	class UniformBuffer;
 	class StorageBuffer;
+	class VertexBuffer;
+	class IndexBuffer;
 	class ResourceCache;
 
 	class SceneRenderer
@@ -30,6 +45,21 @@ namespace Trinity
 		static constexpr uint32_t kSceneBindGroupIndex = 0;
 		static constexpr uint32_t kMaterialBindGroupIndex = 1;
 		static constexpr uint32_t kTransformBindGroupIndex = 2;
+		static constexpr uint32_t kDepthTransformBindGroupIndex = 1;
+
+		static constexpr const char* kDepthShader = "/Assets/Framework/Shaders/Depth.wgsl";
+
+		static constexpr uint32_t kMaxInstancesPerDraw = 512;
+		static constexpr uint32_t kMaxLightWriteGap = 8;
+
+		static constexpr uint32_t kMainPass = 0;
+		static constexpr uint32_t kSortPassBits = 2;
+		static constexpr uint32_t kSortPipelineBits = 10;
+		static constexpr uint32_t kSortMaterialBits = 12;
+		static constexpr uint32_t kSortGeometryBits = 10;
+		static constexpr uint32_t kSortCoarseDepthBits = 9;
+		static constexpr uint32_t kSortDepthBits = 16;
+		static constexpr uint32_t kSortIndexBits = 20;
 
 		struct LightBufferData
 		{
@@ -46,6 +76,8 @@ namespace Trinity
 			glm::mat4 projection;
 			glm::vec3 cameraPos{ 0 };
 			uint32_t numLights{ 0 };
+			glm::uvec4 clusterSize{ 0 };
+			glm::vec4 clusterParams{ 0 };
 		};
 
 		struct TransformBufferData
@@ -58,6 +90,8 @@ namespace Trinity
 		{
 			Light* light{ nullptr };
 			uint32_t storageIndex{ 0 };
+			uint32_t lightVersion{ (uint32_t)-1 };
+			uint32_t transformVersion{ (uint32_t)-1 };
 		};
 
 		struct SceneData
@@ -67,21 +101,85 @@ namespace Trinity
 			ResourceCache* cache{ nullptr };
 			BindGroup* sceneBindGroup{ nullptr };
 			BindGroupLayout* sceneBindGroupLayout{ nullptr };
+			BindGroup* transformBindGroup{ nullptr };
+			BindGroupLayout* transformBindGroupLayout{ nullptr };
+			BindGroup* indirectBindGroup{ nullptr };
+			Shader* depthShader{ nullptr };
 			UniformBuffer* sceneBuffer{ nullptr };
 			StorageBuffer* lightsBuffer{ nullptr };
+			StorageBuffer* lightIndicesBuffer{ nullptr };
 		};
 
 		struct RenderData
 		{
 			SubMesh* subMesh{ nullptr };
 			Mesh* mesh{ nullptr };
-			UniformBuffer* transformBuffer{ nullptr };
 			RenderPipeline* pipeline{ nullptr };
+			RenderPipeline* defaultPipeline{ nullptr };
+			RenderPipeline* equalPipeline{ nullptr };
+			RenderPipeline* depthPipeline{ nullptr };
 			BindGroup* materialBindGroup{ nullptr };
 			BindGroup* meshBindGroup{ nullptr };
 			BindGroupLayout* meshBindGroupLayout{ nullptr };
 			StorageBuffer* meshBindPoseBuffer{ nullptr };
 			StorageBuffer* meshInvBindPoseBuffer{ nullptr };
+			TransformBufferData transformData;
+			uint32_t transformVersion{ (uint32_t)-1 };
+			BoundingBox worldBounds;
+			uint32_t worldVersion{ (uint32_t)-1 };
+			uint32_t proxyId{ BoundingVolumeHierarchy::kNullNode };
+			uint32_t pipelineId{ 0 };
+			uint32_t materialId{ 0 };
+			uint32_t geometryId{ 0 };
+			uint32_t lod{ 0 };
+			uint32_t meshletGroup{ (uint32_t)-1 };
+			uint32_t meshletVersion{ (uint32_t)-1 };
+			bool transparent{ false };
+			bool gpuCulled{ false };
+			bool depthPrepass{ false };
+		};
+
+		struct DrawBatch
+		{
+			uint32_t firstKey{ 0 };
+			uint32_t numInstances{ 0 };
+			uint32_t transformOffset{ 0 };
+		};
+
+		struct IndirectDraw
+		{
+			uint32_t firstRenderer{ 0 };
+			uint32_t transformOffset{ 0 };
+		};
+
+		struct DrawState
+		{
+			const RenderPipeline* pipeline{ nullptr };
+			const BindGroup* materialBindGroup{ nullptr };
+			const BindGroup* meshBindGroup{ nullptr };
+			uint32_t transformOffset{ UniformAllocator::kInvalidOffset };
+			const VertexBuffer* vertexBuffer{ nullptr };
+			const IndexBuffer* indexBuffer{ nullptr };
+		};
+
+		struct RenderStats
+		{
+			uint32_t numVisible{ 0 };
+			uint32_t numCulled{ 0 };
+			uint32_t numPipelineChanges{ 0 };
+			uint32_t numBindGroupChanges{ 0 };
+			uint32_t numDrawCalls{ 0 };
+			uint32_t numIndirectDraws{ 0 };
+			uint32_t numOccluded{ 0 };
+			uint32_t numEarlyInstances{ 0 };
+			uint32_t numLateInstances{ 0 };
+			uint32_t numPrepassDraws{ 0 };
+			uint32_t numLightWrites{ 0 };
+			uint32_t numMeshlets{ 0 };
+			uint32_t numMeshletsFrustumCulled{ 0 };
+			uint32_t numMeshletsConeCulled{ 0 };
+			float prepassTime{ 0.0f };
+			float mainPassTime{ 0.0f };
 		};
 
 		SceneRenderer() = default;
@@ -93,27 +191,134 @@ namespace Trinity
 		SceneRenderer(SceneRenderer&&) = default;
 		SceneRenderer& operator = (SceneRenderer&&) = default;
 
+		const RenderStats& getStats() const
+		{
+			return mStats;
+		}
+
+		const BoundingVolumeHierarchy& getBoundsTree() const
+		{
+			return mBoundsTree;
+		}
+
+		bool isCullingEnabled() const
+		{
+			return mCullingEnabled;
+		}
+
+		bool isGpuCullingEnabled() const
+		{
+			return mGpuCullingEnabled;
+		}
+
+		bool isOcclusionCullingEnabled() const
+		{
+			return mOcclusionCullingEnabled;
+		}
+
+		bool isDepthPrepassEnabled() const
+		{
+			return mDepthPrepassEnabled;
+		}
+
+		bool isMeshletCullingEnabled() const
+		{
+			return mMeshletCullingEnabled;
+		}
+
+		float getLodThreshold() const
+		{
+			return mLodThreshold;
+		}
+
 		bool prepare(Scene& scene, ResourceCache& cache);
+		void setCullingEnabled(bool enabled);
+		void setGpuCullingEnabled(bool enabled);
+		void setOcclusionCullingEnabled(bool enabled);
+		void setDepthPrepassEnabled(bool enabled);
+		void setDepthPrepass(const Mesh& mesh, bool enabled);
+		void setMeshletCullingEnabled(bool enabled);
+		void setLodThreshold(float threshold);
+
+		Mesh* pick(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, float& distance);
+		void queryOverlaps(const BoundingBox& bounds, std::vector<Mesh*>& meshes);
 		void setCamera(const std::string& nodeName);
 		void draw(RenderPass& renderPass);
 
 	protected:
 
 		bool setupRenderData(Mesh* mesh, SubMesh* subMesh, RenderData& renderData);
+		bool setupTransformData(uint32_t numRenderers);
+		bool setupDepthPrepass(const Material* material, const RenderPipelineProperties& renderProps,
+			RenderData& renderData);
+		bool setupMeshData(Mesh* mesh, RenderData& renderData);
 		bool updateMeshData(Mesh* mesh, Node* node, RenderData& renderData);
+		bool setupIndirectDraws();
+		bool updateIndirectDraws();
+		bool updateDepthPyramid();
+		bool setupMeshlets();
+		bool updateMeshlets();
 
 		bool updateSceneData();
 		bool updateLights();
-		bool updateLightData(Light* light, uint32_t index);
+		bool packLightData(LightData& lightData);
+		void writeLightData(uint32_t first, uint32_t last);
+		bool updateClusters();
+		bool createSceneBindGroup();
+
+		void draw(RenderPass& renderPass, const DrawBatch& batch);
+		void draw(RenderPass& renderPass, const IndirectDraw& indirectDraw, uint32_t drawIndex);
+		void drawDepth(RenderPass& renderPass, const DrawBatch& batch);
+		void drawSubMesh(RenderPass& renderPass, const RenderData& renderer, uint32_t numInstances);
+		void setDrawState(RenderPass& renderPass, const RenderData& renderer, const BindGroup* meshBindGroup,
+			uint32_t transformOffset);
+		bool isMeshletDraw(const RenderData& renderer) const;
+		const IndexBuffer* getIndexBuffer(const RenderData& renderer) const;
+		void updateWorldBounds(RenderData& renderData);
+		void updateBounds();
+		void cullRenderers();
+		void selectLods();
+		void sortRenderers(uint32_t pass);
+		bool buildBatches();
+
+	public:
 
-		void draw(RenderPass& renderPass, RenderData& renderer);
-		void getSortedRenderers(std::multimap<float, RenderData*>& opaqueRenderers, 
-			std::multimap<float, RenderData*>& transparentRenderers);
+		static uint64_t getSortKey(uint32_t pass, const RenderData& renderData, float distance, uint32_t index);
+		static bool canInstance(const RenderData& first, const RenderData& renderData);
 
 	protected:
 
 		SceneData mSceneData;
 		std::vector<RenderData> mRenderers;
 		std::vector<LightData> mLights;
+		std::vector<LightBufferData> mLightsData;
+		std::vector<LightClusters::LightBounds> mLightBounds;
+		LightClusters mLightClusters;
+		std::unique_ptr<BindGroup> mSceneBindGroup{ nullptr };
+		std::unique_ptr<StorageBuffer> mLightsBuffer{ nullptr };
+		RenderStats mStats;
+		BoundingVolumeHierarchy mBoundsTree;
+		std::unordered_map<const Transform*, std::pair<uint32_t, uint32_t>> mTransformRenderers;
+		std::vector<uint32_t> mUntrackedRenderers;
+		std::vector<uint32_t> mVisibleRenderers;
+		std::vector<uint32_t> mCandidateRenderers;
+		std::vector<uint64_t> mCandidateVisibility;
+		BoundingBoxBatch mCandidateBounds;
+		std::vector<uint64_t> mSortKeys;
+		std::vector<uint64_t> mSortScratch;
+		std::vector<DrawBatch> mDrawBatches;
+		std::vector<uint32_t> mIndirectRenderers;
+		std::vector<IndirectDraw> mIndirectDraws;
+		CullingPass mCullingPass;
+		MeshletCullingPass mMeshletCullingPass;
+		DepthPyramid mDepthPyramid;
+		DrawState mDrawState;
+		UniformAllocator mTransformAllocator;
+		bool mCullingEnabled{ true };
+		bool mGpuCullingEnabled{ false };
+		bool mOcclusionCullingEnabled{ false };
+		bool mDepthPrepassEnabled{ false };
+		bool mMeshletCullingEnabled{ false };
+		float mLodThreshold{ 1.0f };
 	};
 }
\ No newline at end of file
@@ -36,6 +36,7 @@ namespace Trinity
 		virtual bool create(const std::string& fileName, ResourceCache& cache, bool loadContent = true) override;
 		virtual void destroy() override;
 		virtual bool write() override;
+		virtual bool canReadAsync() const override;
 
 		virtual bool load(const std::string& fileName);
 		virtual bool load(const std::string& fileName, uint32_t width, uint32_t height);
@@ -48,6 +49,7 @@ namespace Trinity
 		virtual void setData(std::vector<uint16_t>&& data);
 
 		virtual std::type_index getType() const override;
+		virtual uint64_t getCpuMemorySize() const override;
 
 	protected:
 
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Math/Types.h"
+#include "Core/JobSystem.h"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Trinity
+{
+	class Node;
+	class Transform;
+
+	class TransformHierarchy
+	{
+	public:
+
+		static constexpr uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+		static constexpr uint32_t kMinParallelTransforms = 4096;
+		static constexpr uint32_t kMinParallelSubtrees = 64;
+
+		static constexpr uint8_t kLocalDirty = 1 << 0;
+		static constexpr uint8_t kWorldDirty = 1 << 1;
+
+		TransformHierarchy() = default;
+		virtual ~TransformHierarchy() = default;
+
+		TransformHierarchy(const TransformHierarchy&) = delete;
+		TransformHierarchy& operator = (const TransformHierarchy&) = delete;
+
+		TransformHierarchy(TransformHierarchy&&) = default;
+		TransformHierarchy& operator = (TransformHierarchy&&) = default;
+
+		uint32_t getNumTransforms() const
+		{
+			return (uint32_t)mTransforms.size();
+		}
+
+		uint32_t getParent(uint32_t index) const
+		{
+			return mParents[index];
+		}
+
+		const glm::mat4& getLocalMatrix(uint32_t index) const
+		{
+			return mLocalMatrices[index];
+		}
+
+		const glm::mat4& getWorldMatrix(uint32_t index) const
+		{
+			return mWorldMatrices[index];
+		}
+
+		const std::vector<Transform*>& getChangedTransforms() const
+		{
+			return mChangedTransforms;
+		}
+
+		bool hasChangesOverflowed() const
+		{
+			return mChangesOverflowed;
+		}
+
+		bool isDirty() const
+		{
+			return mDirty;
+		}
+
+		bool isParallel() const
+		{
+			return mParallel;
+		}
+
+		bool needsRebuild() const
+		{
+			return mNeedsRebuild;
+		}
+
+		virtual void build(Node& root);
+		virtual void clearChanges();
+		virtual void destroy();
+		virtual void invalidate();
+		virtual void markDirty(uint32_t index);
+		virtual void setParallel(bool parallel);
+		virtual void update();
+
+	protected:
+
+		void buildSubtrees();
+		void updateRange(uint32_t start, uint32_t end, std::vector<Transform*>& changed);
+
+	protected:
+
+		std::vector<Transform*> mTransforms;
+		std::vector<uint32_t> mParents;
+		std::vector<glm::mat4> mLocalMatrices;
+		std::vector<glm::mat4> mWorldMatrices;
+		std::vector<uint8_t> mDirtyFlags;
+		std::vector<uint32_t> mSubtreeRoots;
+		std::vector<std::pair<uint32_t, uint32_t>> mSubtrees;
+		std::vector<std::pair<uint32_t, uint32_t>> mChunks;
+		std::vector<std::vector<Transform*>> mChunkChanges;
+		std::vector<Transform*> mChangedTransforms;
+		std::unique_ptr<JobSystem> mJobSystem{ nullptr };
+		bool mDirty{ false };
+		bool mParallel{ false };
+		bool mNeedsRebuild{ true };
+		bool mChangesOverflowed{ true };
+	};
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Trinity
+{
+	class HashHelper
+	{
+	public:
+
+		static constexpr uint64_t kSeed = 14695981039346656037ull;
+
+		static uint64_t hash(const void* data, size_t size, uint64_t seed = kSeed);
+		static uint64_t hash(const std::string& str, uint64_t seed = kSeed);
+		static uint64_t combine(uint64_t seed, uint64_t value);
+		static std::string toString(uint64_t hash);
+	};
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Trinity
+{
+	class SortHelper
+	{
+	public:
+
+		static constexpr uint32_t kRadixBits = 8;
+		static constexpr uint32_t kRadixSize = 1 << kRadixBits;
+		static constexpr uint32_t kNumRadixPasses = 64 / kRadixBits;
+
+		static void radixSort(std::vector<uint64_t>& keys, std::vector<uint64_t>& scratch);
+	};
+}
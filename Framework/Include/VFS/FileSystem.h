@@ -6,6 +6,7 @@
 #include "Core/Singleton.h"
 #include <unordered_map>
 #include <string>
+#include <mutex>
 
 #include <filesystem>
 namespace fs = std::filesystem;
@@ -44,9 +45,16 @@ namespace Trinity
 		bool createDirs(const std::string& dir) const;
 		bool copyFile(const std::string& from, const std::string& to) const;
 		bool copyFiles(const std::string& from, const std::string& to) const;
+		bool moveFile(const std::string& from, const std::string& to) const;
+		bool removeFile(const std::string& filePath) const;
+
+		void addMemoryFile(const std::string& filePath, std::vector<uint8_t>&& data);
+		void removeMemoryFile(const std::string& filePath);
 
 	protected:
 
 		std::unordered_map<std::string, std::unique_ptr<Storage>> mStorages;
+		std::unordered_map<std::string, std::vector<uint8_t>> mMemoryFiles;
+		mutable std::mutex mMemoryFilesMutex;
 	};
 }
\ No newline at end of file
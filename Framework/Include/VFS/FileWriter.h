@@ -2,6 +2,7 @@
 
 #include "VFS/File.h"
 #include <vector>
+#include <algorithm>
 #include <unordered_map>
 
 namespace Trinity
@@ -10,10 +11,13 @@ namespace Trinity
 	{
 	public:
 
-		FileWriter(File& file)
-			: mFile(file)
-		{
-		}
+		static constexpr uint32_t kDefaultBufferSize = 1024 * 1024;
+
+		FileWriter(File& file, uint32_t bufferSize = kDefaultBufferSize);
+		~FileWriter();
+
+		FileWriter(const FileWriter&) = delete;
+		FileWriter& operator = (const FileWriter&) = delete;
 
 		const File& getFile() const
 		{
@@ -22,12 +26,12 @@ namespace Trinity
 
 		uint32_t getSize() const
 		{
-			return mFile.getSize();
+			return std::max(mFile.getSize(), getPosition());
 		}
 
 		uint32_t getPosition() const
 		{
-			return mFile.getPosition();
+			return mFile.getPosition() + static_cast<uint32_t>(mBuffer.size());
 		}
 
 		const std::string& getPath() const
@@ -43,7 +47,7 @@ namespace Trinity
 		template <typename T>
 		bool write(const T* data, uint32_t count = 1, uint32_t* writeSize = nullptr)
 		{
-			return mFile.write(data, sizeof(T) * count, writeSize);
+			return writeBytes(data, sizeof(T) * count, writeSize);
 		}
 
 		template <typename T>
@@ -81,11 +85,15 @@ namespace Trinity
 			return true;
 		}
 
+		bool writeBytes(const void* data, uint32_t size, uint32_t* writeSize = nullptr);
 		bool writeString(const std::string& str);
 		bool seek(SeekOrigin origin, uint32_t offset);
+		bool flush();
 
 	private:
 
 		File& mFile;
+		uint32_t mBufferSize{ 0 };
+		std::vector<uint8_t> mBuffer;
 	};
 }
\ No newline at end of file
@@ -33,6 +33,8 @@ namespace Trinity
 		virtual bool createDir(const std::string& dir) override;
 		virtual bool copyFile(const std::string& from, const std::string& to) override;
 		virtual bool copyFiles(const std::string& from, const std::string& to) override;
+		virtual bool moveFile(const std::string& from, const std::string& to) override;
+		virtual bool removeFile(const std::string& filePath) override;
 
 	private:
 
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "VFS/File.h"
+#include <vector>
+
+namespace Trinity
+{
+	class MemoryFile : public File
+	{
+	public:
+
+		MemoryFile() = default;
+		virtual ~MemoryFile() = default;
+
+		MemoryFile(const MemoryFile&) = delete;
+		MemoryFile& operator = (const MemoryFile&) = delete;
+
+		MemoryFile(MemoryFile&&) = default;
+		MemoryFile& operator = (MemoryFile&&) = default;
+
+		const std::vector<uint8_t>& getData() const
+		{
+			return mData;
+		}
+
+		virtual bool create(const std::string& filePath, std::vector<uint8_t>&& data,
+			FileOpenMode fileOpenMode = FileOpenMode::OpenRead);
+
+		virtual std::vector<uint8_t> release();
+
+		virtual bool isEOF() const override;
+		virtual bool seek(SeekOrigin origin, int32_t offset) override;
+		virtual bool read(void* data, uint32_t size, uint32_t* readSize = nullptr) override;
+		virtual bool write(const void* data, uint32_t size, uint32_t* writeSize = nullptr) override;
+
+	private:
+
+		std::vector<uint8_t> mData;
+	};
+}
@@ -37,6 +37,8 @@ namespace Trinity
 		virtual bool createDir(const std::string& dir) = 0;
 		virtual bool copyFile(const std::string& from, const std::string& to) = 0;
 		virtual bool copyFiles(const std::string& from, const std::string& to) = 0;
+		virtual bool moveFile(const std::string& from, const std::string& to) = 0;
+		virtual bool removeFile(const std::string& filePath) = 0;
 
 	protected:
 
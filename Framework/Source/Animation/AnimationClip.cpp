@@ -20,6 +20,11 @@ namespace Trinity
 		return Resource::write();
 	}
 
+	bool AnimationClip::canReadAsync() const
+	{
+		return true;
+	}
+
 	std::type_index AnimationClip::getType() const
 	{
 		return typeid(AnimationClip);
@@ -24,6 +24,11 @@ namespace Trinity
 		return Resource::write();
 	}
 
+	bool Skeleton::canReadAsync() const
+	{
+		return true;
+	}
+
 	std::type_index Skeleton::getType() const
 	{
 		return typeid(Skeleton);
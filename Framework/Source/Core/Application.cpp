@@ -10,6 +10,8 @@
 #include "Graphics/GraphicsDevice.h"
 #include "Graphics/SwapChain.h"
 #include "Graphics/RenderPass.h"
+#include "Graphics/PipelineCache.h"
+#include "Graphics/BlobCache.h"
 #include "Gui/ImGuiRenderer.h"
 #include <iostream>
 
@@ -54,6 +56,7 @@ namespace Trinity
 		mWindow = std::make_unique<Window>();
 		mGraphicsDevice = std::make_unique<GraphicsDevice>();
 		mResourceCache = std::make_unique<ResourceCache>();
+		mPipelineCache = std::make_unique<PipelineCache>();
 
 		if (!Window::initialize())
 		{
@@ -74,6 +77,20 @@ namespace Trinity
 			return;
 		}
 
+		if (!mOptions.cacheFolder.empty())
+		{
+			mBlobCache = std::make_unique<BlobCache>();
+			if (mBlobCache->create(mOptions.cacheFolder))
+			{
+				mGraphicsDevice->setBlobCache(mBlobCache.get());
+			}
+			else
+			{
+				LogWarning("BlobCache::create() failed for: %s", mOptions.cacheFolder.c_str());
+				mBlobCache = nullptr;
+			}
+		}
+
 		mGraphicsDevice->onCreated.subscribe([this](bool result) {
 			if (result)
 			{
@@ -191,6 +208,7 @@ namespace Trinity
 	{
 		mClock->update();
 		mInput->update();
+		mResourceCache->update();
 		mGraphicsDevice->clearScreen();
 
 		update(mClock->getDeltaTime());
@@ -0,0 +1,132 @@
+#include "Core/ContentManifest.h"
+#include "Core/ResourceCache.h"
+#include "Core/Logger.h"
+#include "VFS/FileSystem.h"
+
+namespace Trinity
+{
+	bool ContentManifest::create(const std::string& fileName, ResourceCache& cache, bool loadContent)
+	{
+		return Resource::create(fileName, cache, loadContent);
+	}
+
+	void ContentManifest::destroy()
+	{
+		Resource::destroy();
+		mEntries.clear();
+	}
+
+	bool ContentManifest::write()
+	{
+		return Resource::write();
+	}
+
+	std::type_index ContentManifest::getType() const
+	{
+		return typeid(ContentManifest);
+	}
+
+	bool ContentManifest::hasEntry(const std::string& name) const
+	{
+		return mEntries.contains(name);
+	}
+
+	uint64_t ContentManifest::getHash(const std::string& name) const
+	{
+		auto it = mEntries.find(name);
+		if (it != mEntries.end())
+		{
+			return it->second.hash;
+		}
+
+		return 0;
+	}
+
+	std::string ContentManifest::getFileName(const std::string& name) const
+	{
+		auto it = mEntries.find(name);
+		if (it != mEntries.end())
+		{
+			return it->second.fileName;
+		}
+
+		return {};
+	}
+
+	void ContentManifest::setEntry(const std::string& name, uint64_t hash, const std::string& fileName)
+	{
+		mEntries[name] = { hash, fileName };
+	}
+
+	void ContentManifest::removeMissing()
+	{
+		auto& fileSystem = FileSystem::get();
+		std::erase_if(mEntries, [&fileSystem](const auto& entry) {
+			return !fileSystem.isExist(entry.second.fileName);
+		});
+	}
+
+	bool ContentManifest::read(FileReader& reader, ResourceCache& cache)
+	{
+		if (!Resource::read(reader, cache))
+		{
+			return false;
+		}
+
+		uint32_t numEntries{ 0 };
+		reader.read(&numEntries);
+
+		for (uint32_t idx = 0; idx < numEntries; idx++)
+		{
+			auto name = reader.readString();
+			ContentEntry entry;
+
+			reader.read(&entry.hash);
+			entry.fileName = reader.readString();
+			mEntries[name] = std::move(entry);
+		}
+
+		return true;
+	}
+
+	bool ContentManifest::write(FileWriter& writer)
+	{
+		if (!Resource::write(writer))
+		{
+			return false;
+		}
+
+		const uint32_t numEntries = (uint32_t)mEntries.size();
+		writer.write(&numEntries);
+
+		for (auto& [name, entry] : mEntries)
+		{
+			writer.writeString(name);
+			writer.write(&entry.hash);
+			writer.writeString(entry.fileName);
+		}
+
+		return true;
+	}
+
+	ContentManifest* ContentManifest::getOrCreate(const std::string& fileName, ResourceCache& cache)
+	{
+		if (!cache.isLoaded<ContentManifest>(fileName))
+		{
+			const bool exists = FileSystem::get().isExist(fileName);
+
+			auto manifest = std::make_unique<ContentManifest>();
+			if (!manifest->create(fileName, cache, exists))
+			{
+				LogError("ContentManifest::create() failed for: %s!!", fileName.c_str());
+				return nullptr;
+			}
+
+			// entries whose files were deleted since the last import are dropped
+			manifest->removeMissing();
+			cache.addResource(std::move(manifest));
+		}
+
+		return cache.getResource<ContentManifest>(fileName);
+	}
+}
@@ -1,7 +1,9 @@
 #include "Core/Image.h"
 #include "Core/Debugger.h"
 #include "Core/Logger.h"
+#include "Core/ResourceCache.h"
 #include "VFS/FileSystem.h"
+#include "Utils/HashHelper.h"
 
 #define _USE_MATH_DEFINES
 #include <cmath>
@@ -37,11 +39,21 @@ namespace Trinity
 		return Resource::write();
 	}
 
+	bool Image::canReadAsync() const
+	{
+		return true;
+	}
+
 	std::type_index Image::getType() const
 	{
 		return typeid(Image);
 	}
 
+	uint64_t Image::getCpuMemorySize() const
+	{
+		return mData.size();
+	}
+
 	bool Image::load(const std::string& filePath)
 	{
 		auto file = FileSystem::get().openFile(filePath, FileOpenMode::OpenRead);
@@ -105,6 +117,30 @@ namespace Trinity
 		return true;
 	}
 
+	uint64_t Image::getContentHash() const
+	{
+		const uint32_t header[] = {
+			(uint32_t)mImageType,
+			mWidth,
+			mHeight,
+			mDepth,
+			mChannels
+		};
+
+		uint64_t hash = HashHelper::hash(header, sizeof(header));
+		return HashHelper::hash(mData.data(), mData.size(), hash);
+	}
+
+	bool Image::isSameContent(const Image& other) const
+	{
+		return mImageType == other.mImageType &&
+			mWidth == other.mWidth &&
+			mHeight == other.mHeight &&
+			mDepth == other.mDepth &&
+			mChannels == other.mChannels &&
+			mData == other.mData;
+	}
+
 	std::vector<Mipmap> Image::generateMipmaps() const
 	{
 		std::vector<Mipmap> mipmaps;
@@ -366,4 +402,43 @@ namespace Trinity
 		return true;
 	}
 
+	std::string Image::getContentFileName(const Image& image, const std::string& imagesPath, ResourceCache& cache)
+	{
+		// the hash only picks the name, a taken name is reused when its pixels match
+		// and a colliding image moves on to the next suffix
+		auto& fileSystem = FileSystem::get();
+		const auto hashName = HashHelper::toString(image.getContentHash());
+
+		for (uint32_t suffix = 0; ; suffix++)
+		{
+			fs::path fileName(imagesPath);
+			fileName.append(suffix > 0 ? hashName + "_" + std::to_string(suffix) : hashName);
+			fileName.replace_extension("png");
+
+			const auto imageFileName = fileSystem.sanitizePath(fileName.string());
+			if (cache.isLoaded<Image>(imageFileName))
+			{
+				if (cache.getResource<Image>(imageFileName)->isSameContent(image))
+				{
+					return imageFileName;
+				}
+
+				continue;
+			}
+
+			if (!fileSystem.isExist(imageFileName))
+			{
+				return imageFileName;
+			}
+
+			Image existing;
+			if (existing.load(imageFileName) && existing.isSameContent(image))
+			{
+				return imageFileName;
+			}
+
+			LogWarning("Image file '%s' holds different pixels, trying the next name!!", imageFileName.c_str());
+		}
+	}
+
 }
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include "Core/JobSystem.h"
+
+namespace Trinity
+{
+	JobSystem::~JobSystem()
+	{
+		destroy();
+	}
+
+	bool JobSystem::create(uint32_t numThreads)
+	{
+		destroy();
+		mExit = false;
+
+		for (uint32_t idx = 0; idx < numThreads; idx++)
+		{
+			mThreads.emplace_back([this]() {
+				execute();
+			});
+		}
+
+		return true;
+	}
+
+	void JobSystem::destroy()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mExit = true;
+		}
+
+		mJobsCondition.notify_all();
+
+		for (auto& thread : mThreads)
+		{
+			if (thread.joinable())
+			{
+				thread.join();
+			}
+		}
+
+		mThreads.clear();
+	}
+
+	void JobSystem::run(uint32_t numJobs, const Job& job)
+	{
+		if (mThreads.empty() || numJobs < 2)
+		{
+			for (uint32_t idx = 0; idx < numJobs; idx++)
+			{
+				job(idx);
+			}
+
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mJob = &job;
+			mNumJobs = numJobs;
+			mNextJob = 0;
+			mNumDone = 0;
+			mGeneration++;
+		}
+
+		mJobsCondition.notify_all();
+
+		// the calling thread works through the jobs as well instead of only waiting
+		while (runNext())
+		{
+		}
+
+		std::unique_lock<std::mutex> lock(mMutex);
+		mDoneCondition.wait(lock, [this]() {
+			return mNumDone == mNumJobs;
+		});
+
+		mJob = nullptr;
+	}
+
+	bool JobSystem::runNext()
+	{
+		const Job* job{ nullptr };
+		uint32_t jobIndex{ 0 };
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			if (mJob == nullptr || mNextJob == mNumJobs)
+			{
+				return false;
+			}
+
+			job = mJob;
+			jobIndex = mNextJob++;
+		}
+
+		(*job)(jobIndex);
+
+		bool done{ false };
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			done = ++mNumDone == mNumJobs;
+		}
+
+		if (done)
+		{
+			mDoneCondition.notify_all();
+		}
+
+		return true;
+	}
+
+	void JobSystem::execute()
+	{
+		uint64_t generation{ 0 };
+
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				mJobsCondition.wait(lock, [this, generation]() {
+					return mExit || mGeneration != generation;
+				});
+
+				if (mExit)
+				{
+					return;
+				}
+
+				generation = mGeneration;
+			}
+
+			while (runNext())
+			{
+			}
+		}
+	}
+}
\ No newline at end of file
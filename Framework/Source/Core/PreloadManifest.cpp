@@ -0,0 +1,126 @@
+#include "Core/PreloadManifest.h"
+#include "Core/ContentManifest.h"
+#include "Core/ResourceCache.h"
+#include "Core/Logger.h"
+#include "VFS/FileSystem.h"
+#include <algorithm>
+
+namespace Trinity
+{
+	bool PreloadManifest::create(const std::string& fileName, ResourceCache& cache, bool loadContent)
+	{
+		return Resource::create(fileName, cache, loadContent);
+	}
+
+	void PreloadManifest::destroy()
+	{
+		Resource::destroy();
+
+		mEntries.clear();
+		mTotalSize = 0;
+	}
+
+	bool PreloadManifest::write()
+	{
+		return Resource::write();
+	}
+
+	std::type_index PreloadManifest::getType() const
+	{
+		return typeid(PreloadManifest);
+	}
+
+	void PreloadManifest::addEntry(const std::string& fileName, const std::string& type, uint64_t size)
+	{
+		mEntries.push_back({
+			.fileName = fileName,
+			.type = type,
+			.size = size
+		});
+
+		mTotalSize += size;
+	}
+
+	void PreloadManifest::addResources(const ResourceCache& cache)
+	{
+		auto& fileSystem = FileSystem::get();
+
+		cache.visitResources([&](const Resource& resource) {
+			const auto& fileName = resource.getFileName();
+			const auto type = resource.getType();
+
+			if (fileName.empty() || fileName == mFileName || type == typeid(ContentManifest))
+			{
+				return;
+			}
+
+			auto file = fileSystem.openFile(fileName, FileOpenMode::OpenRead);
+			if (!file)
+			{
+				LogWarning("PreloadManifest::addResources() skipping missing file: %s", fileName.c_str());
+				return;
+			}
+
+			addEntry(fileName, type.name(), file->getSize());
+		});
+
+		std::sort(mEntries.begin(), mEntries.end(), [](const Entry& a, const Entry& b) {
+			return a.fileName < b.fileName;
+		});
+	}
+
+	bool PreloadManifest::read(FileReader& reader, ResourceCache& cache)
+	{
+		if (!Resource::read(reader, cache))
+		{
+			return false;
+		}
+
+		uint32_t numEntries{ 0 };
+		reader.read(&numEntries);
+
+		mEntries.clear();
+		mTotalSize = 0;
+
+		for (uint32_t idx = 0; idx < numEntries; idx++)
+		{
+			auto fileName = Resource::getReadPath(reader.getPath(), reader.readString());
+			auto type = reader.readString();
+
+			uint64_t size{ 0 };
+			reader.read(&size);
+
+			addEntry(fileName, type, size);
+		}
+
+		return true;
+	}
+
+	bool PreloadManifest::write(FileWriter& writer)
+	{
+		if (!Resource::write(writer))
+		{
+			return false;
+		}
+
+		const uint32_t numEntries = (uint32_t)mEntries.size();
+		writer.write(&numEntries);
+
+		for (auto& entry : mEntries)
+		{
+			writer.writeString(Resource::getWritePath(writer.getPath(), entry.fileName));
+			writer.writeString(entry.type);
+			writer.write(&entry.size);
+		}
+
+		return true;
+	}
+
+	std::string PreloadManifest::getManifestFileName(const std::string& fileName)
+	{
+		fs::path path(fileName);
+		path.replace_extension(kExtension);
+
+		return FileSystem::get().sanitizePath(path.string());
+	}
+}
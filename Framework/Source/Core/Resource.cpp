@@ -2,6 +2,8 @@
 #include "VFS/FileSystem.h"
 #include "Core/ResourceCache.h"
 #include "Core/Logger.h"
+#include <algorithm>
+#include <cstring>
 
 namespace Trinity
 {
@@ -66,27 +68,96 @@ namespace Trinity
 			return false;
 		}
 
-		auto file = FileSystem::get().openFile(mFileName, FileOpenMode::OpenWrite);
+		auto& fileSystem = FileSystem::get();
+		const std::string tempFileName = mFileName + ".tmp";
+
+		if (!writeFile(tempFileName))
+		{
+			LogError("Resource::writeFile() failed for: %s!!", tempFileName.c_str());
+			fileSystem.removeFile(tempFileName);
+			return false;
+		}
+
+		// only a byte for byte match skips the write
+		if (fileSystem.isExist(mFileName) && isContentEqual(mFileName, tempFileName))
+		{
+			LogInfo("Resource file '%s' unchanged, skipping re-write", mFileName.c_str());
+			fileSystem.removeFile(tempFileName);
+			return true;
+		}
+
+		if (!fileSystem.moveFile(tempFileName, mFileName))
+		{
+			LogError("FileSystem::moveFile() failed for: %s!!", mFileName.c_str());
+			fileSystem.removeFile(tempFileName);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool Resource::writeFile(const std::string& fileName)
+	{
+		auto file = FileSystem::get().openFile(fileName, FileOpenMode::OpenWrite);
 		if (!file)
 		{
-			LogError("Error opening resource file: %s", mFileName.c_str());
+			LogError("Error opening resource file: %s", fileName.c_str());
 			return false;
 		}
 
 		FileWriter writer(*file);
 		if (!write(writer))
 		{
-			LogError("Resource::write() failed for: %s!!", mFileName.c_str());
+			LogError("Resource::write() failed for: %s!!", fileName.c_str());
 			return false;
 		}
 
-		return true;
+		return writer.flush();
 	}
 
 	void Resource::destroy()
 	{
 	}
 
+	uint64_t Resource::getCpuMemorySize() const
+	{
+		return 0;
+	}
+
+	uint64_t Resource::getGpuMemorySize() const
+	{
+		return 0;
+	}
+
+	uint32_t Resource::getEvictionPriority() const
+	{
+		return 1;
+	}
+
+	bool Resource::canReadAsync() const
+	{
+		return false;
+	}
+
+	bool Resource::getDependencies(FileReader& reader, std::vector<ResourceDependency>& dependencies)
+	{
+		return true;
+	}
+
+	bool Resource::readFile(File& file, ResourceCache& cache)
+	{
+		mFileName = file.getPath();
+
+		FileReader reader(file);
+		if (!read(reader, cache))
+		{
+			LogError("Resource::read() failed for: %s!!", mFileName.c_str());
+			return false;
+		}
+
+		return true;
+	}
+
 	bool Resource::read(FileReader& reader, ResourceCache& cache)
 	{
 		mName = reader.readString();
@@ -99,6 +170,46 @@ namespace Trinity
 		return true;
 	}
 
+	bool Resource::isContentEqual(const std::string& fileName, const std::string& otherFileName)
+	{
+		auto& fileSystem = FileSystem::get();
+
+		auto file = fileSystem.openFile(fileName, FileOpenMode::OpenRead);
+		auto otherFile = fileSystem.openFile(otherFileName, FileOpenMode::OpenRead);
+
+		if (!file || !otherFile || file->getSize() != otherFile->getSize())
+		{
+			return false;
+		}
+
+		std::vector<uint8_t> buffer(FileWriter::kDefaultBufferSize);
+		std::vector<uint8_t> otherBuffer(FileWriter::kDefaultBufferSize);
+		uint32_t remaining = file->getSize();
+
+		while (remaining > 0)
+		{
+			const uint32_t size = std::min(remaining, (uint32_t)buffer.size());
+			uint32_t readSize{ 0 };
+			uint32_t otherReadSize{ 0 };
+
+			if (!file->read(buffer.data(), size, &readSize) || !otherFile->read(otherBuffer.data(), size, &otherReadSize) ||
+				readSize != size || otherReadSize != size)
+			{
+				LogError("File::read() failed for: %s!!", fileName.c_str());
+				return false;
+			}
+
+			if (std::memcmp(buffer.data(), otherBuffer.data(), size) != 0)
+			{
+				return false;
+			}
+
+			remaining -= size;
+		}
+
+		return true;
+	}
+
 	std::string Resource::getReadPath(const std::string& basePath, const std::string& fileName)
 	{
 		if (fileName.starts_with("/Assets/Framework"))
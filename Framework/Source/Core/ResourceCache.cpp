@@ -1,32 +1,31 @@
 #include "Core/ResourceCache.h"
 #include "Core/Resource.h"
+#include "Core/PreloadManifest.h"
+#include "Core/Logger.h"
+#include "VFS/FileSystem.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
 
 namespace Trinity
 {
 	bool ResourceCache::hasResource(const std::type_index& type) const
 	{
-		auto it = mResources.find(type);
-		return (it != mResources.end() && !it->second.empty());
+		auto* storage = getStorage(getTypeId(type));
+		return storage != nullptr && !storage->resources.empty();
 	}
 
 	bool ResourceCache::isLoaded(const std::type_index& type, const std::string& fileName) const
 	{
-		auto it = mFileResourceMap.find(type);
-		if (it != mFileResourceMap.end())
-		{
-			auto it2 = it->second.find(fileName);
-			return it2 != it->second.end();
-		}
-
-		return false;
+		return getResource(type, fileName) != nullptr;
 	}
 
 	Resource* ResourceCache::getResource(const std::type_index& type, uint32_t id) const
 	{
-		const auto& resources = mResources.at(type);
-		if (id < (uint32_t)resources.size())
+		auto* storage = getStorage(getTypeId(type));
+		if (storage != nullptr && id < (uint32_t)storage->resources.size())
 		{
-			return resources[id].get();
+			return storage->resources[id].get();
 		}
 
 		return nullptr;
@@ -34,13 +33,13 @@ namespace Trinity
 
 	Resource* ResourceCache::getResource(const std::type_index& type, const std::string& fileName) const
 	{
-		auto it = mFileResourceMap.find(type);
-		if (it != mFileResourceMap.end())
+		auto* storage = getStorage(getTypeId(type));
+		if (storage != nullptr)
 		{
-			auto it2 = it->second.find(fileName);
-			if (it2 != it->second.end())
+			auto it = storage->pathSlots.find(getPathId(fileName));
+			if (it != storage->pathSlots.end())
 			{
-				return it2->second;
+				return storage->resources[storage->slots[it->second].index].get();
 			}
 		}
 
@@ -49,28 +48,595 @@ namespace Trinity
 
 	const std::vector<std::unique_ptr<Resource>>& ResourceCache::getResources(const std::type_index& type) const
 	{
-		return mResources.at(type);
+		static const std::vector<std::unique_ptr<Resource>> empty;
+
+		auto* storage = getStorage(getTypeId(type));
+		return storage != nullptr ? storage->resources : empty;
 	}
 
-	void ResourceCache::addResource(std::unique_ptr<Resource> resource)
+	PathId ResourceCache::getPathId(std::string_view fileName) const
 	{
-		if (!resource->getFileName().empty())
+		auto it = mPathIds.find(fileName);
+		return it != mPathIds.end() ? it->second : kInvalidPathId;
+	}
+
+	PathId ResourceCache::internPath(std::string_view fileName)
+	{
+		auto it = mPathIds.find(fileName);
+		if (it != mPathIds.end())
+		{
+			return it->second;
+		}
+
+		const auto pathId = (PathId)mPaths.size();
+		mPaths.emplace_back(fileName);
+		mPathIds.insert(std::make_pair(mPaths.back(), pathId));
+
+		return pathId;
+	}
+
+	const std::string& ResourceCache::getPath(PathId pathId) const
+	{
+		static const std::string empty;
+		return pathId < (PathId)mPaths.size() ? mPaths[pathId] : empty;
+	}
+
+	bool ResourceCache::isLoading() const
+	{
+		return mLoader != nullptr && mLoader->isLoading();
+	}
+
+	std::shared_ptr<ResourceLoadHandle> ResourceCache::loadAsync(const std::string& fileName, const ResourceCreator& creator)
+	{
+		if (!mLoader)
+		{
+#ifdef __EMSCRIPTEN__
+			const uint32_t numThreads = 0;
+#else
+			const uint32_t numThreads = std::max(2u, std::thread::hardware_concurrency()) - 1;
+#endif
+			mLoader = std::make_unique<ResourceLoader>();
+			if (!mLoader->create(numThreads))
+			{
+				LogError("ResourceLoader::create() failed!!");
+				mLoader = nullptr;
+				return nullptr;
+			}
+		}
+
+		return mLoader->load(fileName, creator, *this);
+	}
+
+	void ResourceCache::update()
+	{
+		if (mLoader != nullptr)
+		{
+			mLoader->update(*this);
+		}
+
+		if (!mPreloadedFiles.empty())
+		{
+			auto& fileSystem = FileSystem::get();
+			for (const auto& fileName : mPreloadedFiles)
+			{
+				fileSystem.removeMemoryFile(fileName);
+			}
+
+			mPreloadedFiles.clear();
+		}
+
+		mFrameIndex++;
+
+		// walking every resource is only worth it when something reads the usage
+		if (mMemoryBudget > 0 || mUsageTracking)
 		{
-			auto& resources = mFileResourceMap[resource->getType()];
-			resources.insert(std::make_pair(resource->getFileName(), resource.get()));
+			const auto memoryUsage = trackUsage();
+			if (mMemoryBudget > 0 && memoryUsage > mMemoryBudget)
+			{
+				evict(memoryUsage);
+			}
 		}
+	}
 
-		auto& resources = mResources[resource->getType()];
-		resources.push_back(std::move(resource));
+	void ResourceCache::addResource(std::unique_ptr<Resource> resource)
+	{
+		insertResource(getOrCreateStorage(getTypeId(resource->getType())), std::move(resource));
 	}
 
 	void ResourceCache::setResources(const std::type_index& type, std::vector<std::unique_ptr<Resource>> resources)
 	{
-		mResources[type] = std::move(resources);
+		auto& storage = getOrCreateStorage(getTypeId(type));
+		resetStorage(storage);
+
+		for (auto& resource : resources)
+		{
+			insertResource(storage, std::move(resource));
+		}
 	}
 
 	void ResourceCache::clear()
 	{
-		mResources.clear();
+		for (auto& storage : mStorages)
+		{
+			if (storage != nullptr)
+			{
+				resetStorage(*storage);
+			}
+		}
+	}
+
+	bool ResourceCache::unload(const std::type_index& type, const std::string& fileName)
+	{
+		const auto typeId = getTypeId(type);
+
+		auto* storage = getStorage(typeId);
+		if (storage == nullptr)
+		{
+			return false;
+		}
+
+		auto it = storage->pathSlots.find(getPathId(fileName));
+		if (it == storage->pathSlots.end())
+		{
+			return false;
+		}
+
+		return unloadSlot(typeId, it->second);
+	}
+
+	uint32_t ResourceCache::unloadUnused(uint64_t minUnusedFrames)
+	{
+		if (minUnusedFrames > 0 && mMemoryBudget == 0 && !mUsageTracking)
+		{
+			LogWarning("ResourceCache::unloadUnused() needs usage tracking to count unused frames!!");
+		}
+
+		uint32_t numUnloaded{ 0 };
+		std::vector<uint32_t> slots;
+
+		while (true)
+		{
+			uint32_t numRemoved{ 0 };
+
+			for (auto& storage : mStorages)
+			{
+				if (storage == nullptr)
+				{
+					continue;
+				}
+
+				slots.clear();
+				for (uint32_t idx = 0; idx < (uint32_t)storage->resources.size(); idx++)
+				{
+					const auto& resource = storage->resources[idx];
+					const auto& slot = storage->slots[storage->indices[idx]];
+
+					if (resource->wasReferenced() && !resource->isReferenced() && !resource->getFileName().empty() &&
+						mFrameIndex - slot.lastUsed >= minUnusedFrames)
+					{
+						slots.push_back(storage->indices[idx]);
+					}
+				}
+
+				for (auto slotIndex : slots)
+				{
+					removeResource(*storage, slotIndex);
+				}
+
+				numRemoved += (uint32_t)slots.size();
+			}
+
+			if (numRemoved == 0)
+			{
+				break;
+			}
+
+			numUnloaded += numRemoved + unloadOrphans();
+		}
+
+		return numUnloaded;
+	}
+
+	void ResourceCache::setMemoryBudget(uint64_t memoryBudget)
+	{
+		mMemoryBudget = memoryBudget;
+	}
+
+	void ResourceCache::setUsageTracking(bool enabled)
+	{
+		mUsageTracking = enabled;
+	}
+
+	ResourceStats ResourceCache::getStats(const std::type_index& type) const
+	{
+		ResourceStats stats{};
+
+		if (auto* storage = getStorage(getTypeId(type)); storage != nullptr)
+		{
+			for (const auto& resource : storage->resources)
+			{
+				stats.numResources++;
+				stats.numReferenced += resource->isReferenced() ? 1 : 0;
+				stats.cpuMemory += resource->getCpuMemorySize();
+				stats.gpuMemory += resource->getGpuMemorySize();
+			}
+		}
+
+		return stats;
+	}
+
+	ResourceStats ResourceCache::getStats() const
+	{
+		ResourceStats stats{};
+
+		for (const auto& storage : mStorages)
+		{
+			if (storage == nullptr)
+			{
+				continue;
+			}
+
+			for (const auto& resource : storage->resources)
+			{
+				stats.numResources++;
+				stats.numReferenced += resource->isReferenced() ? 1 : 0;
+				stats.cpuMemory += resource->getCpuMemorySize();
+				stats.gpuMemory += resource->getGpuMemorySize();
+			}
+		}
+
+		return stats;
+	}
+
+	bool ResourceCache::preload(const PreloadManifest& manifest)
+	{
+		const auto& entries = manifest.getEntries();
+		const auto startTime = std::chrono::steady_clock::now();
+
+#ifdef __EMSCRIPTEN__
+		const uint32_t numThreads = 1;
+#else
+		const uint32_t numThreads = std::min((uint32_t)entries.size(), std::max(1u, std::thread::hardware_concurrency()));
+#endif
+
+		auto& fileSystem = FileSystem::get();
+		std::atomic<uint32_t> nextEntry{ 0 };
+		std::atomic<uint32_t> numFailed{ 0 };
+
+		auto readEntries = [&]() {
+			for (uint32_t idx = nextEntry++; idx < (uint32_t)entries.size(); idx = nextEntry++)
+			{
+				const auto& entry = entries[idx];
+
+				auto file = fileSystem.openFile(entry.fileName, FileOpenMode::OpenRead);
+				if (!file)
+				{
+					numFailed++;
+					continue;
+				}
+
+				std::vector<uint8_t> data(file->getSize());
+				if (!file->read(data.data(), (uint32_t)data.size()))
+				{
+					numFailed++;
+					continue;
+				}
+
+				fileSystem.addMemoryFile(entry.fileName, std::move(data));
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for (uint32_t idx = 1; idx < numThreads; idx++)
+		{
+			threads.emplace_back(readEntries);
+		}
+
+		readEntries();
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		for (const auto& entry : entries)
+		{
+			mPreloadedFiles.push_back(entry.fileName);
+		}
+
+		const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime);
+		LogInfo("Preloaded %d files (%llu bytes) from '%s' in %.2f ms", (uint32_t)entries.size(),
+			(unsigned long long)manifest.getTotalSize(), manifest.getFileName().c_str(), elapsed.count());
+
+		if (numFailed > 0)
+		{
+			LogWarning("Failed to preload %d files from '%s'", numFailed.load(), manifest.getFileName().c_str());
+		}
+
+		return numFailed == 0;
+	}
+
+	void ResourceCache::visitResources(const std::function<void(const Resource&)>& visitor) const
+	{
+		for (const auto& storage : mStorages)
+		{
+			if (storage != nullptr)
+			{
+				for (const auto& resource : storage->resources)
+				{
+					visitor(*resource);
+				}
+			}
+		}
+	}
+
+	uint32_t ResourceCache::getTypeId(const std::type_index& type)
+	{
+		static std::mutex mutex;
+		static std::unordered_map<std::type_index, uint32_t> typeIds;
+
+		std::lock_guard<std::mutex> lock(mutex);
+
+		auto it = typeIds.find(type);
+		if (it != typeIds.end())
+		{
+			return it->second;
+		}
+
+		const auto typeId = (uint32_t)typeIds.size();
+		typeIds.insert(std::make_pair(type, typeId));
+
+		return typeId;
+	}
+
+	ResourceCache::ResourceStorage& ResourceCache::getOrCreateStorage(uint32_t typeId)
+	{
+		if (typeId >= (uint32_t)mStorages.size())
+		{
+			mStorages.resize(typeId + 1);
+		}
+
+		auto& storage = mStorages[typeId];
+		if (!storage)
+		{
+			storage = std::make_unique<ResourceStorage>();
+		}
+
+		return *storage;
+	}
+
+	void ResourceCache::insertResource(ResourceStorage& storage, std::unique_ptr<Resource> resource)
+	{
+		uint32_t slotIndex{ 0 };
+		if (!storage.freeSlots.empty())
+		{
+			slotIndex = storage.freeSlots.back();
+			storage.freeSlots.pop_back();
+		}
+		else
+		{
+			slotIndex = (uint32_t)storage.slots.size();
+			storage.slots.push_back({});
+		}
+
+		storage.slots[slotIndex].index = (uint32_t)storage.resources.size();
+		storage.slots[slotIndex].lastUsed = mFrameIndex;
+		storage.indices.push_back(slotIndex);
+
+		if (!resource->getFileName().empty())
+		{
+			storage.pathSlots.insert(std::make_pair(internPath(resource->getFileName()), slotIndex));
+		}
+
+		storage.resources.push_back(std::move(resource));
+	}
+
+	void ResourceCache::resetStorage(ResourceStorage& storage)
+	{
+		for (auto slotIndex : storage.indices)
+		{
+			storage.slots[slotIndex].generation++;
+			storage.freeSlots.push_back(slotIndex);
+		}
+
+		storage.resources.clear();
+		storage.indices.clear();
+		storage.pathSlots.clear();
+	}
+
+	void ResourceCache::removeResource(ResourceStorage& storage, uint32_t slotIndex)
+	{
+		auto& slot = storage.slots[slotIndex];
+		const auto index = slot.index;
+		const auto lastIndex = (uint32_t)storage.resources.size() - 1;
+
+		auto resource = std::move(storage.resources[index]);
+		if (!resource->getFileName().empty())
+		{
+			auto it = storage.pathSlots.find(getPathId(resource->getFileName()));
+			if (it != storage.pathSlots.end() && it->second == slotIndex)
+			{
+				storage.pathSlots.erase(it);
+			}
+		}
+
+		if (index != lastIndex)
+		{
+			storage.resources[index] = std::move(storage.resources[lastIndex]);
+			storage.indices[index] = storage.indices[lastIndex];
+			storage.slots[storage.indices[index]].index = index;
+		}
+
+		storage.resources.pop_back();
+		storage.indices.pop_back();
+
+		slot.generation++;
+		storage.freeSlots.push_back(slotIndex);
+
+		// ~Resource() only reaches Resource::destroy(), the derived destroy() is what releases the
+		// resources this one references so unloadOrphans() and evict() can see them go unused
+		resource->destroy();
+	}
+
+	bool ResourceCache::unloadSlot(uint32_t typeId, uint32_t slotIndex)
+	{
+		auto* storage = getStorage(typeId);
+		auto* resource = storage->resources[storage->slots[slotIndex].index].get();
+
+		if (resource->isReferenced())
+		{
+			LogWarning("Resource '%s' is still referenced (%d), not unloading!!", resource->getFileName().c_str(),
+				resource->getRefCount());
+			return false;
+		}
+
+		removeResource(*storage, slotIndex);
+		unloadOrphans();
+
+		return true;
+	}
+
+	uint32_t ResourceCache::unloadOrphans()
+	{
+		uint32_t numUnloaded{ 0 };
+		std::vector<uint32_t> slots;
+
+		while (true)
+		{
+			uint32_t numRemoved{ 0 };
+
+			for (auto& storage : mStorages)
+			{
+				if (storage == nullptr)
+				{
+					continue;
+				}
+
+				slots.clear();
+				for (uint32_t idx = 0; idx < (uint32_t)storage->resources.size(); idx++)
+				{
+					const auto& resource = storage->resources[idx];
+					if (resource->wasReferenced() && !resource->isReferenced() && resource->getFileName().empty())
+					{
+						slots.push_back(storage->indices[idx]);
+					}
+				}
+
+				for (auto slotIndex : slots)
+				{
+					removeResource(*storage, slotIndex);
+				}
+
+				numRemoved += (uint32_t)slots.size();
+			}
+
+			if (numRemoved == 0)
+			{
+				break;
+			}
+
+			numUnloaded += numRemoved;
+		}
+
+		return numUnloaded;
+	}
+
+	uint64_t ResourceCache::trackUsage()
+	{
+		uint64_t memoryUsage{ 0 };
+
+		for (auto& storage : mStorages)
+		{
+			if (storage == nullptr)
+			{
+				continue;
+			}
+
+			for (uint32_t idx = 0; idx < (uint32_t)storage->resources.size(); idx++)
+			{
+				const auto& resource = storage->resources[idx];
+				if (resource->isReferenced())
+				{
+					storage->slots[storage->indices[idx]].lastUsed = mFrameIndex;
+				}
+
+				if (mMemoryBudget > 0)
+				{
+					memoryUsage += resource->getCpuMemorySize() + resource->getGpuMemorySize();
+				}
+			}
+		}
+
+		return memoryUsage;
+	}
+
+	void ResourceCache::evict(uint64_t memoryUsage)
+	{
+		struct Candidate
+		{
+			uint32_t typeId{ 0 };
+			uint32_t slotIndex{ 0 };
+			uint32_t priority{ 0 };
+			uint64_t lastUsed{ 0 };
+			uint64_t size{ 0 };
+		};
+
+		std::vector<Candidate> candidates;
+
+		while (memoryUsage > mMemoryBudget)
+		{
+			candidates.clear();
+
+			for (uint32_t typeId = 0; typeId < (uint32_t)mStorages.size(); typeId++)
+			{
+				auto* storage = mStorages[typeId].get();
+				if (storage == nullptr)
+				{
+					continue;
+				}
+
+				for (uint32_t idx = 0; idx < (uint32_t)storage->resources.size(); idx++)
+				{
+					const auto& resource = storage->resources[idx];
+					if (resource->wasReferenced() && !resource->isReferenced() && !resource->getFileName().empty())
+					{
+						const auto slotIndex = storage->indices[idx];
+						candidates.push_back({
+							.typeId = typeId,
+							.slotIndex = slotIndex,
+							.priority = resource->getEvictionPriority(),
+							.lastUsed = storage->slots[slotIndex].lastUsed,
+							.size = resource->getCpuMemorySize() + resource->getGpuMemorySize()
+						});
+					}
+				}
+			}
+
+			if (candidates.empty())
+			{
+				LogWarning("ResourceCache is over budget (%llu > %llu) with nothing left to evict!!",
+					(unsigned long long)memoryUsage, (unsigned long long)mMemoryBudget);
+				break;
+			}
+
+			std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+				return a.priority != b.priority ? a.priority < b.priority : a.lastUsed < b.lastUsed;
+			});
+
+			for (const auto& candidate : candidates)
+			{
+				if (memoryUsage <= mMemoryBudget)
+				{
+					break;
+				}
+
+				removeResource(*mStorages[candidate.typeId], candidate.slotIndex);
+				memoryUsage -= std::min(memoryUsage, candidate.size);
+				mNumEvicted++;
+			}
+
+			unloadOrphans();
+			memoryUsage = trackUsage();
+		}
 	}
 }
\ No newline at end of file
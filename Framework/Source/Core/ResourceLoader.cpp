@@ -0,0 +1,363 @@
+#include "Core/ResourceLoader.h"
+#include "Core/ResourceCache.h"
+#include "Core/Logger.h"
+#include "VFS/FileSystem.h"
+#include "VFS/MemoryFile.h"
+#include <algorithm>
+
+namespace Trinity
+{
+	ResourceLoader::~ResourceLoader()
+	{
+		destroy();
+	}
+
+	bool ResourceLoader::create(uint32_t numThreads)
+	{
+		mExit = false;
+
+		for (uint32_t idx = 0; idx < numThreads; idx++)
+		{
+			mThreads.emplace_back([this]() {
+				execute();
+			});
+		}
+
+		return true;
+	}
+
+	void ResourceLoader::destroy()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mJobsMutex);
+			mExit = true;
+			mJobs.clear();
+		}
+
+		mJobsCondition.notify_all();
+
+		for (auto& thread : mThreads)
+		{
+			if (thread.joinable())
+			{
+				thread.join();
+			}
+		}
+
+		for (auto& it : mNodes)
+		{
+			for (auto& it2 : it.second)
+			{
+				for (auto& root : it2.second->roots)
+				{
+					root->mState = ResourceLoadState::Failed;
+					root->mPromise.set_value(nullptr);
+				}
+			}
+		}
+
+		mThreads.clear();
+		mCompleted.clear();
+		mReady.clear();
+		mNodes.clear();
+	}
+
+	std::shared_ptr<ResourceLoadHandle> ResourceLoader::load(const std::string& fileName, 
+		const ResourceCreator& creator, ResourceCache& cache)
+	{
+		auto handle = std::make_shared<ResourceLoadHandle>();
+
+		auto* node = addNode(fileName, creator, true, { handle }, cache);
+		if (!node)
+		{
+			auto* resource = cache.getResource(creator()->getType(), fileName);
+
+			handle->mState = ResourceLoadState::Loaded;
+			handle->mResource = resource;
+			handle->mPromise.set_value(resource);
+
+			return handle;
+		}
+
+		node->roots.push_back(handle);
+		return handle;
+	}
+
+	void ResourceLoader::update(ResourceCache& cache)
+	{
+		if (mThreads.empty())
+		{
+			std::deque<LoadNode*> jobs;
+			jobs.swap(mJobs);
+
+			for (auto* node : jobs)
+			{
+				prefetch(*node);
+				mCompleted.push_back(node);
+			}
+		}
+
+		std::vector<LoadNode*> completed;
+		{
+			std::lock_guard<std::mutex> lock(mCompletedMutex);
+			completed.swap(mCompleted);
+		}
+
+		for (auto* node : completed)
+		{
+			node->prefetched = true;
+
+			for (auto& dependency : node->dependencies)
+			{
+				auto* child = addNode(dependency.fileName, dependency.creator, dependency.createResource, 
+					node->handles, cache);
+
+				if (child != nullptr && child != node)
+				{
+					child->parents.push_back(node);
+					node->children.push_back(child);
+					node->numPending++;
+				}
+			}
+
+			node->dependencies.clear();
+
+			if (node->numPending == 0)
+			{
+				mReady.push_back(node);
+			}
+		}
+
+		while (!mReady.empty())
+		{
+			auto* node = mReady.front();
+			mReady.pop_front();
+
+			finalize(*node, cache);
+		}
+	}
+
+	ResourceLoader::LoadNode* ResourceLoader::addNode(const std::string& fileName, const ResourceCreator& creator, 
+		bool createResource, const std::vector<std::shared_ptr<ResourceLoadHandle>>& handles, ResourceCache& cache)
+	{
+		auto resource = creator();
+		const auto type = resource->getType();
+
+		if (cache.isLoaded(type, fileName))
+		{
+			return nullptr;
+		}
+
+		auto& nodes = mNodes[type];
+		auto it = nodes.find(fileName);
+
+		if (it != nodes.end())
+		{
+			it->second->createResource |= createResource;
+
+			for (const auto& handle : handles)
+			{
+				addHandle(*it->second, handle);
+			}
+
+			return it->second.get();
+		}
+
+		auto node = std::make_unique<LoadNode>();
+		node->fileName = fileName;
+		node->type = type;
+		node->resource = std::move(resource);
+		node->createResource = createResource;
+
+		for (const auto& handle : handles)
+		{
+			addHandle(*node, handle);
+		}
+
+		auto* result = node.get();
+		nodes.insert(std::make_pair(fileName, std::move(node)));
+
+		{
+			std::lock_guard<std::mutex> lock(mJobsMutex);
+			mJobs.push_back(result);
+		}
+
+		mJobsCondition.notify_one();
+		return result;
+	}
+
+	void ResourceLoader::addHandle(LoadNode& node, const std::shared_ptr<ResourceLoadHandle>& handle)
+	{
+		if (std::find(node.handles.begin(), node.handles.end(), handle) != node.handles.end())
+		{
+			return;
+		}
+
+		// a shared node counts towards every load waiting on it, along with the part of its subtree still in flight
+		node.handles.push_back(handle);
+		handle->mNumTotal++;
+
+		for (auto* child : node.children)
+		{
+			addHandle(*child, handle);
+		}
+	}
+
+	void ResourceLoader::prefetch(LoadNode& node)
+	{
+		auto file = FileSystem::get().openFile(node.fileName, FileOpenMode::OpenRead);
+		if (!file)
+		{
+			LogError("Error opening resource file: %s", node.fileName.c_str());
+			node.failed = true;
+			return;
+		}
+
+		std::vector<uint8_t> data(file->getSize());
+		if (!file->read(data.data(), file->getSize()))
+		{
+			LogError("File::read() failed for: %s!!", node.fileName.c_str());
+			node.failed = true;
+			return;
+		}
+
+		file.reset();
+
+		MemoryFile memoryFile;
+		memoryFile.create(node.fileName, std::move(data));
+
+		if (node.resource->canReadAsync())
+		{
+			ResourceCache cache;
+			if (!node.resource->readFile(memoryFile, cache))
+			{
+				LogError("Resource::readFile() failed for: %s!!", node.fileName.c_str());
+				node.failed = true;
+				return;
+			}
+
+			node.readAsync = true;
+			return;
+		}
+
+		FileReader reader(memoryFile);
+		if (!node.resource->getDependencies(reader, node.dependencies))
+		{
+			LogError("Resource::getDependencies() failed for: %s!!", node.fileName.c_str());
+			node.failed = true;
+			return;
+		}
+
+		node.data = memoryFile.release();
+	}
+
+	void ResourceLoader::finalize(LoadNode& node, ResourceCache& cache)
+	{
+		auto& fileSystem = FileSystem::get();
+		Resource* resource{ nullptr };
+
+		if (!node.failed)
+		{
+			if (cache.isLoaded(node.type, node.fileName))
+			{
+				resource = cache.getResource(node.type, node.fileName);
+			}
+			else if (node.readAsync)
+			{
+				resource = node.resource.get();
+				cache.addResource(std::move(node.resource));
+			}
+			else
+			{
+				fileSystem.addMemoryFile(node.fileName, std::move(node.data));
+
+				if (node.createResource)
+				{
+					if (node.resource->create(node.fileName, cache))
+					{
+						resource = node.resource.get();
+						cache.addResource(std::move(node.resource));
+					}
+					else
+					{
+						LogError("Resource::create() failed for: %s!!", node.fileName.c_str());
+					}
+
+					fileSystem.removeMemoryFile(node.fileName);
+				}
+				else
+				{
+					// the first handle owns the subtree the file was requested from
+					node.handles.front()->mMemoryFiles.push_back(node.fileName);
+				}
+			}
+		}
+
+		for (auto& handle : node.handles)
+		{
+			handle->mNumLoaded++;
+		}
+
+		for (auto* parent : node.parents)
+		{
+			std::erase(parent->children, &node);
+
+			if (--parent->numPending == 0 && parent->prefetched)
+			{
+				mReady.push_back(parent);
+			}
+		}
+
+		for (auto& root : node.roots)
+		{
+			for (auto& memoryFile : root->mMemoryFiles)
+			{
+				fileSystem.removeMemoryFile(memoryFile);
+			}
+
+			root->mMemoryFiles.clear();
+			root->mResource = resource;
+			root->mState = resource != nullptr ? ResourceLoadState::Loaded : ResourceLoadState::Failed;
+			root->mPromise.set_value(resource);
+		}
+
+		const auto type = node.type;
+		const auto fileName = node.fileName;
+
+		// isLoading() checks for an empty map, so types without pending nodes can't be left behind
+		auto it = mNodes.find(type);
+		it->second.erase(fileName);
+
+		if (it->second.empty())
+		{
+			mNodes.erase(it);
+		}
+	}
+
+	void ResourceLoader::execute()
+	{
+		while (true)
+		{
+			LoadNode* node{ nullptr };
+			{
+				std::unique_lock<std::mutex> lock(mJobsMutex);
+				mJobsCondition.wait(lock, [this]() {
+					return mExit || !mJobs.empty();
+				});
+
+				if (mExit)
+				{
+					return;
+				}
+
+				node = mJobs.front();
+				mJobs.pop_front();
+			}
+
+			prefetch(*node);
+
+			std::lock_guard<std::mutex> lock(mCompletedMutex);
+			mCompleted.push_back(node);
+		}
+	}
+}
@@ -43,6 +43,10 @@ namespace Trinity
                     {
                         entry.textureView = resource.texture.getView();
                     }
+                    else if constexpr (std::is_same_v<T, TextureViewBindingResource>)
+                    {
+                        entry.textureView = resource.view;
+                    }
                     else if constexpr (std::is_same_v<T, SamplerBindingResource>)
                     {
                         entry.sampler = resource.sampler.getHandle();
@@ -46,6 +46,14 @@ namespace Trinity
                         .type = bindingLayout.type
                     };
                 }
+                else if constexpr (std::is_same_v<T, StorageTextureBindingLayout>)
+                {
+                    entry.storageTexture = {
+                        .access = bindingLayout.access,
+                        .format = bindingLayout.format,
+                        .viewDimension = bindingLayout.viewDimension
+                    };
+                }
                 }, item.bindingLayout);
 
             entries.push_back(std::move(entry));
@@ -63,12 +71,14 @@ namespace Trinity
             return false;
         }
 
+        mItems = items;
         return true;
     }
 
     void BindGroupLayout::destroy()
     {
         mHandle = 0;
+        mItems.clear();
     }
 
     bool BindGroupLayout::isValid() const
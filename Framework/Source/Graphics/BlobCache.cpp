@@ -0,0 +1,181 @@
+#include "Graphics/BlobCache.h"
+#include "VFS/FileSystem.h"
+#include "Core/Logger.h"
+#include "Utils/HashHelper.h"
+#include <cstring>
+
+namespace Trinity
+{
+    BlobCache::~BlobCache()
+    {
+        destroy();
+    }
+
+    bool BlobCache::create(const std::string& path)
+    {
+        std::error_code error;
+        if (!fs::exists(path) && !fs::create_directories(path, error))
+        {
+            LogError("fs::create_directories() failed for: %s!!", path.c_str());
+            return false;
+        }
+
+        if (!FileSystem::get().addFolder(kCacheAlias, path))
+        {
+            LogError("FileSystem::addFolder() failed for: %s!!", path.c_str());
+            return false;
+        }
+
+        mPath = path;
+        return true;
+    }
+
+    void BlobCache::destroy()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mPending.clear();
+        mNumHits = 0;
+        mNumMisses = 0;
+        mNumStored = 0;
+    }
+
+    size_t BlobCache::load(const void* key, size_t keySize, void* value, size_t valueSize)
+    {
+        if (mPath.empty())
+        {
+            return 0;
+        }
+
+        const std::string fileName = getFileName(key, keySize);
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        // dawn asks for the size first and then again with a buffer of that size,
+        // the blob is kept around in between so the file is only read once
+        auto it = mPending.find(fileName);
+        if (it == mPending.end())
+        {
+            std::vector<uint8_t> blob;
+            if (!readBlob(fileName, key, keySize, blob))
+            {
+                mNumMisses++;
+                return 0;
+            }
+
+            it = mPending.insert(std::make_pair(fileName, std::move(blob))).first;
+        }
+
+        const size_t blobSize = it->second.size();
+        if (value == nullptr || valueSize < blobSize)
+        {
+            return blobSize;
+        }
+
+        std::memcpy(value, it->second.data(), blobSize);
+        mPending.erase(it);
+        mNumHits++;
+
+        return blobSize;
+    }
+
+    void BlobCache::store(const void* key, size_t keySize, const void* value, size_t valueSize)
+    {
+        if (mPath.empty())
+        {
+            return;
+        }
+
+        auto& fileSystem = FileSystem::get();
+        const std::string fileName = getFileName(key, keySize);
+        const std::string tempFileName = fileName + ".tmp";
+
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        {
+            auto file = fileSystem.openFile(tempFileName, FileOpenMode::OpenWrite);
+            if (!file)
+            {
+                LogWarning("FileSystem::openFile() failed for: %s", tempFileName.c_str());
+                return;
+            }
+
+            // the full key goes in front of the blob so a hash collision reads as a miss
+            FileWriter writer(*file);
+            const uint32_t storedKeySize = (uint32_t)keySize;
+
+            writer.write(&storedKeySize);
+            writer.write((const uint8_t*)key, storedKeySize);
+            writer.write((const uint8_t*)value, (uint32_t)valueSize);
+        }
+
+        if (!fileSystem.moveFile(tempFileName, fileName))
+        {
+            LogWarning("FileSystem::moveFile() failed for: %s", fileName.c_str());
+            fileSystem.removeFile(tempFileName);
+            return;
+        }
+
+        mNumStored++;
+    }
+
+    size_t BlobCache::loadData(const void* key, size_t keySize, void* value, size_t valueSize, void* userData)
+    {
+        return reinterpret_cast<BlobCache*>(userData)->load(key, keySize, value, valueSize);
+    }
+
+    void BlobCache::storeData(const void* key, size_t keySize, const void* value, size_t valueSize, void* userData)
+    {
+        reinterpret_cast<BlobCache*>(userData)->store(key, keySize, value, valueSize);
+    }
+
+    std::string BlobCache::getFileName(const void* key, size_t keySize) const
+    {
+        std::string fileName = kCacheAlias;
+        fileName.append("/");
+        fileName.append(HashHelper::toString(HashHelper::hash(key, keySize)));
+        fileName.append(kBlobExtension);
+
+        return fileName;
+    }
+
+    bool BlobCache::readBlob(const std::string& fileName, const void* key, size_t keySize,
+        std::vector<uint8_t>& value) const
+    {
+        auto& fileSystem = FileSystem::get();
+        if (!fileSystem.isExist(fileName))
+        {
+            return false;
+        }
+
+        auto file = fileSystem.openFile(fileName, FileOpenMode::OpenRead);
+        if (!file)
+        {
+            return false;
+        }
+
+        FileReader reader(*file);
+        uint32_t storedKeySize{ 0 };
+        reader.read(&storedKeySize);
+
+        if (storedKeySize != keySize || reader.getSize() < sizeof(uint32_t) + storedKeySize)
+        {
+            return false;
+        }
+
+        std::vector<uint8_t> storedKey(storedKeySize);
+        reader.read(storedKey.data(), storedKeySize);
+
+        if (std::memcmp(storedKey.data(), key, keySize) != 0)
+        {
+            return false;
+        }
+
+        value.resize(reader.getSize() - sizeof(uint32_t) - storedKeySize);
+        if (!value.empty())
+        {
+            reader.read(value.data(), (uint32_t)value.size());
+        }
+
+        return true;
+    }
+}
@@ -14,14 +14,30 @@ namespace Trinity
         return typeid(Buffer);
     }
 
-    void Buffer::mapAsync(uint32_t offset, uint32_t size)
+    uint64_t Buffer::getGpuMemorySize() const
     {
-        mHandle.MapAsync(wgpu::MapMode::Write, offset, size,
+        return mHandle ? mHandle.GetSize() : 0;
+    }
+
+    void Buffer::mapAsync(uint32_t offset, uint32_t size, wgpu::MapMode mode)
+    {
+        mMapMode = mode;
+        mHandle.MapAsync(mode, offset, size,
             [](WGPUBufferMapAsyncStatus status, void* userdata) {
+                // the buffer may be gone by now, nobody is waiting on the data anymore
+                if (status == WGPUBufferMapAsyncStatus_DestroyedBeforeCallback)
+                {
+                    return;
+                }
+
                 Assert(status == WGPUBufferMapAsyncStatus_Success, "wgpu::Buffer::MapAsync() failed!!");
 
+                // read mapped buffers only hand out a const range
                 Buffer* buffer = reinterpret_cast<Buffer*>(userdata);
-                buffer->onMapAsyncCompleted.notify(buffer->mHandle.GetMappedRange());
+                void* data = buffer->mMapMode == wgpu::MapMode::Read ?
+                    const_cast<void*>(buffer->mHandle.GetConstMappedRange()) : buffer->mHandle.GetMappedRange();
+
+                buffer->onMapAsyncCompleted.notify(data);
         }, this);
     }
 
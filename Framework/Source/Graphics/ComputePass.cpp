@@ -54,4 +54,29 @@ namespace Trinity
 		wgpu::CommandBuffer commands = mCommandEncoder.Finish();
 		graphicsDevice.getQueue().Submit(1, &commands);
 	}
+
+	void ComputePass::dispatch(uint32_t workgroupCountX, uint32_t workgroupCountY, uint32_t workgroupCountZ) const
+	{
+		Assert(mComputePassEncoder != nullptr, "ComputePass::begin() not called!!");
+		mComputePassEncoder.DispatchWorkgroups(workgroupCountX, workgroupCountY, workgroupCountZ);
+	}
+
+	void ComputePass::setBindGroup(uint32_t groupIndex, const BindGroup& bindGroup) const
+	{
+		Assert(mComputePassEncoder != nullptr, "ComputePass::begin() not called!!");
+		mComputePassEncoder.SetBindGroup(groupIndex, bindGroup.getHandle());
+	}
+
+	void ComputePass::setBindGroup(uint32_t groupIndex, const BindGroup& bindGroup, uint32_t dynamicOffsetCount,
+		const uint32_t* dynamicOffsets) const
+	{
+		Assert(mComputePassEncoder != nullptr, "ComputePass::begin() not called!!");
+		mComputePassEncoder.SetBindGroup(groupIndex, bindGroup.getHandle(), dynamicOffsetCount, dynamicOffsets);
+	}
+
+	void ComputePass::setPipeline(const ComputePipeline& pipeline) const
+	{
+		Assert(mComputePassEncoder != nullptr, "ComputePass::begin() not called!!");
+		mComputePassEncoder.SetPipeline(pipeline.getHandle());
+	}
 }
\ No newline at end of file
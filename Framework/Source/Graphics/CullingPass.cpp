@@ -0,0 +1,560 @@
+#include "Graphics/CullingPass.h"
+#include "Graphics/DepthPyramid.h"
+#include "Graphics/GraphicsDevice.h"
+#include "Graphics/Shader.h"
+#include "Graphics/BindGroupLayout.h"
+#include "Core/Debugger.h"
+#include "Core/Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace Trinity
+{
+    void CullingPass::destroy()
+    {
+        ComputePass::destroy();
+
+        mInstances.clear();
+        mPayloads.clear();
+        mDraws.clear();
+        mArgs.clear();
+        mPayloadSize = 0;
+        mDirtyBegin = 0;
+        mDirtyEnd = 0;
+
+        mBindGroup = nullptr;
+        mBindGroupLayout = nullptr;
+        mPipeline = nullptr;
+        mShader = nullptr;
+        mParamsBuffer = nullptr;
+        mInstanceBuffer = nullptr;
+        mPayloadBuffer = nullptr;
+        mFirstOutputBuffer = nullptr;
+        mArgsBuffer = nullptr;
+        mOutputBuffer = nullptr;
+
+        mDepthPyramid = nullptr;
+        mOcclusionBindGroup = nullptr;
+        mOcclusionBindGroupLayout = nullptr;
+        mOcclusionPipeline = nullptr;
+        mVisibilityBuffer = nullptr;
+        mStatsBuffer = nullptr;
+        mStatsReadbackBuffer = nullptr;
+        mStats = {};
+        mStatsPending = false;
+    }
+
+    std::type_index CullingPass::getType() const
+    {
+        return typeid(CullingPass);
+    }
+
+    bool CullingPass::create(uint32_t numInstances, uint32_t payloadSize, std::vector<DrawData>&& draws,
+        uint32_t outputSize, wgpu::BufferUsage outputUsage)
+    {
+        Assert(payloadSize > 0 && payloadSize % sizeof(glm::vec4) == 0, "payload size must be a multiple of 16!!");
+
+        mInstances.resize(numInstances);
+        mPayloads.resize(numInstances * payloadSize);
+        mArgs.clear();
+        mDraws = std::move(draws);
+        mPayloadSize = payloadSize;
+        mDirtyBegin = 0;
+        mDirtyEnd = numInstances;
+
+        std::vector<uint32_t> firstOutputs;
+        for (const auto& draw : mDraws)
+        {
+            firstOutputs.push_back(draw.firstOutput);
+            mArgs.push_back(draw.args);
+        }
+
+        // storage bindings can't be empty, so every buffer holds at least one element
+        const uint32_t numBufferInstances = std::max(numInstances, 1u);
+        const uint32_t numBufferDraws = std::max((uint32_t)mDraws.size(), 1u);
+
+        firstOutputs.resize(numBufferDraws);
+
+        mParamsBuffer = std::make_unique<UniformBuffer>();
+        if (!mParamsBuffer->create(sizeof(ParamsBufferData)))
+        {
+            LogError("UniformBuffer::create() failed!!");
+            return false;
+        }
+
+        mInstanceBuffer = std::make_unique<StorageBuffer>();
+        if (!mInstanceBuffer->create(numBufferInstances * sizeof(InstanceData)))
+        {
+            LogError("StorageBuffer::create() failed!!");
+            return false;
+        }
+
+        mPayloadBuffer = std::make_unique<StorageBuffer>();
+        if (!mPayloadBuffer->create(numBufferInstances * payloadSize))
+        {
+            LogError("StorageBuffer::create() failed!!");
+            return false;
+        }
+
+        mFirstOutputBuffer = std::make_unique<StorageBuffer>();
+        if (!mFirstOutputBuffer->create(numBufferDraws * sizeof(uint32_t), firstOutputs.data()))
+        {
+            LogError("StorageBuffer::create() failed!!");
+            return false;
+        }
+
+        mArgsBuffer = std::make_unique<StorageBuffer>();
+        if (!mArgsBuffer->create(numBufferDraws * sizeof(DrawIndexedIndirectArgs), nullptr, wgpu::BufferUsage::Indirect))
+        {
+            LogError("StorageBuffer::create() failed!!");
+            return false;
+        }
+
+        mOutputBuffer = std::make_unique<StorageBuffer>();
+        if (!mOutputBuffer->create(std::max(outputSize, payloadSize), nullptr, outputUsage))
+        {
+            LogError("StorageBuffer::create() failed!!");
+            return false;
+        }
+
+        if (!createPipeline())
+        {
+            LogError("CullingPass::createPipeline() failed!!");
+            return false;
+        }
+
+        // occlusion resources depend on the instances, setDepthPyramid() makes them again
+        mDepthPyramid = nullptr;
+        mVisibilityBuffer = nullptr;
+        mOcclusionBindGroup = nullptr;
+        mOcclusionBindGroupLayout = nullptr;
+        mOcclusionPipeline = nullptr;
+
+        return true;
+    }
+
+    void CullingPass::setInstance(uint32_t index, const InstanceData& instance)
+    {
+        mInstances[index] = instance;
+        mDirtyBegin = std::min(mDirtyBegin, index);
+        mDirtyEnd = std::max(mDirtyEnd, index + 1);
+    }
+
+    void CullingPass::setPayload(uint32_t index, const void* data)
+    {
+        std::memcpy(mPayloads.data() + index * mPayloadSize, data, mPayloadSize);
+        mDirtyBegin = std::min(mDirtyBegin, index);
+        mDirtyEnd = std::max(mDirtyEnd, index + 1);
+    }
+
+    bool CullingPass::setDepthPyramid(const DepthPyramid* depthPyramid)
+    {
+        mDepthPyramid = depthPyramid;
+        if (mDepthPyramid == nullptr)
+        {
+            mOcclusionBindGroup = nullptr;
+            return true;
+        }
+
+        if (!mVisibilityBuffer)
+        {
+            // everything counts as visible last frame, so the first frame draws early what's in the frustum
+            std::vector<uint32_t> visibility(std::max((uint32_t)mInstances.size(), 1u), 1);
+
+            mVisibilityBuffer = std::make_unique<StorageBuffer>();
+            if (!mVisibilityBuffer->create((uint32_t)visibility.size() * sizeof(uint32_t), visibility.data()))
+            {
+                LogError("StorageBuffer::create() failed!!");
+                return false;
+            }
+        }
+
+        if (!mStatsBuffer)
+        {
+            mStatsBuffer = std::make_unique<StorageBuffer>();
+            if (!mStatsBuffer->create(sizeof(Stats), nullptr, wgpu::BufferUsage::CopySrc))
+            {
+                LogError("StorageBuffer::create() failed!!");
+                return false;
+            }
+
+            mStatsReadbackBuffer = std::make_unique<ReadbackBuffer>();
+            if (!mStatsReadbackBuffer->create(sizeof(Stats)))
+            {
+                LogError("ReadbackBuffer::create() failed!!");
+                return false;
+            }
+
+            mStatsReadbackBuffer->onMapAsyncCompleted.subscribe([this](void* data) {
+                std::memcpy(&mStats, data, sizeof(Stats));
+                mStatsReadbackBuffer->unmap();
+                mStatsPending = false;
+            });
+        }
+
+        // the pyramid view changes whenever it's recreated, so the bind group follows it
+        if (!createOcclusionPipeline())
+        {
+            LogError("CullingPass::createOcclusionPipeline() failed!!");
+            return false;
+        }
+
+        return true;
+    }
+
+    bool CullingPass::cull(const Frustum& frustum)
+    {
+        return cull(frustum, glm::mat4(1.0f), CullingPhase::All);
+    }
+
+    bool CullingPass::cull(const Frustum& frustum, const glm::mat4& viewProj, CullingPhase phase)
+    {
+        if (mInstances.empty() || mDraws.empty())
+        {
+            return true;
+        }
+
+        Assert(phase == CullingPhase::All || isOcclusionEnabled(), "CullingPass::setDepthPyramid() not called!!");
+        upload();
+
+        ParamsBufferData params = {
+            .viewProj = viewProj,
+            .numInstances = (uint32_t)mInstances.size(),
+            .payloadSize = mPayloadSize / (uint32_t)sizeof(glm::vec4),
+            .phase = (uint32_t)phase
+        };
+
+        if (phase != CullingPhase::All)
+        {
+            params.numLevels = mDepthPyramid->getNumLevels();
+            params.pyramidWidth = mDepthPyramid->getWidth();
+            params.pyramidHeight = mDepthPyramid->getHeight();
+        }
+
+        std::copy(std::begin(frustum.planes), std::end(frustum.planes), std::begin(params.planes));
+        mParamsBuffer->write(0, sizeof(ParamsBufferData), &params);
+
+        // the shader only ever adds to the instance counts, so they start from the templates every frame,
+        // queue writes are ordered with submits so the early draws are done with them by the late phase
+        mArgsBuffer->write(0, (uint32_t)mArgs.size() * sizeof(DrawIndexedIndirectArgs), mArgs.data());
+
+        if (phase == CullingPhase::Early)
+        {
+            const Stats stats{};
+            mStatsBuffer->write(0, sizeof(Stats), &stats);
+        }
+
+        if (!begin())
+        {
+            LogError("ComputePass::begin() failed!!");
+            return false;
+        }
+
+        if (phase == CullingPhase::All)
+        {
+            setPipeline(*mPipeline);
+            setBindGroup(0, *mBindGroup);
+        }
+        else
+        {
+            setPipeline(*mOcclusionPipeline);
+            setBindGroup(0, *mOcclusionBindGroup);
+        }
+
+        dispatch((params.numInstances + kWorkgroupSize - 1) / kWorkgroupSize);
+        end();
+
+        const bool readback = phase == CullingPhase::Late && !mStatsPending;
+        if (readback)
+        {
+            mCommandEncoder.CopyBufferToBuffer(mStatsBuffer->getHandle(), 0,
+                mStatsReadbackBuffer->getHandle(), 0, sizeof(Stats));
+        }
+
+        submit();
+
+        if (readback)
+        {
+            mStatsPending = true;
+            mStatsReadbackBuffer->mapAsync(0, sizeof(Stats), wgpu::MapMode::Read);
+        }
+        else if (phase == CullingPhase::Late)
+        {
+            readStats();
+        }
+
+        return true;
+    }
+
+    void CullingPass::cullReference(const Frustum& frustum, std::vector<DrawIndexedIndirectArgs>& args,
+        std::vector<uint32_t>& outputs) const
+    {
+        cullReference(frustum, mInstances, mDraws, args, outputs);
+    }
+
+    void CullingPass::cullReference(const Frustum& frustum, const std::vector<InstanceData>& instances,
+        const std::vector<DrawData>& draws, std::vector<DrawIndexedIndirectArgs>& args, std::vector<uint32_t>& outputs)
+    {
+        // same work as the shader with payload indices in place of payloads, the order
+        // within a draw is the only thing allowed to differ from the gpu results
+        args.clear();
+        outputs.clear();
+
+        for (const auto& draw : draws)
+        {
+            args.push_back(draw.args);
+        }
+
+        for (const auto& instance : instances)
+        {
+            if (!isVisible(frustum, instance))
+            {
+                continue;
+            }
+
+            const uint32_t slot = args[instance.drawIndex].instanceCount++;
+            const uint32_t output = draws[instance.drawIndex].firstOutput + slot;
+
+            if (output >= outputs.size())
+            {
+                outputs.resize(output + 1, (uint32_t)-1);
+            }
+
+            outputs[output] = instance.payloadIndex;
+        }
+    }
+
+    bool CullingPass::isVisible(const Frustum& frustum, const InstanceData& instance)
+    {
+        for (uint32_t idx = 0; idx < 6; idx++)
+        {
+            const glm::vec3 normal{ frustum.planes[idx] };
+            const float distance = glm::dot(instance.center, normal) + frustum.planes[idx].w;
+            const float radius = glm::dot(instance.extents, glm::abs(normal));
+
+            if (distance + radius < 0.0f)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool CullingPass::createPipeline()
+    {
+        ShaderPreProcessor processor;
+        mShader = std::make_unique<Shader>();
+
+        if (!mShader->load(kDefaultShader, processor))
+        {
+            LogError("Shader::load() failed for: %s!!", kDefaultShader);
+            return false;
+        }
+
+        auto layoutItems = getLayoutItems();
+        auto items = getBindGroupItems();
+
+        mBindGroupLayout = std::make_unique<BindGroupLayout>();
+        if (!mBindGroupLayout->create(layoutItems))
+        {
+            LogError("BindGroupLayout::create() failed!!");
+            return false;
+        }
+
+        mBindGroup = std::make_unique<BindGroup>();
+        if (!mBindGroup->create(*mBindGroupLayout, items))
+        {
+            LogError("BindGroup::create() failed!!");
+            return false;
+        }
+
+        ComputePipelineProperties computeProps = {
+            .shader = mShader.get(),
+            .bindGroupLayouts = { mBindGroupLayout.get() }
+        };
+
+        mPipeline = std::make_unique<ComputePipeline>();
+        if (!mPipeline->create(computeProps))
+        {
+            LogError("ComputePipeline::create() failed!!");
+            return false;
+        }
+
+        return true;
+    }
+
+    bool CullingPass::createOcclusionPipeline()
+    {
+        auto layoutItems = getLayoutItems();
+        auto items = getBindGroupItems();
+
+        layoutItems.push_back({
+            .binding = 6,
+            .shaderStages = wgpu::ShaderStage::Compute,
+            .bindingLayout = BufferBindingLayout {
+                .type = wgpu::BufferBindingType::Storage,
+                .minBindingSize = sizeof(uint32_t)
+            }
+        });
+
+        layoutItems.push_back({
+            .binding = 7,
+            .shaderStages = wgpu::ShaderStage::Compute,
+            .bindingLayout = BufferBindingLayout {
+                .type = wgpu::BufferBindingType::Storage,
+                .minBindingSize = sizeof(Stats)
+            }
+        });
+
+        layoutItems.push_back({
+            .binding = 8,
+            .shaderStages = wgpu::ShaderStage::Compute,
+            .bindingLayout = TextureBindingLayout {
+                .sampleType = wgpu::TextureSampleType::UnfilterableFloat,
+                .viewDimension = wgpu::TextureViewDimension::e2D
+            }
+        });
+
+        items.push_back({
+            .binding = 6,
+            .size = mVisibilityBuffer->getSize(),
+            .resource = BufferBindingResource(*mVisibilityBuffer)
+        });
+
+        items.push_back({
+            .binding = 7,
+            .size = mStatsBuffer->getSize(),
+            .resource = BufferBindingResource(*mStatsBuffer)
+        });
+
+        items.push_back({
+            .binding = 8,
+            .resource = TextureViewBindingResource(mDepthPyramid->getView())
+        });
+
+        if (!mOcclusionBindGroupLayout)
+        {
+            mOcclusionBindGroupLayout = std::make_unique<BindGroupLayout>();
+            if (!mOcclusionBindGroupLayout->create(layoutItems))
+            {
+                LogError("BindGroupLayout::create() failed!!");
+                return false;
+            }
+
+            ComputePipelineProperties computeProps = {
+                .shader = mShader.get(),
+                .csEntry = "cs_occlusion",
+                .bindGroupLayouts = { mOcclusionBindGroupLayout.get() }
+            };
+
+            mOcclusionPipeline = std::make_unique<ComputePipeline>();
+            if (!mOcclusionPipeline->create(computeProps))
+            {
+                LogError("ComputePipeline::create() failed!!");
+                return false;
+            }
+        }
+
+        mOcclusionBindGroup = std::make_unique<BindGroup>();
+        if (!mOcclusionBindGroup->create(*mOcclusionBindGroupLayout, items))
+        {
+            LogError("BindGroup::create() failed!!");
+            return false;
+        }
+
+        return true;
+    }
+
+    std::vector<BindGroupLayoutItem> CullingPass::getLayoutItems() const
+    {
+        auto getBufferLayout = [](uint32_t binding, wgpu::BufferBindingType type, uint32_t minBindingSize) {
+            return BindGroupLayoutItem {
+                .binding = binding,
+                .shaderStages = wgpu::ShaderStage::Compute,
+                .bindingLayout = BufferBindingLayout {
+                    .type = type,
+                    .minBindingSize = minBindingSize
+                }
+            };
+        };
+
+        return {
+            getBufferLayout(0, wgpu::BufferBindingType::Uniform, sizeof(ParamsBufferData)),
+            getBufferLayout(1, wgpu::BufferBindingType::ReadOnlyStorage, sizeof(InstanceData)),
+            getBufferLayout(2, wgpu::BufferBindingType::ReadOnlyStorage, mPayloadSize),
+            getBufferLayout(3, wgpu::BufferBindingType::ReadOnlyStorage, sizeof(uint32_t)),
+            getBufferLayout(4, wgpu::BufferBindingType::Storage, sizeof(DrawIndexedIndirectArgs)),
+            getBufferLayout(5, wgpu::BufferBindingType::Storage, mPayloadSize)
+        };
+    }
+
+    std::vector<BindGroupItem> CullingPass::getBindGroupItems() const
+    {
+        return {
+            {
+                .binding = 0,
+                .size = mParamsBuffer->getSize(),
+                .resource = BufferBindingResource(*mParamsBuffer)
+            },
+            {
+                .binding = 1,
+                .size = mInstanceBuffer->getSize(),
+                .resource = BufferBindingResource(*mInstanceBuffer)
+            },
+            {
+                .binding = 2,
+                .size = mPayloadBuffer->getSize(),
+                .resource = BufferBindingResource(*mPayloadBuffer)
+            },
+            {
+                .binding = 3,
+                .size = mFirstOutputBuffer->getSize(),
+                .resource = BufferBindingResource(*mFirstOutputBuffer)
+            },
+            {
+                .binding = 4,
+                .size = mArgsBuffer->getSize(),
+                .resource = BufferBindingResource(*mArgsBuffer)
+            },
+            {
+                .binding = 5,
+                .size = mOutputBuffer->getSize(),
+                .resource = BufferBindingResource(*mOutputBuffer)
+            }
+        };
+    }
+
+    void CullingPass::readStats()
+    {
+        // the statistics trail the frame by however long the map takes, dawn only
+        // finishes a map when the device is ticked
+#ifndef __EMSCRIPTEN__
+        if (mStatsPending)
+        {
+            GraphicsDevice::get().getDevice().Tick();
+        }
+#endif
+    }
+
+    void CullingPass::upload()
+    {
+        // only the range touched since the last cull goes to the gpu
+        if (mDirtyBegin >= mDirtyEnd)
+        {
+            return;
+        }
+
+        const uint32_t count = mDirtyEnd - mDirtyBegin;
+
+        mInstanceBuffer->write(mDirtyBegin * sizeof(InstanceData), count * sizeof(InstanceData),
+            mInstances.data() + mDirtyBegin);
+
+        mPayloadBuffer->write(mDirtyBegin * mPayloadSize, count * mPayloadSize,
+            mPayloads.data() + mDirtyBegin * mPayloadSize);
+
+        mDirtyBegin = (uint32_t)mInstances.size();
+        mDirtyEnd = 0;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,284 @@
+#include "Graphics/DepthPyramid.h"
+#include "Graphics/GraphicsDevice.h"
+#include "Graphics/Shader.h"
+#include "Graphics/BindGroupLayout.h"
+#include "Core/Debugger.h"
+#include "Core/Logger.h"
+#include <algorithm>
+
+namespace Trinity
+{
+    static uint32_t getPreviousPowerOfTwo(uint32_t value)
+    {
+        uint32_t result = 1;
+        while ((result << 1) <= value)
+        {
+            result <<= 1;
+        }
+
+        return result;
+    }
+
+    void DepthPyramid::destroy()
+    {
+        ComputePass::destroy();
+
+        mBindGroups.clear();
+        mLevelViews.clear();
+        mDepthView = nullptr;
+        mView = nullptr;
+
+        if (mTexture)
+        {
+            mTexture.Destroy();
+            mTexture = nullptr;
+        }
+
+        mCopyPipeline = nullptr;
+        mReducePipeline = nullptr;
+        mCopyBindGroupLayout = nullptr;
+        mReduceBindGroupLayout = nullptr;
+        mShader = nullptr;
+
+        mWidth = 0;
+        mHeight = 0;
+        mDepthWidth = 0;
+        mDepthHeight = 0;
+    }
+
+    std::type_index DepthPyramid::getType() const
+    {
+        return typeid(DepthPyramid);
+    }
+
+    bool DepthPyramid::create(uint32_t depthWidth, uint32_t depthHeight)
+    {
+        const wgpu::Device& device = GraphicsDevice::get();
+
+        // a power of two base keeps every level below an exact 2x2 reduction, only
+        // the first copy has to cover an uneven footprint of the depth buffer
+        mDepthWidth = depthWidth;
+        mDepthHeight = depthHeight;
+        mWidth = getPreviousPowerOfTwo(std::max(depthWidth, 1u));
+        mHeight = getPreviousPowerOfTwo(std::max(depthHeight, 1u));
+
+        uint32_t numLevels = 1;
+        while ((std::max(mWidth, mHeight) >> numLevels) > 0)
+        {
+            numLevels++;
+        }
+
+        wgpu::TextureDescriptor textureDesc = {
+            .label = "DepthPyramid.Texture",
+            .usage = wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::StorageBinding,
+            .dimension = wgpu::TextureDimension::e2D,
+            .size = {
+                .width = mWidth,
+                .height = mHeight,
+                .depthOrArrayLayers = 1
+            },
+            .format = wgpu::TextureFormat::R32Float,
+            .mipLevelCount = numLevels,
+            .sampleCount = 1
+        };
+
+        mTexture = device.CreateTexture(&textureDesc);
+        if (!mTexture)
+        {
+            LogError("wgpu::Device::CreateTexture() failed!!");
+            return false;
+        }
+
+        wgpu::TextureViewDescriptor viewDesc = {
+            .format = wgpu::TextureFormat::R32Float,
+            .dimension = wgpu::TextureViewDimension::e2D,
+            .baseMipLevel = 0,
+            .mipLevelCount = numLevels,
+            .baseArrayLayer = 0,
+            .arrayLayerCount = 1
+        };
+
+        mView = mTexture.CreateView(&viewDesc);
+        if (!mView)
+        {
+            LogError("wgpu::Texture::CreateView() failed!!");
+            return false;
+        }
+
+        mLevelViews.clear();
+        for (uint32_t level = 0; level < numLevels; level++)
+        {
+            viewDesc.baseMipLevel = level;
+            viewDesc.mipLevelCount = 1;
+
+            auto levelView = mTexture.CreateView(&viewDesc);
+            if (!levelView)
+            {
+                LogError("wgpu::Texture::CreateView() failed!!");
+                return false;
+            }
+
+            mLevelViews.push_back(std::move(levelView));
+        }
+
+        if (!createPipelines())
+        {
+            LogError("DepthPyramid::createPipelines() failed!!");
+            return false;
+        }
+
+        mBindGroups.clear();
+        mBindGroups.resize(numLevels);
+        mDepthView = nullptr;
+
+        for (uint32_t level = 1; level < numLevels; level++)
+        {
+            std::vector<BindGroupItem> items = {
+                {
+                    .binding = 0,
+                    .resource = TextureViewBindingResource(mLevelViews[level - 1])
+                },
+                {
+                    .binding = 1,
+                    .resource = TextureViewBindingResource(mLevelViews[level])
+                }
+            };
+
+            mBindGroups[level] = std::make_unique<BindGroup>();
+            if (!mBindGroups[level]->create(*mReduceBindGroupLayout, items))
+            {
+                LogError("BindGroup::create() failed!!");
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool DepthPyramid::build(const wgpu::TextureView& depthView)
+    {
+        Assert(mTexture != nullptr, "DepthPyramid::create() not called!!");
+
+        // the first level reads the depth buffer directly, so its bind group
+        // follows the view handed in rather than being made up front
+        if (!mBindGroups[0] || depthView.Get() != mDepthView.Get())
+        {
+            std::vector<BindGroupItem> items = {
+                {
+                    .binding = 0,
+                    .resource = TextureViewBindingResource(depthView)
+                },
+                {
+                    .binding = 1,
+                    .resource = TextureViewBindingResource(mLevelViews[0])
+                }
+            };
+
+            mBindGroups[0] = std::make_unique<BindGroup>();
+            if (!mBindGroups[0]->create(*mCopyBindGroupLayout, items))
+            {
+                LogError("BindGroup::create() failed!!");
+                return false;
+            }
+
+            mDepthView = depthView;
+        }
+
+        if (!begin())
+        {
+            LogError("ComputePass::begin() failed!!");
+            return false;
+        }
+
+        for (uint32_t level = 0; level < getNumLevels(); level++)
+        {
+            const uint32_t width = std::max(mWidth >> level, 1u);
+            const uint32_t height = std::max(mHeight >> level, 1u);
+
+            setPipeline(level == 0 ? *mCopyPipeline : *mReducePipeline);
+            setBindGroup(0, *mBindGroups[level]);
+            dispatch((width + kWorkgroupSize - 1) / kWorkgroupSize, (height + kWorkgroupSize - 1) / kWorkgroupSize);
+        }
+
+        end();
+        submit();
+
+        return true;
+    }
+
+    bool DepthPyramid::createPipelines()
+    {
+        ShaderPreProcessor processor;
+        mShader = std::make_unique<Shader>();
+
+        if (!mShader->load(kDefaultShader, processor))
+        {
+            LogError("Shader::load() failed for: %s!!", kDefaultShader);
+            return false;
+        }
+
+        auto getLayoutItems = [](wgpu::TextureSampleType sampleType) {
+            return std::vector<BindGroupLayoutItem> {
+                {
+                    .binding = 0,
+                    .shaderStages = wgpu::ShaderStage::Compute,
+                    .bindingLayout = TextureBindingLayout {
+                        .sampleType = sampleType,
+                        .viewDimension = wgpu::TextureViewDimension::e2D
+                    }
+                },
+                {
+                    .binding = 1,
+                    .shaderStages = wgpu::ShaderStage::Compute,
+                    .bindingLayout = StorageTextureBindingLayout {
+                        .access = wgpu::StorageTextureAccess::WriteOnly,
+                        .format = wgpu::TextureFormat::R32Float,
+                        .viewDimension = wgpu::TextureViewDimension::e2D
+                    }
+                }
+            };
+        };
+
+        mCopyBindGroupLayout = std::make_unique<BindGroupLayout>();
+        if (!mCopyBindGroupLayout->create(getLayoutItems(wgpu::TextureSampleType::Depth)))
+        {
+            LogError("BindGroupLayout::create() failed!!");
+            return false;
+        }
+
+        mReduceBindGroupLayout = std::make_unique<BindGroupLayout>();
+        if (!mReduceBindGroupLayout->create(getLayoutItems(wgpu::TextureSampleType::UnfilterableFloat)))
+        {
+            LogError("BindGroupLayout::create() failed!!");
+            return false;
+        }
+
+        ComputePipelineProperties copyProps = {
+            .shader = mShader.get(),
+            .csEntry = "cs_copy",
+            .bindGroupLayouts = { mCopyBindGroupLayout.get() }
+        };
+
+        mCopyPipeline = std::make_unique<ComputePipeline>();
+        if (!mCopyPipeline->create(copyProps))
+        {
+            LogError("ComputePipeline::create() failed!!");
+            return false;
+        }
+
+        ComputePipelineProperties reduceProps = {
+            .shader = mShader.get(),
+            .csEntry = "cs_reduce",
+            .bindGroupLayouts = { mReduceBindGroupLayout.get() }
+        };
+
+        mReducePipeline = std::make_unique<ComputePipeline>();
+        if (!mReducePipeline->create(reduceProps))
+        {
+            LogError("ComputePipeline::create() failed!!");
+            return false;
+        }
+
+        return true;
+    }
+}
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Graphics/GraphicsDevice.h"
+#include "Graphics/BlobCache.h"
 #include "Core/Logger.h"
 #include "Core/Debugger.h"
 
@@ -40,7 +41,24 @@ namespace Trinity
                     return;
                 }
 
-                wgpuAdapterRequestDevice(adapter, nullptr,
+                GraphicsDevice* graphics = reinterpret_cast<GraphicsDevice*>(userdata);
+                wgpu::DeviceDescriptor deviceDesc{};
+
+#ifndef __EMSCRIPTEN__
+                // dawn keys pipeline and shader blobs by their source and descriptors,
+                // persisting them lets later launches skip the backend compilation
+                wgpu::DawnCacheDeviceDescriptor cacheDesc{};
+                if (graphics->mBlobCache != nullptr)
+                {
+                    cacheDesc.isolationKey = "Trinity";
+                    cacheDesc.loadDataFunction = &BlobCache::loadData;
+                    cacheDesc.storeDataFunction = &BlobCache::storeData;
+                    cacheDesc.functionUserdata = graphics->mBlobCache;
+                    deviceDesc.nextInChain = &cacheDesc;
+                }
+#endif
+
+                wgpuAdapterRequestDevice(adapter, reinterpret_cast<const WGPUDeviceDescriptor*>(&deviceDesc),
                     [](WGPURequestDeviceStatus status, WGPUDevice device, char const* message, void* userdata) {
                         if (status != WGPURequestDeviceStatus_Success)
                         {
@@ -66,6 +84,11 @@ namespace Trinity
         mInstance = nullptr;
     }
 
+    void GraphicsDevice::setBlobCache(BlobCache* blobCache)
+    {
+        mBlobCache = blobCache;
+    }
+
     bool GraphicsDevice::setupSwapChain(const Window& window, wgpu::PresentMode presentMode,
         wgpu::TextureFormat depthFormat)
     {
@@ -2,6 +2,8 @@
 #include "Graphics/GraphicsDevice.h"
 #include "Core/Debugger.h"
 #include "Core/Logger.h"
+#include <cstring>
+#include <vector>
 
 namespace Trinity
 {
@@ -10,7 +12,8 @@ namespace Trinity
         destroy();
     }
 
-    bool IndexBuffer::create(wgpu::IndexFormat indexFormat, uint32_t numIndices, const void* data)
+    bool IndexBuffer::create(wgpu::IndexFormat indexFormat, uint32_t numIndices, const void* data,
+        wgpu::BufferUsage usage)
     {
         const wgpu::Device& device = GraphicsDevice::get();
 
@@ -18,9 +21,13 @@ namespace Trinity
         mNumIndices = numIndices;
         mIndexSize = mIndexFormat == wgpu::IndexFormat::Uint16 ? 2 : 4;
 
+        // 16 bit buffers with an odd index count are padded since copies have to be a multiple of 4 bytes
+        const uint32_t dataSize = mIndexSize * mNumIndices;
+        const uint32_t bufferSize = (dataSize + 3) & ~3u;
+
         wgpu::BufferDescriptor bufferDescriptor{};
-        bufferDescriptor.usage = wgpu::BufferUsage::Index | wgpu::BufferUsage::CopyDst;
-        bufferDescriptor.size = mIndexSize * mNumIndices;
+        bufferDescriptor.usage = wgpu::BufferUsage::Index | wgpu::BufferUsage::CopyDst | usage;
+        bufferDescriptor.size = bufferSize;
         bufferDescriptor.mappedAtCreation = false;
 
         mHandle = device.CreateBuffer(&bufferDescriptor);
@@ -30,9 +37,15 @@ namespace Trinity
             return false;
         }
 
-        if (data)
+        if (data && dataSize != bufferSize)
+        {
+            std::vector<uint8_t> paddedData(bufferSize, 0);
+            std::memcpy(paddedData.data(), data, dataSize);
+            write(0, bufferSize, paddedData.data());
+        }
+        else if (data)
         {
-            write(0, mIndexSize * mNumIndices, data);
+            write(0, dataSize, data);
         }
 
         return true;
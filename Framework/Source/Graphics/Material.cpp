@@ -21,10 +21,16 @@ namespace Trinity
 	{
 		Resource::destroy();
 
-		mShader = nullptr;
-		mBindGroup = nullptr;
-		mBindGroupLayout = nullptr;
-		mParamsBuffer = nullptr;
+		for (auto& it : mTextures)
+		{
+			releaseResourceRef(it.second.texture);
+			releaseResourceRef(it.second.sampler);
+		}
+
+		releaseResourceRef(mShader);
+		releaseResourceRef(mBindGroup);
+		releaseResourceRef(mBindGroupLayout);
+		releaseResourceRef(mParamsBuffer);
 		mTextures.clear();
 		mShaderDefines.clear();
 	}
@@ -66,7 +72,7 @@ namespace Trinity
 
 	void Material::setShader(Shader& shader)
 	{
-		mShader = &shader;
+		setResourceRef(mShader, &shader);
 	}
 
 	void Material::addShaderDefine(const std::string& define)
@@ -82,20 +88,13 @@ namespace Trinity
 	void Material::setTexture(const std::string& name, Texture& texture, Sampler& sampler)
 	{
 		auto it = mTextures.find(name);
-		if (it != mTextures.end())
-		{
-			it->second = {
-				.texture = &texture,
-				.sampler = &sampler
-			};
-		}
-		else
+		if (it == mTextures.end())
 		{
-			mTextures.insert(std::make_pair(name, MaterialTexture{
-				.texture = &texture,
-				.sampler = &sampler
-			}));
+			it = mTextures.insert(std::make_pair(name, MaterialTexture{})).first;
 		}
+
+		setResourceRef(it->second.texture, &texture);
+		setResourceRef(it->second.sampler, &sampler);
 	}
 
 	bool Material::addTexture(const std::string& name, TextureType type, const std::string& textureFileName,
@@ -137,11 +136,7 @@ namespace Trinity
 		auto* texture = cache.getResource<Texture>(textureFileName);
 		auto* sampler = cache.getResource<Sampler>(samplerFileName);
 
-		mTextures.insert(std::make_pair(name, MaterialTexture{
-			.texture = texture,
-			.sampler = sampler
-		}));
-
+		setTexture(name, *texture, *sampler);
 		return true;
 	}
 
@@ -157,12 +152,66 @@ namespace Trinity
 			return false;
 		}
 
-		mShader = shader.get();
+		setResourceRef(mShader, shader.get());
 		cache.addResource(std::move(shader));
 
 		return true;
 	}
 
+	bool Material::getDependencies(FileReader& reader, std::vector<ResourceDependency>& dependencies)
+	{
+		mName = reader.readString();
+
+		reader.read(&mEmissive);
+		reader.read(&mDoubleSided);
+		reader.read(&mAlphaCutoff);
+		reader.read(&mAlphaMode);
+
+		uint32_t numDefines{ 0 };
+		reader.read(&numDefines);
+
+		for (uint32_t idx = 0; idx < numDefines; idx++)
+		{
+			reader.readString();
+		}
+
+		reader.readString();
+
+		uint32_t numTextures{ 0 };
+		reader.read(&numTextures);
+
+		for (uint32_t idx = 0; idx < numTextures; idx++)
+		{
+			TextureType type{ TextureType::TwoD };
+			reader.read(&type);
+			reader.readString();
+
+			auto textureFileName = Resource::getReadPath(reader.getPath(), reader.readString());
+			auto samplerFileName = Resource::getReadPath(reader.getPath(), reader.readString());
+
+			dependencies.push_back({
+				.fileName = textureFileName,
+				.creator = [type]() -> std::unique_ptr<Resource> {
+					if (type == TextureType::TwoD)
+					{
+						return std::make_unique<Texture2D>();
+					}
+
+					return std::make_unique<TextureCube>();
+				}
+			});
+
+			dependencies.push_back({
+				.fileName = samplerFileName,
+				.creator = []() -> std::unique_ptr<Resource> {
+					return std::make_unique<Sampler>();
+				}
+			});
+		}
+
+		return true;
+	}
+
 	bool Material::read(FileReader& reader, ResourceCache& cache)
 	{
 		if (!Resource::read(reader, cache))
@@ -0,0 +1,347 @@
+#include "Graphics/MeshletCullingPass.h"
+#include "Graphics/GraphicsDevice.h"
+#include "Graphics/Shader.h"
+#include "Graphics/BindGroupLayout.h"
+#include "Core/Debugger.h"
+#include "Core/Logger.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Trinity
+{
+    void MeshletCullingPass::destroy()
+    {
+        ComputePass::destroy();
+
+        mMeshlets.clear();
+        mGroups.clear();
+        mArgs.clear();
+        mDirtyBegin = 0;
+        mDirtyEnd = 0;
+
+        mBindGroup = nullptr;
+        mBindGroupLayout = nullptr;
+        mPipeline = nullptr;
+        mShader = nullptr;
+        mParamsBuffer = nullptr;
+        mMeshletBuffer = nullptr;
+        mGroupBuffer = nullptr;
+        mArgsBuffer = nullptr;
+        mSourceBuffer = nullptr;
+        mIndexBuffer = nullptr;
+        mStatsBuffer = nullptr;
+        mStatsReadbackBuffer = nullptr;
+        mStats = {};
+        mStatsPending = false;
+    }
+
+    std::type_index MeshletCullingPass::getType() const
+    {
+        return typeid(MeshletCullingPass);
+    }
+
+    bool MeshletCullingPass::create(std::vector<MeshletData>&& meshlets, const std::vector<uint32_t>& indices,
+        uint32_t numGroups)
+    {
+        mMeshlets = std::move(meshlets);
+        mGroups.resize(numGroups);
+        mDirtyBegin = 0;
+        mDirtyEnd = numGroups;
+
+        // every group owns a region of the output indices big enough for all of its meshlets,
+        // the shader appends the survivors there and grows the index count of the group's draw
+        std::vector<uint32_t> numGroupIndices(numGroups, 0);
+        for (const auto& meshlet : mMeshlets)
+        {
+            numGroupIndices[meshlet.groupIndex] += meshlet.numIndices;
+        }
+
+        uint32_t numIndices{ 0 };
+        mArgs.resize(numGroups);
+
+        for (uint32_t idx = 0; idx < numGroups; idx++)
+        {
+            mArgs[idx] = {
+                .indexCount = 0,
+                .instanceCount = 1,
+                .firstIndex = numIndices
+            };
+
+            numIndices += numGroupIndices[idx];
+        }
+
+        // storage bindings can't be empty, so every buffer holds at least one element
+        const uint32_t numBufferMeshlets = std::max((uint32_t)mMeshlets.size(), 1u);
+        const uint32_t numBufferGroups = std::max(numGroups, 1u);
+        const uint32_t numBufferSourceIndices = std::max((uint32_t)indices.size(), 1u);
+
+        mParamsBuffer = std::make_unique<UniformBuffer>();
+        if (!mParamsBuffer->create(sizeof(ParamsBufferData)))
+        {
+            LogError("UniformBuffer::create() failed!!");
+            return false;
+        }
+
+        mMeshletBuffer = std::make_unique<StorageBuffer>();
+        if (!mMeshletBuffer->create(numBufferMeshlets * sizeof(MeshletData), mMeshlets.empty() ? nullptr : mMeshlets.data()))
+        {
+            LogError("StorageBuffer::create() failed!!");
+            return false;
+        }
+
+        mGroupBuffer = std::make_unique<StorageBuffer>();
+        if (!mGroupBuffer->create(numBufferGroups * sizeof(GroupData)))
+        {
+            LogError("StorageBuffer::create() failed!!");
+            return false;
+        }
+
+        mArgsBuffer = std::make_unique<StorageBuffer>();
+        if (!mArgsBuffer->create(numBufferGroups * sizeof(DrawIndexedIndirectArgs), nullptr, wgpu::BufferUsage::Indirect))
+        {
+            LogError("StorageBuffer::create() failed!!");
+            return false;
+        }
+
+        mSourceBuffer = std::make_unique<StorageBuffer>();
+        if (!mSourceBuffer->create(numBufferSourceIndices * sizeof(uint32_t), indices.empty() ? nullptr : indices.data()))
+        {
+            LogError("StorageBuffer::create() failed!!");
+            return false;
+        }
+
+        mIndexBuffer = std::make_unique<IndexBuffer>();
+        if (!mIndexBuffer->create(wgpu::IndexFormat::Uint32, std::max(numIndices, 1u), nullptr, wgpu::BufferUsage::Storage))
+        {
+            LogError("IndexBuffer::create() failed!!");
+            return false;
+        }
+
+        mStatsBuffer = std::make_unique<StorageBuffer>();
+        if (!mStatsBuffer->create(sizeof(Stats), nullptr, wgpu::BufferUsage::CopySrc))
+        {
+            LogError("StorageBuffer::create() failed!!");
+            return false;
+        }
+
+        mStatsReadbackBuffer = std::make_unique<ReadbackBuffer>();
+        if (!mStatsReadbackBuffer->create(sizeof(Stats)))
+        {
+            LogError("ReadbackBuffer::create() failed!!");
+            return false;
+        }
+
+        mStatsReadbackBuffer->onMapAsyncCompleted.subscribe([this](void* data) {
+            std::memcpy(&mStats, data, sizeof(Stats));
+            mStatsReadbackBuffer->unmap();
+            mStatsPending = false;
+        });
+
+        if (!createPipeline())
+        {
+            LogError("MeshletCullingPass::createPipeline() failed!!");
+            return false;
+        }
+
+        return true;
+    }
+
+    void MeshletCullingPass::setGroup(uint32_t index, const GroupData& group)
+    {
+        mGroups[index] = group;
+        mDirtyBegin = std::min(mDirtyBegin, index);
+        mDirtyEnd = std::max(mDirtyEnd, index + 1);
+    }
+
+    bool MeshletCullingPass::cull(const Frustum& frustum, const glm::vec3& cameraPos, const glm::vec3& cameraDir,
+        bool perspective)
+    {
+        if (mMeshlets.empty())
+        {
+            return true;
+        }
+
+        upload();
+
+        ParamsBufferData params = {
+            .cameraPos = cameraPos,
+            .numMeshlets = (uint32_t)mMeshlets.size(),
+            .cameraDir = cameraDir,
+            .perspective = perspective ? 1u : 0u
+        };
+
+        // spheres are tested against distances, so unlike the box tests the planes have to be normalized
+        for (uint32_t idx = 0; idx < 6; idx++)
+        {
+            params.planes[idx] = frustum.planes[idx] / glm::length(glm::vec3(frustum.planes[idx]));
+        }
+
+        mParamsBuffer->write(0, sizeof(ParamsBufferData), &params);
+
+        // the shader only ever adds to the index counts, so every draw starts out empty
+        mArgsBuffer->write(0, (uint32_t)mArgs.size() * sizeof(DrawIndexedIndirectArgs), mArgs.data());
+
+        const bool readback = !mStatsPending;
+        if (readback)
+        {
+            const Stats stats{};
+            mStatsBuffer->write(0, sizeof(Stats), &stats);
+        }
+
+        if (!begin())
+        {
+            LogError("ComputePass::begin() failed!!");
+            return false;
+        }
+
+        setPipeline(*mPipeline);
+        setBindGroup(0, *mBindGroup);
+        dispatch((params.numMeshlets + kWorkgroupSize - 1) / kWorkgroupSize);
+        end();
+
+        if (readback)
+        {
+            mCommandEncoder.CopyBufferToBuffer(mStatsBuffer->getHandle(), 0,
+                mStatsReadbackBuffer->getHandle(), 0, sizeof(Stats));
+        }
+
+        submit();
+
+        if (readback)
+        {
+            mStatsPending = true;
+            mStatsReadbackBuffer->mapAsync(0, sizeof(Stats), wgpu::MapMode::Read);
+        }
+        else
+        {
+            readStats();
+        }
+
+        return true;
+    }
+
+    bool MeshletCullingPass::createPipeline()
+    {
+        ShaderPreProcessor processor;
+        mShader = std::make_unique<Shader>();
+
+        if (!mShader->load(kDefaultShader, processor))
+        {
+            LogError("Shader::load() failed for: %s!!", kDefaultShader);
+            return false;
+        }
+
+        auto getBufferLayout = [](uint32_t binding, wgpu::BufferBindingType type, uint32_t minBindingSize) {
+            return BindGroupLayoutItem {
+                .binding = binding,
+                .shaderStages = wgpu::ShaderStage::Compute,
+                .bindingLayout = BufferBindingLayout {
+                    .type = type,
+                    .minBindingSize = minBindingSize
+                }
+            };
+        };
+
+        const std::vector<BindGroupLayoutItem> layoutItems = {
+            getBufferLayout(0, wgpu::BufferBindingType::Uniform, sizeof(ParamsBufferData)),
+            getBufferLayout(1, wgpu::BufferBindingType::ReadOnlyStorage, sizeof(MeshletData)),
+            getBufferLayout(2, wgpu::BufferBindingType::ReadOnlyStorage, sizeof(GroupData)),
+            getBufferLayout(3, wgpu::BufferBindingType::Storage, sizeof(DrawIndexedIndirectArgs)),
+            getBufferLayout(4, wgpu::BufferBindingType::Storage, sizeof(Stats)),
+            getBufferLayout(5, wgpu::BufferBindingType::ReadOnlyStorage, sizeof(uint32_t)),
+            getBufferLayout(6, wgpu::BufferBindingType::Storage, sizeof(uint32_t))
+        };
+
+        const std::vector<BindGroupItem> items = {
+            {
+                .binding = 0,
+                .size = mParamsBuffer->getSize(),
+                .resource = BufferBindingResource(*mParamsBuffer)
+            },
+            {
+                .binding = 1,
+                .size = mMeshletBuffer->getSize(),
+                .resource = BufferBindingResource(*mMeshletBuffer)
+            },
+            {
+                .binding = 2,
+                .size = mGroupBuffer->getSize(),
+                .resource = BufferBindingResource(*mGroupBuffer)
+            },
+            {
+                .binding = 3,
+                .size = mArgsBuffer->getSize(),
+                .resource = BufferBindingResource(*mArgsBuffer)
+            },
+            {
+                .binding = 4,
+                .size = mStatsBuffer->getSize(),
+                .resource = BufferBindingResource(*mStatsBuffer)
+            },
+            {
+                .binding = 5,
+                .size = mSourceBuffer->getSize(),
+                .resource = BufferBindingResource(*mSourceBuffer)
+            },
+            {
+                .binding = 6,
+                .size = mIndexBuffer->getNumIndices() * mIndexBuffer->getIndexSize(),
+                .resource = BufferBindingResource(*mIndexBuffer)
+            }
+        };
+
+        mBindGroupLayout = std::make_unique<BindGroupLayout>();
+        if (!mBindGroupLayout->create(layoutItems))
+        {
+            LogError("BindGroupLayout::create() failed!!");
+            return false;
+        }
+
+        mBindGroup = std::make_unique<BindGroup>();
+        if (!mBindGroup->create(*mBindGroupLayout, items))
+        {
+            LogError("BindGroup::create() failed!!");
+            return false;
+        }
+
+        ComputePipelineProperties computeProps = {
+            .shader = mShader.get(),
+            .bindGroupLayouts = { mBindGroupLayout.get() }
+        };
+
+        mPipeline = std::make_unique<ComputePipeline>();
+        if (!mPipeline->create(computeProps))
+        {
+            LogError("ComputePipeline::create() failed!!");
+            return false;
+        }
+
+        return true;
+    }
+
+    void MeshletCullingPass::readStats()
+    {
+        // same as the instance culling, the map only finishes once the device is ticked
+#ifndef __EMSCRIPTEN__
+        if (mStatsPending)
+        {
+            GraphicsDevice::get().getDevice().Tick();
+        }
+#endif
+    }
+
+    void MeshletCullingPass::upload()
+    {
+        // only groups that moved since the last cull go to the gpu
+        if (mDirtyBegin >= mDirtyEnd)
+        {
+            return;
+        }
+
+        const uint32_t count = mDirtyEnd - mDirtyBegin;
+        mGroupBuffer->write(mDirtyBegin * sizeof(GroupData), count * sizeof(GroupData), mGroups.data() + mDirtyBegin);
+
+        mDirtyBegin = (uint32_t)mGroups.size();
+        mDirtyEnd = 0;
+    }
+}
\ No newline at end of file
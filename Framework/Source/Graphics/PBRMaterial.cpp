@@ -189,9 +189,9 @@ namespace Trinity
 			return false;
 		}
 
-		mParamsBuffer = paramsBuffer.get();
-		mBindGroupLayout = bindGroupLayout.get();
-		mBindGroup = bindGroup.get();
+		setResourceRef(mParamsBuffer, paramsBuffer.get());
+		setResourceRef(mBindGroupLayout, bindGroupLayout.get());
+		setResourceRef(mBindGroup, bindGroup.get());
 
 		cache.addResource(std::move(paramsBuffer));
 		cache.addResource(std::move(bindGroupLayout));
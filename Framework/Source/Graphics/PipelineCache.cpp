@@ -0,0 +1,226 @@
+#include "Graphics/PipelineCache.h"
+#include "Core/Logger.h"
+#include "Utils/HashHelper.h"
+
+namespace Trinity
+{
+    template <typename T>
+    static void writeKey(std::vector<uint8_t>& key, const T& value)
+    {
+        const auto* bytes = (const uint8_t*)&value;
+        key.insert(key.end(), bytes, bytes + sizeof(T));
+    }
+
+    static void writeKey(std::vector<uint8_t>& key, const std::string& value)
+    {
+        writeKey(key, (uint32_t)value.size());
+        key.insert(key.end(), value.begin(), value.end());
+    }
+
+    static void writeBlendComponent(std::vector<uint8_t>& key, const wgpu::BlendComponent& component)
+    {
+        writeKey(key, component.operation);
+        writeKey(key, component.srcFactor);
+        writeKey(key, component.dstFactor);
+    }
+
+    static void writeBindGroupLayout(std::vector<uint8_t>& key, const BindGroupLayout* bindGroupLayout)
+    {
+        writeKey(key, bindGroupLayout != nullptr);
+        if (bindGroupLayout == nullptr)
+        {
+            return;
+        }
+
+        const auto& items = bindGroupLayout->getItems();
+        writeKey(key, (uint32_t)items.size());
+
+        for (const auto& item : items)
+        {
+            writeKey(key, item.binding);
+            writeKey(key, item.shaderStages);
+            writeKey(key, (uint32_t)item.bindingLayout.index());
+
+            std::visit([&key](auto&& bindingLayout) {
+                using T = std::decay_t<decltype(bindingLayout)>;
+
+                if constexpr (std::is_same_v<T, BufferBindingLayout>)
+                {
+                    writeKey(key, bindingLayout.type);
+                    writeKey(key, bindingLayout.hasDynamicOffset);
+                    writeKey(key, bindingLayout.minBindingSize);
+                }
+                else if constexpr (std::is_same_v<T, TextureBindingLayout>)
+                {
+                    writeKey(key, bindingLayout.sampleType);
+                    writeKey(key, bindingLayout.viewDimension);
+                }
+                else if constexpr (std::is_same_v<T, SamplerBindingLayout>)
+                {
+                    writeKey(key, bindingLayout.type);
+                }
+                else if constexpr (std::is_same_v<T, StorageTextureBindingLayout>)
+                {
+                    writeKey(key, bindingLayout.access);
+                    writeKey(key, bindingLayout.format);
+                    writeKey(key, bindingLayout.viewDimension);
+                }
+                }, item.bindingLayout);
+        }
+    }
+
+    static void writeVertexLayout(std::vector<uint8_t>& key, const VertexLayout* vertexLayout)
+    {
+        writeKey(key, vertexLayout != nullptr);
+        if (vertexLayout == nullptr)
+        {
+            return;
+        }
+
+        const auto& attributes = vertexLayout->getAttributes();
+        writeKey(key, vertexLayout->getSize());
+        writeKey(key, (uint32_t)attributes.size());
+
+        for (const auto& attribute : attributes)
+        {
+            writeKey(key, attribute.format);
+            writeKey(key, attribute.offset);
+            writeKey(key, attribute.shaderLocation);
+        }
+    }
+
+    static void writeStencilFace(std::vector<uint8_t>& key, const wgpu::StencilFaceState& state)
+    {
+        writeKey(key, state.compare);
+        writeKey(key, state.failOp);
+        writeKey(key, state.depthFailOp);
+        writeKey(key, state.passOp);
+    }
+
+    PipelineCache::~PipelineCache()
+    {
+        destroy();
+    }
+
+    RenderPipeline* PipelineCache::getRenderPipeline(const RenderPipelineProperties& renderProps)
+    {
+        std::vector<uint8_t> key;
+        getKey(renderProps, key);
+
+        // the hash only picks the bucket, a hit has to match the whole key and the shader source
+        const uint64_t hash = HashHelper::hash(key.data(), key.size());
+        auto& entries = mPipelines[hash];
+
+        const std::string emptySource;
+        const auto& shaderSource = renderProps.shader != nullptr ? renderProps.shader->getSource() : emptySource;
+
+        for (const auto& entry : entries)
+        {
+            if (entry.key == key && entry.shaderSource == shaderSource)
+            {
+                mNumReused++;
+                return entry.pipeline.get();
+            }
+        }
+
+        const TimePoint startTime = std::chrono::high_resolution_clock::now();
+
+        auto pipeline = std::make_unique<RenderPipeline>();
+        if (!pipeline->create(renderProps))
+        {
+            LogError("RenderPipeline::create() failed!!");
+            return nullptr;
+        }
+
+        Duration createTime = std::chrono::high_resolution_clock::now() - startTime;
+        mCreateTime += createTime.count();
+        mNumCreated++;
+
+        auto* result = pipeline.get();
+        entries.push_back({
+            .key = std::move(key),
+            .shaderSource = shaderSource,
+            .pipeline = std::move(pipeline)
+        });
+
+        return result;
+    }
+
+    void PipelineCache::destroy()
+    {
+        mPipelines.clear();
+        mNumCreated = 0;
+        mNumReused = 0;
+        mCreateTime = 0.0f;
+    }
+
+    uint64_t PipelineCache::getHash(const RenderPipelineProperties& renderProps)
+    {
+        std::vector<uint8_t> key;
+        getKey(renderProps, key);
+
+        return HashHelper::hash(key.data(), key.size());
+    }
+
+    void PipelineCache::getKey(const RenderPipelineProperties& renderProps, std::vector<uint8_t>& key)
+    {
+        // shaders and layouts are keyed by content, materials create their own copies
+        // of identical modules and layouts which can still share a pipeline, the source
+        // itself is too big to copy into every key so only its hash spreads the buckets
+        // and getRenderPipeline() compares the source text on a hit
+        writeKey(key, renderProps.shader != nullptr ? renderProps.shader->getSourceHash() : 0);
+        writeKey(key, renderProps.vsEntry);
+        writeKey(key, renderProps.fsEntry);
+
+        writeKey(key, (uint32_t)renderProps.bindGroupLayouts.size());
+        for (const auto* bindGroupLayout : renderProps.bindGroupLayouts)
+        {
+            writeBindGroupLayout(key, bindGroupLayout);
+        }
+
+        writeKey(key, (uint32_t)renderProps.vertexLayouts.size());
+        for (const auto* vertexLayout : renderProps.vertexLayouts)
+        {
+            writeVertexLayout(key, vertexLayout);
+        }
+
+        writeKey(key, (uint32_t)renderProps.colorTargets.size());
+        for (const auto& colorTarget : renderProps.colorTargets)
+        {
+            writeKey(key, colorTarget.format);
+            writeKey(key, colorTarget.colorWriteMask);
+            writeKey(key, colorTarget.blendState.has_value());
+
+            if (colorTarget.blendState)
+            {
+                writeBlendComponent(key, colorTarget.blendState->color);
+                writeBlendComponent(key, colorTarget.blendState->alpha);
+            }
+        }
+
+        writeKey(key, renderProps.primitive.topology);
+        writeKey(key, renderProps.primitive.frontFace);
+        writeKey(key, renderProps.primitive.cullMode);
+
+        writeKey(key, renderProps.multisample.count);
+        writeKey(key, renderProps.multisample.mask);
+        writeKey(key, renderProps.multisample.alphaToCoverageEnabled);
+
+        writeKey(key, renderProps.depthStencil.has_value());
+        if (renderProps.depthStencil)
+        {
+            const auto& depthStencil = *renderProps.depthStencil;
+
+            writeKey(key, depthStencil.format);
+            writeKey(key, depthStencil.depthWriteEnabled);
+            writeKey(key, depthStencil.depthCompare);
+            writeStencilFace(key, depthStencil.stencilFront);
+            writeStencilFace(key, depthStencil.stencilBack);
+            writeKey(key, depthStencil.stencilReadMask);
+            writeKey(key, depthStencil.stencilWriteMask);
+            writeKey(key, depthStencil.depthBias);
+            writeKey(key, depthStencil.depthBiasSlopeScale);
+            writeKey(key, depthStencil.depthBiasClamp);
+        }
+    }
+}
\ No newline at end of file
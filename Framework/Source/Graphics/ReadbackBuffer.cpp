@@ -0,0 +1,40 @@
+#include "Graphics/ReadbackBuffer.h"
+#include "Graphics/GraphicsDevice.h"
+#include "Core/Logger.h"
+
+namespace Trinity
+{
+	ReadbackBuffer::~ReadbackBuffer()
+	{
+		destroy();
+	}
+
+	bool ReadbackBuffer::create(uint32_t size)
+	{
+		const wgpu::Device& device = GraphicsDevice::get();
+		mSize = size;
+
+		wgpu::BufferDescriptor bufferDescriptor{};
+		bufferDescriptor.usage = wgpu::BufferUsage::MapRead | wgpu::BufferUsage::CopyDst;
+		bufferDescriptor.size = mSize;
+		bufferDescriptor.mappedAtCreation = false;
+
+		mHandle = device.CreateBuffer(&bufferDescriptor);
+		if (!mHandle)
+		{
+			LogError("wgpu::Device::CreateBuffer() failed!!");
+			return false;
+		}
+
+		return true;
+	}
+
+	void ReadbackBuffer::destroy()
+	{
+		if (mHandle)
+		{
+			mHandle.Destroy();
+			mHandle = nullptr;
+		}
+	}
+}
\ No newline at end of file
@@ -32,23 +32,8 @@ namespace Trinity
             renderPassDesc.depthStencilAttachment = &depthStencilAttachment;
         }
 
-        auto& graphicsDevice = GraphicsDevice::get();
-        mCommandEncoder = graphicsDevice.getDevice().CreateCommandEncoder();
-
-        if (!mCommandEncoder)
-        {
-            LogError("Device::CreateCommandEncoder() failed");
-            return false;
-        }
-
-        mRenderPassEncoder = mCommandEncoder.BeginRenderPass(&renderPassDesc);
-        if (!mRenderPassEncoder)
-        {
-            LogError("wgpu::CommandEncoder::BeginRenderPass() failed!!");
-            return false;
-        }
-
-        return true;
+        mFrameBuffer = &frameBuffer;
+        return begin(renderPassDesc);
     }
 
     bool RenderPass::begin()
@@ -68,19 +53,81 @@ namespace Trinity
             .colorAttachments = &colorAttachment
         };
 
+        wgpu::RenderPassDepthStencilAttachment depthStencilAttachment = {
+            .view = swapChain.getDepthStencilView(),
+            .depthLoadOp = wgpu::LoadOp::Clear,
+            .depthStoreOp = wgpu::StoreOp::Store,
+            .depthClearValue = 1.0f
+        };
+
         if (swapChain.hasDepthStencilAttachment())
         {
-            wgpu::RenderPassDepthStencilAttachment depthStencilAttachment = {
+            renderPassDesc.depthStencilAttachment = &depthStencilAttachment;
+        }
+
+        mFrameBuffer = nullptr;
+        return begin(renderPassDesc);
+    }
+
+    bool RenderPass::resume()
+    {
+        // same attachments as the last begin(), but everything rendered so far is loaded back
+        std::vector<wgpu::RenderPassColorAttachment> colorAttachments;
+        wgpu::RenderPassDepthStencilAttachment depthStencilAttachment{};
+        bool hasDepthStencilAttachment{ false };
+
+        if (mFrameBuffer != nullptr)
+        {
+            colorAttachments = mFrameBuffer->getColorAttachments();
+            depthStencilAttachment = mFrameBuffer->getDepthAttachment();
+            hasDepthStencilAttachment = mFrameBuffer->hasDepthStencilAttachment();
+        }
+        else
+        {
+            auto& swapChain = GraphicsDevice::get().getSwapChain();
+
+            colorAttachments.push_back({
+                .view = swapChain.getCurrentView(),
+                .storeOp = wgpu::StoreOp::Store
+            });
+
+            depthStencilAttachment = {
                 .view = swapChain.getDepthStencilView(),
-                .depthLoadOp = wgpu::LoadOp::Clear,
-                .depthStoreOp = wgpu::StoreOp::Store,
-                .depthClearValue = 1.0f
+                .depthStoreOp = wgpu::StoreOp::Store
             };
 
+            hasDepthStencilAttachment = swapChain.hasDepthStencilAttachment();
+        }
+
+        for (auto& colorAttachment : colorAttachments)
+        {
+            colorAttachment.loadOp = wgpu::LoadOp::Load;
+        }
+
+        wgpu::RenderPassDescriptor renderPassDesc = {
+            .colorAttachmentCount = (uint32_t)colorAttachments.size(),
+            .colorAttachments = colorAttachments.data()
+        };
+
+        if (hasDepthStencilAttachment)
+        {
+            depthStencilAttachment.depthLoadOp = wgpu::LoadOp::Load;
+            if (depthStencilAttachment.stencilLoadOp != wgpu::LoadOp::Undefined)
+            {
+                depthStencilAttachment.stencilLoadOp = wgpu::LoadOp::Load;
+            }
+
             renderPassDesc.depthStencilAttachment = &depthStencilAttachment;
         }
-                
+
+        return begin(renderPassDesc);
+    }
+
+    bool RenderPass::begin(const wgpu::RenderPassDescriptor& renderPassDesc)
+    {
+        auto& graphicsDevice = GraphicsDevice::get();
         mCommandEncoder = graphicsDevice.getDevice().CreateCommandEncoder();
+
         if (!mCommandEncoder)
         {
             LogError("Device::CreateCommandEncoder() failed");
@@ -126,12 +173,31 @@ namespace Trinity
         mRenderPassEncoder.DrawIndexed(indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
     }
 
+    void RenderPass::drawIndirect(const Buffer& indirectBuffer, uint64_t indirectOffset) const
+    {
+        Assert(mRenderPassEncoder != nullptr, "RenderPass::begin() not called!!");
+        mRenderPassEncoder.DrawIndirect(indirectBuffer.getHandle(), indirectOffset);
+    }
+
+    void RenderPass::drawIndexedIndirect(const Buffer& indirectBuffer, uint64_t indirectOffset) const
+    {
+        Assert(mRenderPassEncoder != nullptr, "RenderPass::begin() not called!!");
+        mRenderPassEncoder.DrawIndexedIndirect(indirectBuffer.getHandle(), indirectOffset);
+    }
+
     void RenderPass::setBindGroup(uint32_t groupIndex, const BindGroup& bindGroup) const
     {
         Assert(mRenderPassEncoder != nullptr, "RenderPass::begin() not called!!");
         mRenderPassEncoder.SetBindGroup(groupIndex, bindGroup.getHandle());
     }
 
+    void RenderPass::setBindGroup(uint32_t groupIndex, const BindGroup& bindGroup, uint32_t dynamicOffsetCount,
+        const uint32_t* dynamicOffsets) const
+    {
+        Assert(mRenderPassEncoder != nullptr, "RenderPass::begin() not called!!");
+        mRenderPassEncoder.SetBindGroup(groupIndex, bindGroup.getHandle(), dynamicOffsetCount, dynamicOffsets);
+    }
+
     void RenderPass::setPipeline(const RenderPipeline& pipeline) const
     {
         Assert(mRenderPassEncoder != nullptr, "RenderPass::begin() not called!!");
@@ -91,6 +91,12 @@ namespace Trinity
             .fragment = &fragment
         };
 
+        // depth only pipelines leave out the fragment stage
+        if (renderProps.fsEntry.empty())
+        {
+            pipelineDesc.fragment = nullptr;
+        }
+
         if (renderProps.depthStencil)
         {
             const DepthStencilState& depthStencil = *renderProps.depthStencil;
@@ -5,6 +5,7 @@
 #include "Core/Logger.h"
 #include "Core/ResourceCache.h"
 #include "Utils/StringHelper.h"
+#include "Utils/HashHelper.h"
 #include <sstream>
 
 namespace Trinity
@@ -218,6 +219,8 @@ namespace Trinity
 	void Shader::destroy()
 	{
 		mHandle = nullptr;
+		mSource.clear();
+		mSourceHash = 0;
 	}
 
 	bool Shader::write()
@@ -254,6 +257,8 @@ namespace Trinity
 			return false;
 		}
 
+		mSource = source;
+		mSourceHash = HashHelper::hash(source);
 		return true;
 	}
 
@@ -40,7 +40,7 @@ namespace Trinity
         {
             wgpu::TextureDescriptor textureDesc = {
                 .label = "SwapChain.DepthTexture",
-                .usage = wgpu::TextureUsage::RenderAttachment,
+                .usage = wgpu::TextureUsage::RenderAttachment | wgpu::TextureUsage::TextureBinding,
                 .size = {
                     .width = mWidth,
                     .height = mHeight,
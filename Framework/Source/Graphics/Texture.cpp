@@ -2,6 +2,7 @@
 #include "VFS/FileReader.h"
 #include "VFS/FileWriter.h"
 #include "Core/ResourceCache.h"
+#include <algorithm>
 
 namespace Trinity
 {
@@ -25,6 +26,40 @@ namespace Trinity
         return typeid(Texture);
     }
 
+    uint64_t Texture::getGpuMemorySize() const
+    {
+        if (!mHandle)
+        {
+            return 0;
+        }
+
+        uint64_t width = mHandle.GetWidth();
+        uint64_t height = mHandle.GetHeight();
+        uint64_t size{ 0 };
+
+        for (uint32_t level = 0; level < mHandle.GetMipLevelCount(); level++)
+        {
+            size += width * height;
+            width = std::max(width / 2, 1ull);
+            height = std::max(height / 2, 1ull);
+        }
+
+        return size * mHandle.GetDepthOrArrayLayers() * getBitsPerPixel(mHandle.GetFormat()) / 8;
+    }
+
+    uint32_t Texture::getEvictionPriority() const
+    {
+        return 0;
+    }
+
+	bool Texture::getDependencies(FileReader& reader, std::vector<ResourceDependency>& dependencies)
+	{
+        reader.read((uint32_t*)&mTextureType);
+        reader.read((uint32_t*)&mFormat);
+
+        return true;
+	}
+
 	bool Texture::read(FileReader& reader, ResourceCache& cache)
 	{
         reader.read((uint32_t*)&mTextureType);
@@ -40,4 +75,62 @@ namespace Trinity
 
         return true;
 	}
+
+    uint32_t Texture::getBitsPerPixel(wgpu::TextureFormat format)
+    {
+        switch (format)
+        {
+        case wgpu::TextureFormat::R8Unorm:
+        case wgpu::TextureFormat::R8Snorm:
+        case wgpu::TextureFormat::R8Uint:
+        case wgpu::TextureFormat::R8Sint:
+        case wgpu::TextureFormat::Stencil8:
+            return 8;
+
+        case wgpu::TextureFormat::R16Uint:
+        case wgpu::TextureFormat::R16Sint:
+        case wgpu::TextureFormat::R16Float:
+        case wgpu::TextureFormat::RG8Unorm:
+        case wgpu::TextureFormat::RG8Snorm:
+        case wgpu::TextureFormat::RG8Uint:
+        case wgpu::TextureFormat::RG8Sint:
+        case wgpu::TextureFormat::Depth16Unorm:
+            return 16;
+
+        case wgpu::TextureFormat::RG32Float:
+        case wgpu::TextureFormat::RG32Uint:
+        case wgpu::TextureFormat::RG32Sint:
+        case wgpu::TextureFormat::RGBA16Uint:
+        case wgpu::TextureFormat::RGBA16Sint:
+        case wgpu::TextureFormat::RGBA16Float:
+        case wgpu::TextureFormat::Depth32FloatStencil8:
+            return 64;
+
+        case wgpu::TextureFormat::RGBA32Float:
+        case wgpu::TextureFormat::RGBA32Uint:
+        case wgpu::TextureFormat::RGBA32Sint:
+            return 128;
+
+        case wgpu::TextureFormat::BC1RGBAUnorm:
+        case wgpu::TextureFormat::BC1RGBAUnormSrgb:
+        case wgpu::TextureFormat::BC4RUnorm:
+        case wgpu::TextureFormat::BC4RSnorm:
+            return 4;
+
+        case wgpu::TextureFormat::BC2RGBAUnorm:
+        case wgpu::TextureFormat::BC2RGBAUnormSrgb:
+        case wgpu::TextureFormat::BC3RGBAUnorm:
+        case wgpu::TextureFormat::BC3RGBAUnormSrgb:
+        case wgpu::TextureFormat::BC5RGUnorm:
+        case wgpu::TextureFormat::BC5RGSnorm:
+        case wgpu::TextureFormat::BC6HRGBUfloat:
+        case wgpu::TextureFormat::BC6HRGBFloat:
+        case wgpu::TextureFormat::BC7RGBAUnorm:
+        case wgpu::TextureFormat::BC7RGBAUnormSrgb:
+            return 8;
+
+        default:
+            return 32;
+        }
+    }
 }
\ No newline at end of file
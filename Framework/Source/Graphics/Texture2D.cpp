@@ -16,6 +16,7 @@ namespace Trinity
 	void Texture2D::destroy()
 	{
 		Texture::destroy();
+		releaseResourceRef(mImage);
 
 		if (mHandle)
 		{
@@ -84,7 +85,7 @@ namespace Trinity
 		const wgpu::Device& device = GraphicsDevice::get();
 		const wgpu::Queue& queue = GraphicsDevice::get().getQueue();
 
-		mImage = image;
+		setResourceRef(mImage, image);
 		mFormat = format;
 		mHasMipmaps = hasMipmaps;
 		mWidth = image->getWidth();
@@ -183,7 +184,7 @@ namespace Trinity
 
 	void Texture2D::setImage(Image* image)
 	{
-		mImage = image;
+		setResourceRef(mImage, image);
 	}
 
 	void Texture2D::setHasMipmaps(bool hasMipmaps)
@@ -191,6 +192,29 @@ namespace Trinity
 		mHasMipmaps = hasMipmaps;
 	}
 
+	bool Texture2D::getDependencies(FileReader& reader, std::vector<ResourceDependency>& dependencies)
+	{
+		if (!Texture::getDependencies(reader, dependencies))
+		{
+			return false;
+		}
+
+		reader.read(&mHasMipmaps);
+
+		auto imageFileName = Resource::getReadPath(reader.getPath(), reader.readString());
+		if (!imageFileName.empty())
+		{
+			dependencies.push_back({
+				.fileName = imageFileName,
+				.creator = []() -> std::unique_ptr<Resource> {
+					return std::make_unique<Image>();
+				}
+			});
+		}
+
+		return true;
+	}
+
 	bool Texture2D::read(FileReader& reader, ResourceCache& cache)
 	{
 		if (!Texture::read(reader, cache))
@@ -16,6 +16,7 @@ namespace Trinity
 	void TextureCube::destroy()
 	{
 		Texture::destroy();
+		setImages({});
 
 		if (mHandle)
 		{
@@ -43,7 +44,7 @@ namespace Trinity
 		const wgpu::Device& device = GraphicsDevice::get();
 		const wgpu::Queue& queue = GraphicsDevice::get().getQueue();
 
-		mImages = images;
+		setImages(std::vector<Image*>(images));
 		mFormat = format;
 		mSize = images[0]->getWidth();
 
@@ -107,7 +108,7 @@ namespace Trinity
 			image->convertToCube();
 		}
 
-		mImages = { image };
+		setImages({ image });
 		mSize = image->getWidth();
 		mFormat = format;
 
@@ -193,9 +194,42 @@ namespace Trinity
 
 	void TextureCube::setImages(std::vector<Image*>&& images)
 	{
+		for (auto* image : images)
+		{
+			image->addRef();
+		}
+
+		for (auto* image : mImages)
+		{
+			image->release();
+		}
+
 		mImages = std::move(images);
 	}
 
+	bool TextureCube::getDependencies(FileReader& reader, std::vector<ResourceDependency>& dependencies)
+	{
+		if (!Texture::getDependencies(reader, dependencies))
+		{
+			return false;
+		}
+
+		uint32_t numImages{ 0 };
+		reader.read(&numImages);
+
+		for (uint32_t idx = 0; idx < numImages; idx++)
+		{
+			dependencies.push_back({
+				.fileName = Resource::getReadPath(reader.getPath(), reader.readString()),
+				.creator = []() -> std::unique_ptr<Resource> {
+					return std::make_unique<Image>();
+				}
+			});
+		}
+
+		return true;
+	}
+
 	bool TextureCube::read(FileReader& reader, ResourceCache& cache)
 	{
 		if (!Texture::read(reader, cache))
@@ -0,0 +1,83 @@
+#include "Graphics/UniformAllocator.h"
+#include "Core/Logger.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Trinity
+{
+    UniformAllocator::~UniformAllocator()
+    {
+        destroy();
+    }
+
+    bool UniformAllocator::create(uint32_t frameSize, uint32_t maxBindingSize)
+    {
+        mFrameSize = align(std::max(frameSize, 1u));
+        mFrameIndex = 0;
+        mHead = 0;
+
+        // every frame in flight gets its own region of the buffer, so a single bind group
+        // serves all of them and the dynamic offsets carry the frame base, the tail keeps
+        // bindings larger than their allocation inside the buffer
+        mBuffer = std::make_unique<UniformBuffer>();
+        if (!mBuffer->create(mFrameSize * kFramesInFlight + align(maxBindingSize)))
+        {
+            LogError("UniformBuffer::create() failed!!");
+            return false;
+        }
+
+        mData.resize(mFrameSize);
+        return true;
+    }
+
+    void UniformAllocator::destroy()
+    {
+        mBuffer = nullptr;
+        mData.clear();
+        mFrameSize = 0;
+        mFrameIndex = 0;
+        mHead = 0;
+    }
+
+    void UniformAllocator::begin()
+    {
+        mFrameIndex = (mFrameIndex + 1) % kFramesInFlight;
+        mHead = 0;
+    }
+
+    void* UniformAllocator::allocate(uint32_t size, uint32_t& offset)
+    {
+        const uint32_t alignedSize = align(size);
+        if (mHead + alignedSize > mFrameSize)
+        {
+            LogError("UniformAllocator::allocate() failed, frame size of %d bytes exceeded!!", mFrameSize);
+            offset = kInvalidOffset;
+            return nullptr;
+        }
+
+        void* result = mData.data() + mHead;
+        offset = mFrameIndex * mFrameSize + mHead;
+        mHead += alignedSize;
+
+        return result;
+    }
+
+    uint32_t UniformAllocator::allocate(uint32_t size, const void* data)
+    {
+        uint32_t offset{ kInvalidOffset };
+        if (void* dst = allocate(size, offset))
+        {
+            std::memcpy(dst, data, size);
+        }
+
+        return offset;
+    }
+
+    void UniformAllocator::upload()
+    {
+        if (mHead > 0)
+        {
+            mBuffer->write(mFrameIndex * mFrameSize, mHead, mData.data());
+        }
+    }
+}
@@ -12,7 +12,7 @@ namespace Trinity
         return typeid(VertexLayout);
     }
 
-    void VertexLayout::setAttributes(std::vector<wgpu::VertexAttribute> attributes)
+    void VertexLayout::setAttributes(std::vector<wgpu::VertexAttribute> attributes, uint32_t stride)
     {
         mAttributes = std::move(attributes);
         mSize = 0;
@@ -49,14 +49,41 @@ namespace Trinity
                 mSize += 16;
                 break;
 
+            case wgpu::VertexFormat::Uint8x4:
+                mSize += 4;
+                break;
+
             case wgpu::VertexFormat::Unorm8x4:
                 mSize += 4;
+                break;
+
+            case wgpu::VertexFormat::Snorm16x2:
+                mSize += 4;
+                break;
+
+            case wgpu::VertexFormat::Snorm16x4:
+                mSize += 8;
+                break;
+
+            case wgpu::VertexFormat::Unorm16x2:
+                mSize += 4;
+                break;
+
+            case wgpu::VertexFormat::Unorm16x4:
+                mSize += 8;
+                break;
 
             default:
                 break;
             }
         }
 
+        // an explicit stride reads a subset of the attributes out of a wider vertex
+        if (stride > 0)
+        {
+            mSize = stride;
+        }
+
         mBufferLayout = {
             .arrayStride = mSize,
             .stepMode = wgpu::VertexStepMode::Vertex,
@@ -5,6 +5,7 @@
 #include "Graphics/Sampler.h"
 #include "Graphics/Shader.h"
 #include "Graphics/RenderPipeline.h"
+#include "Graphics/PipelineCache.h"
 #include "Graphics/UniformBuffer.h"
 #include "Graphics/BindGroup.h"
 #include "Graphics/BindGroupLayout.h"
@@ -509,17 +510,16 @@ namespace Trinity
 			};
 		}
 
-		auto pipeline = std::make_unique<RenderPipeline>();
-		if (!pipeline->create(renderProps))
+		auto* pipeline = PipelineCache::get().getRenderPipeline(renderProps);
+		if (!pipeline)
 		{
-			LogError("RenderPipeline::create() failed!!");
+			LogError("PipelineCache::getRenderPipeline() failed!!");
 			return false;
 		}
 
 		mRenderContext.shader = shader.get();
-		mRenderContext.pipeline = pipeline.get();
+		mRenderContext.pipeline = pipeline;
 		mResourceCache->addResource(std::move(shader));
-		mResourceCache->addResource(std::move(pipeline));
 
 		return true;
 	}
@@ -0,0 +1,234 @@
+#include "Math/BoundingBoxBatch.h"
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define TRINITY_BATCH_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TRINITY_BATCH_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define TRINITY_BATCH_NEON
+#endif
+
+namespace Trinity
+{
+	struct FrustumPlanes
+	{
+		float normal[3][6];
+		float absNormal[3][6];
+		float distance[6];
+	};
+
+	static FrustumPlanes getFrustumPlanes(const Frustum& frustum)
+	{
+		FrustumPlanes result{};
+
+		for (uint32_t idx = 0; idx < 6; idx++)
+		{
+			for (uint32_t axis = 0; axis < 3; axis++)
+			{
+				result.normal[axis][idx] = frustum.planes[idx][axis];
+				result.absNormal[axis][idx] = std::abs(frustum.planes[idx][axis]);
+			}
+
+			result.distance[idx] = frustum.planes[idx].w;
+		}
+
+		return result;
+	}
+
+	void BoundingBoxBatch::clear()
+	{
+		resize(0);
+	}
+
+	void BoundingBoxBatch::resize(uint32_t size)
+	{
+		const uint32_t paddedSize = (size + kBatchWidth - 1) / kBatchWidth * kBatchWidth;
+
+		for (uint32_t axis = 0; axis < 3; axis++)
+		{
+			mCenters[axis].resize(paddedSize);
+			mExtents[axis].resize(paddedSize);
+		}
+
+		mSize = size;
+	}
+
+	void BoundingBoxBatch::add(const BoundingBox& box)
+	{
+		resize(mSize + 1);
+		set(mSize - 1, box);
+	}
+
+	void BoundingBoxBatch::set(uint32_t idx, const BoundingBox& box)
+	{
+		const glm::vec3 center = 0.5f * (box.max + box.min);
+		const glm::vec3 extents = 0.5f * (box.max - box.min);
+
+		for (uint32_t axis = 0; axis < 3; axis++)
+		{
+			mCenters[axis][idx] = center[axis];
+			mExtents[axis][idx] = extents[axis];
+		}
+	}
+
+	void BoundingBoxBatch::prepareVisibility(std::vector<uint64_t>& visibility) const
+	{
+		visibility.assign(((size_t)mSize + 63) / 64, 0);
+	}
+
+	void BoundingBoxBatch::cullScalar(const Frustum& frustum, std::vector<uint64_t>& visibility) const
+	{
+		const auto planes = getFrustumPlanes(frustum);
+		prepareVisibility(visibility);
+
+		for (uint32_t idx = 0; idx < mSize; idx++)
+		{
+			bool visible{ true };
+
+			for (uint32_t plane = 0; plane < 6 && visible; plane++)
+			{
+				const float distance = mCenters[0][idx] * planes.normal[0][plane] +
+					mCenters[1][idx] * planes.normal[1][plane] +
+					mCenters[2][idx] * planes.normal[2][plane] + planes.distance[plane];
+
+				const float radius = mExtents[0][idx] * planes.absNormal[0][plane] +
+					mExtents[1][idx] * planes.absNormal[1][plane] +
+					mExtents[2][idx] * planes.absNormal[2][plane];
+
+				visible = distance + radius >= 0.0f;
+			}
+
+			if (visible)
+			{
+				visibility[idx >> 6] |= 1ull << (idx & 63);
+			}
+		}
+	}
+
+	void BoundingBoxBatch::cull(const Frustum& frustum, std::vector<uint64_t>& visibility) const
+	{
+#if defined(TRINITY_BATCH_AVX) || defined(TRINITY_BATCH_SSE) || defined(TRINITY_BATCH_NEON)
+		const auto planes = getFrustumPlanes(frustum);
+		prepareVisibility(visibility);
+
+		if (mSize == 0)
+		{
+			return;
+		}
+
+		// padding never crosses into an extra word since 64 is a multiple of the batch width,
+		// the bits of the zeroed padding lanes are masked off at the end
+		const uint32_t paddedSize = (uint32_t)mCenters[0].size();
+
+#if defined(TRINITY_BATCH_AVX)
+		for (uint32_t idx = 0; idx < paddedSize; idx += 8)
+		{
+			const __m256 cx = _mm256_loadu_ps(&mCenters[0][idx]);
+			const __m256 cy = _mm256_loadu_ps(&mCenters[1][idx]);
+			const __m256 cz = _mm256_loadu_ps(&mCenters[2][idx]);
+			const __m256 ex = _mm256_loadu_ps(&mExtents[0][idx]);
+			const __m256 ey = _mm256_loadu_ps(&mExtents[1][idx]);
+			const __m256 ez = _mm256_loadu_ps(&mExtents[2][idx]);
+
+			__m256 outside = _mm256_setzero_ps();
+
+			for (uint32_t plane = 0; plane < 6; plane++)
+			{
+				__m256 distance = _mm256_add_ps(_mm256_mul_ps(cx, _mm256_set1_ps(planes.normal[0][plane])),
+					_mm256_mul_ps(cy, _mm256_set1_ps(planes.normal[1][plane])));
+				distance = _mm256_add_ps(distance, _mm256_mul_ps(cz, _mm256_set1_ps(planes.normal[2][plane])));
+				distance = _mm256_add_ps(distance, _mm256_set1_ps(planes.distance[plane]));
+
+				__m256 radius = _mm256_add_ps(_mm256_mul_ps(ex, _mm256_set1_ps(planes.absNormal[0][plane])),
+					_mm256_mul_ps(ey, _mm256_set1_ps(planes.absNormal[1][plane])));
+				radius = _mm256_add_ps(radius, _mm256_mul_ps(ez, _mm256_set1_ps(planes.absNormal[2][plane])));
+
+				outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), _mm256_setzero_ps(), _CMP_LT_OQ));
+			}
+
+			const uint64_t bits = (uint64_t)(~_mm256_movemask_ps(outside) & 0xff);
+			visibility[idx >> 6] |= bits << (idx & 63);
+		}
+#elif defined(TRINITY_BATCH_SSE)
+		for (uint32_t idx = 0; idx < paddedSize; idx += 4)
+		{
+			const __m128 cx = _mm_loadu_ps(&mCenters[0][idx]);
+			const __m128 cy = _mm_loadu_ps(&mCenters[1][idx]);
+			const __m128 cz = _mm_loadu_ps(&mCenters[2][idx]);
+			const __m128 ex = _mm_loadu_ps(&mExtents[0][idx]);
+			const __m128 ey = _mm_loadu_ps(&mExtents[1][idx]);
+			const __m128 ez = _mm_loadu_ps(&mExtents[2][idx]);
+
+			__m128 outside = _mm_setzero_ps();
+
+			for (uint32_t plane = 0; plane < 6; plane++)
+			{
+				__m128 distance = _mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(planes.normal[0][plane])),
+					_mm_mul_ps(cy, _mm_set1_ps(planes.normal[1][plane])));
+				distance = _mm_add_ps(distance, _mm_mul_ps(cz, _mm_set1_ps(planes.normal[2][plane])));
+				distance = _mm_add_ps(distance, _mm_set1_ps(planes.distance[plane]));
+
+				__m128 radius = _mm_add_ps(_mm_mul_ps(ex, _mm_set1_ps(planes.absNormal[0][plane])),
+					_mm_mul_ps(ey, _mm_set1_ps(planes.absNormal[1][plane])));
+				radius = _mm_add_ps(radius, _mm_mul_ps(ez, _mm_set1_ps(planes.absNormal[2][plane])));
+
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+			}
+
+			const uint64_t bits = (uint64_t)(~_mm_movemask_ps(outside) & 0xf);
+			visibility[idx >> 6] |= bits << (idx & 63);
+		}
+#elif defined(TRINITY_BATCH_NEON)
+		const uint32_t laneBits[4] = { 1, 2, 4, 8 };
+		const uint32x4_t laneMask = vld1q_u32(laneBits);
+
+		for (uint32_t idx = 0; idx < paddedSize; idx += 4)
+		{
+			const float32x4_t cx = vld1q_f32(&mCenters[0][idx]);
+			const float32x4_t cy = vld1q_f32(&mCenters[1][idx]);
+			const float32x4_t cz = vld1q_f32(&mCenters[2][idx]);
+			const float32x4_t ex = vld1q_f32(&mExtents[0][idx]);
+			const float32x4_t ey = vld1q_f32(&mExtents[1][idx]);
+			const float32x4_t ez = vld1q_f32(&mExtents[2][idx]);
+
+			uint32x4_t outside = vdupq_n_u32(0);
+
+			for (uint32_t plane = 0; plane < 6; plane++)
+			{
+				float32x4_t distance = vmulq_n_f32(cx, planes.normal[0][plane]);
+				distance = vaddq_f32(distance, vmulq_n_f32(cy, planes.normal[1][plane]));
+				distance = vaddq_f32(distance, vmulq_n_f32(cz, planes.normal[2][plane]));
+				distance = vaddq_f32(distance, vdupq_n_f32(planes.distance[plane]));
+
+				float32x4_t radius = vmulq_n_f32(ex, planes.absNormal[0][plane]);
+				radius = vaddq_f32(radius, vmulq_n_f32(ey, planes.absNormal[1][plane]));
+				radius = vaddq_f32(radius, vmulq_n_f32(ez, planes.absNormal[2][plane]));
+
+				outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(distance, radius), vdupq_n_f32(0.0f)));
+			}
+
+			const uint32x4_t outsideBits = vandq_u32(outside, laneMask);
+#if defined(__aarch64__)
+			const uint32_t mask = vaddvq_u32(outsideBits);
+#else
+			const uint32_t mask = vgetq_lane_u32(outsideBits, 0) | vgetq_lane_u32(outsideBits, 1) |
+				vgetq_lane_u32(outsideBits, 2) | vgetq_lane_u32(outsideBits, 3);
+#endif
+			const uint64_t bits = (uint64_t)(~mask & 0xf);
+			visibility[idx >> 6] |= bits << (idx & 63);
+		}
+#endif
+
+		if ((mSize & 63) != 0)
+		{
+			visibility.back() &= (1ull << (mSize & 63)) - 1;
+		}
+#else
+		cullScalar(frustum, visibility);
+#endif
+	}
+}
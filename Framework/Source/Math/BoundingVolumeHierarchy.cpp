@@ -0,0 +1,313 @@
+#include "Math/BoundingVolumeHierarchy.h"
+#include <algorithm>
+#include <utility>
+
+namespace Trinity
+{
+	static BoundingBox combine(const BoundingBox& a, const BoundingBox& b)
+	{
+		return { glm::min(a.min, b.min), glm::max(a.max, b.max) };
+	}
+
+	static float getSurfaceArea(const BoundingBox& box)
+	{
+		const glm::vec3 size = box.max - box.min;
+		return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+	}
+
+	uint32_t BoundingVolumeHierarchy::createProxy(const BoundingBox& bounds, uint32_t userData)
+	{
+		const uint32_t proxyId = allocateNode();
+		auto& node = mNodes[proxyId];
+
+		node.bounds = { bounds.min - glm::vec3(mMargin), bounds.max + glm::vec3(mMargin) };
+		node.userData = userData;
+		node.height = 0;
+
+		insertLeaf(proxyId);
+		mNumProxies++;
+
+		return proxyId;
+	}
+
+	void BoundingVolumeHierarchy::destroyProxy(uint32_t proxyId)
+	{
+		removeLeaf(proxyId);
+		freeNode(proxyId);
+		mNumProxies--;
+	}
+
+	bool BoundingVolumeHierarchy::moveProxy(uint32_t proxyId, const BoundingBox& bounds)
+	{
+		if (mNodes[proxyId].bounds.contains(bounds))
+		{
+			return false;
+		}
+
+		removeLeaf(proxyId);
+
+		mNodes[proxyId].bounds = { bounds.min - glm::vec3(mMargin), bounds.max + glm::vec3(mMargin) };
+		insertLeaf(proxyId);
+
+		return true;
+	}
+
+	void BoundingVolumeHierarchy::setMargin(float margin)
+	{
+		mMargin = margin;
+	}
+
+	void BoundingVolumeHierarchy::clear()
+	{
+		mNodes.clear();
+		mRoot = kNullNode;
+		mFreeList = kNullNode;
+		mNumFreeNodes = 0;
+		mNumProxies = 0;
+	}
+
+	bool BoundingVolumeHierarchy::intersectRay(const BoundingBox& bounds, const glm::vec3& origin,
+		const glm::vec3& invDirection, float maxDistance, float& distance)
+	{
+		const glm::vec3 t0 = (bounds.min - origin) * invDirection;
+		const glm::vec3 t1 = (bounds.max - origin) * invDirection;
+		const glm::vec3 tmin = glm::min(t0, t1);
+		const glm::vec3 tmax = glm::max(t0, t1);
+
+		const float enter = std::max(std::max(tmin.x, tmin.y), std::max(tmin.z, 0.0f));
+		const float exit = std::min(std::min(tmax.x, tmax.y), std::min(tmax.z, maxDistance));
+
+		distance = enter;
+		return enter <= exit;
+	}
+
+	uint32_t BoundingVolumeHierarchy::allocateNode()
+	{
+		if (mFreeList == kNullNode)
+		{
+			mNodes.emplace_back();
+			return (uint32_t)mNodes.size() - 1;
+		}
+
+		const uint32_t nodeId = mFreeList;
+		mFreeList = mNodes[nodeId].parent;
+		mNumFreeNodes--;
+
+		mNodes[nodeId] = {};
+		return nodeId;
+	}
+
+	void BoundingVolumeHierarchy::freeNode(uint32_t nodeId)
+	{
+		auto& node = mNodes[nodeId];
+		node.parent = mFreeList;
+		node.left = kNullNode;
+		node.right = kNullNode;
+		node.height = -1;
+
+		mFreeList = nodeId;
+		mNumFreeNodes++;
+	}
+
+	void BoundingVolumeHierarchy::insertLeaf(uint32_t leaf)
+	{
+		if (mRoot == kNullNode)
+		{
+			mRoot = leaf;
+			mNodes[leaf].parent = kNullNode;
+			return;
+		}
+
+		// walk down picking the child with the smallest surface area increase
+		const BoundingBox leafBounds = mNodes[leaf].bounds;
+		uint32_t index = mRoot;
+
+		while (!mNodes[index].isLeaf())
+		{
+			const auto& node = mNodes[index];
+			const float area = getSurfaceArea(node.bounds);
+			const float combinedArea = getSurfaceArea(combine(node.bounds, leafBounds));
+
+			const float cost = 2.0f * combinedArea;
+			const float inheritanceCost = 2.0f * (combinedArea - area);
+
+			auto getCost = [&](uint32_t child) {
+				const auto& childNode = mNodes[child];
+				const float childArea = getSurfaceArea(combine(childNode.bounds, leafBounds));
+
+				return childNode.isLeaf() ? childArea + inheritanceCost :
+					childArea - getSurfaceArea(childNode.bounds) + inheritanceCost;
+			};
+
+			const float leftCost = getCost(node.left);
+			const float rightCost = getCost(node.right);
+
+			if (cost < leftCost && cost < rightCost)
+			{
+				break;
+			}
+
+			index = leftCost < rightCost ? node.left : node.right;
+		}
+
+		const uint32_t sibling = index;
+		const uint32_t oldParent = mNodes[sibling].parent;
+		const uint32_t newParent = allocateNode();
+
+		mNodes[newParent].parent = oldParent;
+		mNodes[newParent].bounds = combine(leafBounds, mNodes[sibling].bounds);
+		mNodes[newParent].height = mNodes[sibling].height + 1;
+		mNodes[newParent].left = sibling;
+		mNodes[newParent].right = leaf;
+
+		if (oldParent != kNullNode)
+		{
+			if (mNodes[oldParent].left == sibling)
+			{
+				mNodes[oldParent].left = newParent;
+			}
+			else
+			{
+				mNodes[oldParent].right = newParent;
+			}
+		}
+		else
+		{
+			mRoot = newParent;
+		}
+
+		mNodes[sibling].parent = newParent;
+		mNodes[leaf].parent = newParent;
+
+		for (index = mNodes[leaf].parent; index != kNullNode; index = mNodes[index].parent)
+		{
+			index = balance(index);
+
+			auto& node = mNodes[index];
+			node.height = 1 + std::max(mNodes[node.left].height, mNodes[node.right].height);
+			node.bounds = combine(mNodes[node.left].bounds, mNodes[node.right].bounds);
+		}
+	}
+
+	void BoundingVolumeHierarchy::removeLeaf(uint32_t leaf)
+	{
+		if (leaf == mRoot)
+		{
+			mRoot = kNullNode;
+			return;
+		}
+
+		const uint32_t parent = mNodes[leaf].parent;
+		const uint32_t grandParent = mNodes[parent].parent;
+		const uint32_t sibling = mNodes[parent].left == leaf ? mNodes[parent].right : mNodes[parent].left;
+
+		freeNode(parent);
+
+		if (grandParent == kNullNode)
+		{
+			mRoot = sibling;
+			mNodes[sibling].parent = kNullNode;
+			return;
+		}
+
+		if (mNodes[grandParent].left == parent)
+		{
+			mNodes[grandParent].left = sibling;
+		}
+		else
+		{
+			mNodes[grandParent].right = sibling;
+		}
+
+		mNodes[sibling].parent = grandParent;
+
+		for (uint32_t index = grandParent; index != kNullNode; index = mNodes[index].parent)
+		{
+			index = balance(index);
+
+			auto& node = mNodes[index];
+			node.height = 1 + std::max(mNodes[node.left].height, mNodes[node.right].height);
+			node.bounds = combine(mNodes[node.left].bounds, mNodes[node.right].bounds);
+		}
+	}
+
+	uint32_t BoundingVolumeHierarchy::balance(uint32_t nodeId)
+	{
+		auto& a = mNodes[nodeId];
+		if (a.isLeaf() || a.height < 2)
+		{
+			return nodeId;
+		}
+
+		const uint32_t b = a.left;
+		const uint32_t c = a.right;
+		const int32_t balanceFactor = mNodes[c].height - mNodes[b].height;
+
+		// rotate the taller child up, moving its shorter grandchild under nodeId
+		auto rotate = [&](uint32_t upper, uint32_t other, bool upperIsRight) -> uint32_t {
+			auto& up = mNodes[upper];
+			const uint32_t f = up.left;
+			const uint32_t g = up.right;
+
+			up.left = nodeId;
+			up.parent = a.parent;
+			a.parent = upper;
+
+			if (up.parent != kNullNode)
+			{
+				if (mNodes[up.parent].left == nodeId)
+				{
+					mNodes[up.parent].left = upper;
+				}
+				else
+				{
+					mNodes[up.parent].right = upper;
+				}
+			}
+			else
+			{
+				mRoot = upper;
+			}
+
+			uint32_t keep = f;
+			uint32_t move = g;
+			if (mNodes[f].height <= mNodes[g].height)
+			{
+				std::swap(keep, move);
+			}
+
+			up.right = keep;
+
+			if (upperIsRight)
+			{
+				a.right = move;
+			}
+			else
+			{
+				a.left = move;
+			}
+
+			mNodes[move].parent = nodeId;
+
+			a.bounds = combine(mNodes[other].bounds, mNodes[move].bounds);
+			a.height = 1 + std::max(mNodes[other].height, mNodes[move].height);
+
+			up.bounds = combine(a.bounds, mNodes[keep].bounds);
+			up.height = 1 + std::max(a.height, mNodes[keep].height);
+
+			return upper;
+		};
+
+		if (balanceFactor > 1)
+		{
+			return rotate(c, b, true);
+		}
+
+		if (balanceFactor < -1)
+		{
+			return rotate(b, c, false);
+		}
+
+		return nodeId;
+	}
+}
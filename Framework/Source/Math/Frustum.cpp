@@ -40,6 +40,39 @@ namespace Trinity
 		return true;
 	}
 
+	Intersection Frustum::intersect(const BoundingBox& box) const
+	{
+		Intersection result{ Intersection::Inside };
+
+		for (uint32_t i = 0; i < 6; i++)
+		{
+			const glm::vec3 normal{ planes[i] };
+			const glm::vec3 positive{
+				normal.x >= 0.0f ? box.max.x : box.min.x,
+				normal.y >= 0.0f ? box.max.y : box.min.y,
+				normal.z >= 0.0f ? box.max.z : box.min.z
+			};
+
+			if (glm::dot(normal, positive) + planes[i].w < 0.0f)
+			{
+				return Intersection::Outside;
+			}
+
+			const glm::vec3 negative{
+				normal.x >= 0.0f ? box.min.x : box.max.x,
+				normal.y >= 0.0f ? box.min.y : box.max.y,
+				normal.z >= 0.0f ? box.min.z : box.max.z
+			};
+
+			if (glm::dot(normal, negative) + planes[i].w < 0.0f)
+			{
+				result = Intersection::Intersecting;
+			}
+		}
+
+		return result;
+	}
+
 	void Frustum::fromMatrix(const glm::mat4& m)
 	{
 		const glm::mat4 tm = glm::transpose(m);
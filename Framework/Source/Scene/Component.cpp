@@ -10,6 +10,10 @@ namespace Trinity
         mName = name;
     }
 
+	void Component::destroy()
+	{
+	}
+
 	bool Component::read(FileReader& reader, ResourceCache& cache, Scene& scene)
 	{
 		mName = reader.readString();
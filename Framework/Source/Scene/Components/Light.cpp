@@ -24,11 +24,13 @@ namespace Trinity
 	void Light::setLightType(LightType lightType)
 	{
 		mLightType = lightType;
+		mVersion++;
 	}
 
 	void Light::setLightProperties(const LightProperties& properties)
 	{
 		mProperties = properties;
+		mVersion++;
 	}
 
 	bool Light::read(FileReader& reader, ResourceCache& cache, Scene& scene)
@@ -44,6 +46,7 @@ namespace Trinity
 
 		reader.read(&mLightType);
 		reader.read(&mProperties);
+		mVersion++;
 
 		return true;
 	}
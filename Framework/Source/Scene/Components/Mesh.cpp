@@ -7,6 +7,7 @@
 #include "VFS/FileSystem.h"
 #include "Core/ResourceCache.h"
 #include "Core/Logger.h"
+#include <cstring>
 
 namespace Trinity
 {
@@ -25,6 +26,11 @@ namespace Trinity
 		return mModel && mModel->isAnimated();
 	}
 
+	void Mesh::destroy()
+	{
+		releaseResourceRef(mModel);
+	}
+
 	bool Mesh::load(const std::string& modelFileName, ResourceCache& cache, Scene& scene)
 	{
 		if (!cache.isLoaded<Model>(modelFileName))
@@ -39,25 +45,66 @@ namespace Trinity
 			cache.addResource(std::move(model));
 		}
 
-		mModel = cache.getResource<Model>(modelFileName);
+		setModel(*cache.getResource<Model>(modelFileName));
 		const auto& materials = mModel->getMaterials();
 		const auto& meshes = mModel->getMeshes();
 
-		for (const auto& mesh : meshes)
+		for (uint32_t idx = 0; idx < (uint32_t)meshes.size(); idx++)
 		{
+			const auto& mesh = meshes[idx];
 			auto subMesh = std::make_unique<SubMesh>();
 			subMesh->setName(mesh.name);
 			subMesh->setMaterial(*materials[mesh.materialIndex]);
 			subMesh->setVertexLayout(*mesh.vertexLayout);
 			subMesh->setVertexBuffer(*mesh.vertexBuffer);
 
+			if (mesh.positionLayout != nullptr)
+			{
+				subMesh->setPositionLayout(*mesh.positionLayout);
+			}
+
 			if (mesh.numIndices > 0)
 			{
 				subMesh->setIndexBuffer(*mesh.indexBuffer);
 			}
 
+			// the index buffer holds every lod back to back, the full detail one first
 			subMesh->setNumVertices(mesh.numVertices);
-			subMesh->setNumIndices(mesh.numIndices);
+			subMesh->setNumIndices(mesh.lods.empty() ? mesh.numIndices : mesh.lods[0].numIndices);
+			subMesh->setBounds(mesh.bounds);
+			subMesh->setLods(mesh.lods);
+			subMesh->setMeshlets(mesh.meshlets);
+
+			// meshlet culling copies the surviving meshlets out of the full detail lod on the gpu,
+			// which reads 32 bit indices whatever size the index buffer was stored with
+			if (!mesh.meshlets.empty())
+			{
+				std::vector<uint32_t> meshletIndices(subMesh->getNumIndices());
+				for (uint32_t index = 0; index < (uint32_t)meshletIndices.size(); index++)
+				{
+					if (mesh.indexSize == sizeof(uint16_t))
+					{
+						uint16_t value{ 0 };
+						std::memcpy(&value, mesh.indexData.data() + index * sizeof(uint16_t), sizeof(uint16_t));
+						meshletIndices[index] = value;
+					}
+					else
+					{
+						std::memcpy(&meshletIndices[index], mesh.indexData.data() + index * sizeof(uint32_t), sizeof(uint32_t));
+					}
+				}
+
+				subMesh->setMeshletIndices(meshletIndices);
+			}
+
+			if (idx == 0)
+			{
+				mBounds = mesh.bounds;
+			}
+			else
+			{
+				mBounds.combineBox(mesh.bounds);
+			}
 
 			mSubMeshes.push_back(subMesh.get());
 			scene.addComponent(std::move(subMesh));
@@ -93,7 +140,7 @@ namespace Trinity
 
 	void Mesh::setModel(Model& model)
 	{
-		mModel = &model;
+		setResourceRef(mModel, &model);
 	}
 
 	bool Mesh::read(FileReader& reader, ResourceCache& cache, Scene& scene)
@@ -112,6 +159,18 @@ namespace Trinity
 		modelFileName = fileSystem.canonicalPath(modelFileName);
 		modelFileName = fileSystem.sanitizePath(modelFileName);
 
+		if (auto* dependencies = scene.getPendingDependencies(); dependencies != nullptr)
+		{
+			dependencies->push_back({
+				.fileName = modelFileName,
+				.creator = []() -> std::unique_ptr<Resource> {
+					return std::make_unique<Model>();
+				}
+			});
+
+			return true;
+		}
+
 		if (!load(modelFileName, cache, scene))
 		{
 			LogError("Mesh::load() failed for: %s!!", modelFileName.c_str());
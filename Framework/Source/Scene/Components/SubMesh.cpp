@@ -31,6 +31,11 @@ namespace Trinity
 		mVertexBuffer = &vertexBuffer;
 	}
 
+	void SubMesh::setPositionLayout(VertexLayout& positionLayout)
+	{
+		mPositionLayout = &positionLayout;
+	}
+
 	void SubMesh::setIndexBuffer(IndexBuffer& indexBuffer)
 	{
 		mIndexBuffer = &indexBuffer;
@@ -51,6 +56,26 @@ namespace Trinity
 		mNumIndices = numIndices;
 	}
 
+	void SubMesh::setBounds(const BoundingBox& bounds)
+	{
+		mBounds = bounds;
+	}
+
+	void SubMesh::setLods(const std::vector<Model::Lod>& lods)
+	{
+		mLods = lods;
+	}
+
+	void SubMesh::setMeshlets(const std::vector<Model::Meshlet>& meshlets)
+	{
+		mMeshlets = meshlets;
+	}
+
+	void SubMesh::setMeshletIndices(const std::vector<uint32_t>& meshletIndices)
+	{
+		mMeshletIndices = meshletIndices;
+	}
+
 	std::string SubMesh::getStaticType()
 	{
 		return "SubMesh";
@@ -1,6 +1,7 @@
 #include "Scene/Components/Transform.h"
 #include "Scene/Node.h"
 #include "Scene/Scene.h"
+#include "Scene/TransformHierarchy.h"
 #include "Core/Debugger.h"
 #include "Core/ResourceCache.h"
 #include "VFS/FileReader.h"
@@ -19,6 +20,18 @@ namespace Trinity
 		return getStaticType();
 	}
 
+	const glm::mat4& Transform::getWorldMatrix() const
+	{
+		if (mHierarchy != nullptr)
+		{
+			mHierarchy->update();
+			return mHierarchy->getWorldMatrix(mHierarchyIndex);
+		}
+
+		updateWorldTransform();
+		return mWorldMatrix;
+	}
+
 	glm::mat4 Transform::getMatrix() const
 	{
 		return glm::translate(glm::mat4(1.0f), mTranslation) *
@@ -40,6 +53,14 @@ namespace Trinity
 		mNode = &node;
 	}
 
+	void Transform::setHierarchy(TransformHierarchy* hierarchy, uint32_t index)
+	{
+		mHierarchy = hierarchy;
+		mHierarchyIndex = index;
+		mUpdateMatrix = true;
+		mWorldVersion++;
+	}
+
 	void Transform::setTranslation(const glm::vec3& translation)
 	{
 		mTranslation = translation;
@@ -60,7 +81,26 @@ namespace Trinity
 
 	void Transform::invalidateWorldMatrix()
 	{
+		if (mHierarchy != nullptr)
+		{
+			mHierarchy->markDirty(mHierarchyIndex);
+			return;
+		}
+
+		if (mUpdateMatrix)
+		{
+			return;
+		}
+
 		mUpdateMatrix = true;
+
+		if (mNode != nullptr)
+		{
+			for (auto* child : mNode->getChildren())
+			{
+				child->getTransform().invalidateWorldMatrix();
+			}
+		}
 	}
 
 	bool Transform::read(FileReader& reader, ResourceCache& cache, Scene& scene)
@@ -72,13 +112,12 @@ namespace Trinity
 
 		uint32_t nodeId{ 0 };
 		reader.read(&nodeId);
-		mNode = scene.getNode(nodeId);
 
 		reader.read(&mTranslation);
 		reader.read(&mRotation);
 		reader.read(&mScale);
 
-		mUpdateMatrix = true;
+		invalidateWorldMatrix();
 		return true;
 	}
 
@@ -99,7 +138,7 @@ namespace Trinity
 		return true;
 	}
 
-	void Transform::updateWorldTransform()
+	void Transform::updateWorldTransform() const
 	{
 		if (!mUpdateMatrix)
 		{
@@ -116,6 +155,7 @@ namespace Trinity
 		}
 
 		mUpdateMatrix = false;
+		mWorldVersion++;
 	}
 
 	std::string Transform::getStaticType()
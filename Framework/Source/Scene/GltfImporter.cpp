@@ -23,12 +23,16 @@
 #include "Core/Logger.h"
 #include "Core/Debugger.h"
 #include "Core/Image.h"
+#include "Core/ContentManifest.h"
 #include "Core/ResourceCache.h"
 #include "VFS/FileSystem.h"
 #include "VFS/DiskFile.h"
 #include "Utils/StringHelper.h"
+#include "Utils/HashHelper.h"
 #include <format>
 #include <queue>
+#include <tuple>
+#include "meshoptimizer.h"
 
 #define TINYGLTF_NO_STB_IMAGE
 #define TINYGLTF_NO_STB_IMAGE_WRITE
@@ -217,6 +221,276 @@ namespace Trinity
 		return result;
 	}
 
+	void optimizeMesh(Model::Mesh& mesh)
+	{
+		if (mesh.numIndices == 0 || mesh.indexSize != sizeof(uint32_t))
+		{
+			return;
+		}
+
+		std::vector<uint32_t> indices(mesh.numIndices);
+		std::memcpy(indices.data(), mesh.indexData.data(), mesh.indexData.size());
+
+		auto analyze = [&](const std::vector<uint32_t>& source, uint32_t numVertices, const uint8_t* vertices) {
+			const auto* positions = reinterpret_cast<const float*>(vertices);
+			return std::make_tuple(
+				meshopt_analyzeVertexCache(source.data(), source.size(), numVertices,
+					GltfImporter::kVertexCacheSize, 0, 0).acmr,
+				meshopt_analyzeVertexFetch(source.data(), source.size(), numVertices, mesh.vertexSize).overfetch,
+				meshopt_analyzeOverdraw(source.data(), source.size(), positions, numVertices, mesh.vertexSize).overdraw
+			);
+		};
+
+		const auto [acmr, overfetch, overdraw] = analyze(indices, mesh.numVertices, mesh.vertexData.data());
+
+		// cache order first, overdraw reorders whole clusters of it, and the vertices
+		// are laid out last in the order the final indices first touch them
+		const auto* positions = reinterpret_cast<const float*>(mesh.vertexData.data());
+		std::vector<uint32_t> optimized(indices.size());
+
+		meshopt_optimizeVertexCache(optimized.data(), indices.data(), indices.size(), mesh.numVertices);
+		meshopt_optimizeOverdraw(indices.data(), optimized.data(), optimized.size(), positions, mesh.numVertices,
+			mesh.vertexSize, GltfImporter::kOverdrawThreshold);
+
+		std::vector<uint8_t> vertexData(mesh.vertexData.size());
+		const size_t numVertices = meshopt_optimizeVertexFetch(vertexData.data(), indices.data(), indices.size(),
+			mesh.vertexData.data(), mesh.numVertices, mesh.vertexSize);
+
+		vertexData.resize(numVertices * mesh.vertexSize);
+		const auto [newAcmr, newOverfetch, newOverdraw] = analyze(indices, (uint32_t)numVertices, vertexData.data());
+
+		LogInfo("%s: acmr %.3f -> %.3f, overfetch %.3f -> %.3f, overdraw %.3f -> %.3f, vertices %u -> %u",
+			mesh.name.c_str(), acmr, newAcmr, overfetch, newOverfetch, overdraw, newOverdraw,
+			mesh.numVertices, (uint32_t)numVertices);
+
+		mesh.vertexData = std::move(vertexData);
+		mesh.numVertices = (uint32_t)numVertices;
+		std::memcpy(mesh.indexData.data(), indices.data(), mesh.indexData.size());
+	}
+
+	void generateLods(Model::Mesh& mesh)
+	{
+		if (mesh.numIndices == 0 || mesh.indexSize != sizeof(uint32_t))
+		{
+			return;
+		}
+
+		std::vector<uint32_t> indices(mesh.numIndices);
+		std::memcpy(indices.data(), mesh.indexData.data(), mesh.indexData.size());
+
+		// every lod is simplified from the full mesh, the error is kept in model units
+		// so the renderer can project it to pixels
+		const auto* positions = reinterpret_cast<const float*>(mesh.vertexData.data());
+		const float scale = meshopt_simplifyScale(positions, mesh.numVertices, mesh.vertexSize);
+
+		std::vector<uint32_t> lodIndices(indices.size());
+		std::vector<uint32_t> allIndices = indices;
+		float lodError{ 0.0f };
+
+		mesh.lods = { { 0, mesh.numIndices, 0.0f } };
+
+		for (uint32_t lod = 1; lod < GltfImporter::kMaxLods; lod++)
+		{
+			const size_t targetCount = (size_t)(indices.size() * std::pow(GltfImporter::kLodReduction, (float)lod)) / 3 * 3;
+			if (targetCount < 3)
+			{
+				break;
+			}
+
+			float error{ 0.0f };
+			const size_t numIndices = meshopt_simplify(lodIndices.data(), indices.data(), indices.size(), positions,
+				mesh.numVertices, mesh.vertexSize, targetCount, GltfImporter::kLodTargetError, 0, &error);
+
+			// stop once the simplifier can't get meaningfully below the previous lod
+			if (numIndices == 0 || numIndices > mesh.lods.back().numIndices * GltfImporter::kLodMinReduction)
+			{
+				break;
+			}
+
+			meshopt_optimizeVertexCache(lodIndices.data(), lodIndices.data(), numIndices, mesh.numVertices);
+
+			lodError = std::max(lodError, error * scale);
+			mesh.lods.push_back({ (uint32_t)allIndices.size(), (uint32_t)numIndices, lodError });
+			allIndices.insert(allIndices.end(), lodIndices.begin(), lodIndices.begin() + numIndices);
+		}
+
+		mesh.numIndices = (uint32_t)allIndices.size();
+		mesh.indexData.resize(allIndices.size() * sizeof(uint32_t));
+		std::memcpy(mesh.indexData.data(), allIndices.data(), mesh.indexData.size());
+	}
+
+	void buildMeshlets(Model::Mesh& mesh)
+	{
+		// skinned meshes leave their bind pose bounds and cones behind, so only static ones are split
+		if (mesh.numIndices == 0 || mesh.indexSize != sizeof(uint32_t) || mesh.vertexSize != sizeof(Scene::Vertex))
+		{
+			return;
+		}
+
+		const uint32_t numIndices = mesh.lods.empty() ? mesh.numIndices : mesh.lods[0].numIndices;
+		std::vector<uint32_t> indices(numIndices);
+		std::memcpy(indices.data(), mesh.indexData.data(), numIndices * sizeof(uint32_t));
+
+		const size_t maxMeshlets = meshopt_buildMeshletsBound(indices.size(), GltfImporter::kMeshletMaxVertices,
+			GltfImporter::kMeshletMaxTriangles);
+
+		std::vector<meshopt_Meshlet> meshlets(maxMeshlets);
+		std::vector<uint32_t> meshletVertices(maxMeshlets * GltfImporter::kMeshletMaxVertices);
+		std::vector<uint8_t> meshletTriangles(maxMeshlets * GltfImporter::kMeshletMaxTriangles * 3);
+
+		const auto* positions = reinterpret_cast<const float*>(mesh.vertexData.data());
+		const size_t numMeshlets = meshopt_buildMeshlets(meshlets.data(), meshletVertices.data(), meshletTriangles.data(),
+			indices.data(), indices.size(), positions, mesh.numVertices, mesh.vertexSize,
+			GltfImporter::kMeshletMaxVertices, GltfImporter::kMeshletMaxTriangles, GltfImporter::kMeshletConeWeight);
+
+		// the full detail lod is rewritten meshlet by meshlet, so every meshlet is a plain
+		// index range drawn from the same index buffer as the lods, this gives up the overdraw
+		// order of the full detail lod which is why meshlets are only built on request
+		mesh.meshlets.clear();
+		indices.clear();
+
+		for (size_t idx = 0; idx < numMeshlets; idx++)
+		{
+			const auto& meshlet = meshlets[idx];
+			const auto bounds = meshopt_computeMeshletBounds(&meshletVertices[meshlet.vertex_offset],
+				&meshletTriangles[meshlet.triangle_offset], meshlet.triangle_count, positions, mesh.numVertices,
+				mesh.vertexSize);
+
+			const uint32_t firstIndex = (uint32_t)indices.size();
+			for (uint32_t index = 0; index < meshlet.triangle_count * 3; index++)
+			{
+				indices.push_back(meshletVertices[meshlet.vertex_offset + meshletTriangles[meshlet.triangle_offset + index]]);
+			}
+
+			meshopt_optimizeVertexCache(&indices[firstIndex], &indices[firstIndex], meshlet.triangle_count * 3,
+				mesh.numVertices);
+
+			mesh.meshlets.push_back({
+				.center = glm::make_vec3(bounds.center),
+				.radius = bounds.radius,
+				.coneAxis = glm::make_vec3(bounds.cone_axis),
+				.coneCutoff = bounds.cone_cutoff,
+				.firstIndex = firstIndex,
+				.numIndices = meshlet.triangle_count * 3
+			});
+		}
+
+		std::memcpy(mesh.indexData.data(), indices.data(), indices.size() * sizeof(uint32_t));
+	}
+
+	void compactIndices(Model::Mesh& mesh)
+	{
+		// 16 bit indices halve the index data whenever every vertex is addressable
+		if (mesh.numIndices == 0 || mesh.indexSize != sizeof(uint32_t) || mesh.numVertices > 65536)
+		{
+			return;
+		}
+
+		std::vector<uint32_t> indices(mesh.numIndices);
+		std::memcpy(indices.data(), mesh.indexData.data(), mesh.indexData.size());
+
+		std::vector<uint16_t> compactIndices(indices.begin(), indices.end());
+		mesh.indexData.resize(compactIndices.size() * sizeof(uint16_t));
+		std::memcpy(mesh.indexData.data(), compactIndices.data(), mesh.indexData.size());
+		mesh.indexSize = sizeof(uint16_t);
+	}
+
+	glm::vec2 encodeOctahedral(const glm::vec3& normal)
+	{
+		const float sum = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+		if (sum == 0.0f)
+		{
+			return glm::vec2{ 0.0f };
+		}
+
+		// project onto the octahedron and fold the lower half over the diagonals
+		const glm::vec3 n = normal / sum;
+		if (n.z >= 0.0f)
+		{
+			return glm::vec2{ n.x, n.y };
+		}
+
+		return glm::vec2{
+			(1.0f - std::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f),
+			(1.0f - std::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f)
+		};
+	}
+
+	template <typename T, typename U>
+	void compactVertex(const T& vertex, U& compact)
+	{
+		const glm::vec2 normal = encodeOctahedral(vertex.normal);
+
+		compact.position = vertex.position;
+		compact.normal[0] = (int16_t)meshopt_quantizeSnorm(normal.x, 16);
+		compact.normal[1] = (int16_t)meshopt_quantizeSnorm(normal.y, 16);
+		compact.uv[0] = meshopt_quantizeHalf(vertex.uv.x);
+		compact.uv[1] = meshopt_quantizeHalf(vertex.uv.y);
+	}
+
+	void compactVertices(Model::Mesh& mesh)
+	{
+		std::vector<uint8_t> vertexData;
+
+		if (mesh.vertexSize == sizeof(Scene::VertexSkinned))
+		{
+			std::vector<Scene::VertexSkinned> vertices(mesh.numVertices);
+			std::memcpy(vertices.data(), mesh.vertexData.data(), mesh.vertexData.size());
+
+			std::vector<Scene::VertexSkinnedCompact> compactVertices(mesh.numVertices);
+			for (uint32_t idx = 0; idx < mesh.numVertices; idx++)
+			{
+				const auto& vertex = vertices[idx];
+				auto& compact = compactVertices[idx];
+
+				compactVertex(vertex, compact);
+				for (uint32_t component = 0; component < 4; component++)
+				{
+					compact.joint[component] = (uint8_t)vertex.joint[component];
+					compact.weight[component] = (uint16_t)meshopt_quantizeUnorm(vertex.weight[component], 16);
+				}
+			}
+
+			vertexData.resize(compactVertices.size() * sizeof(Scene::VertexSkinnedCompact));
+			std::memcpy(vertexData.data(), compactVertices.data(), vertexData.size());
+			mesh.vertexSize = sizeof(Scene::VertexSkinnedCompact);
+		}
+		else
+		{
+			std::vector<Scene::Vertex> vertices(mesh.numVertices);
+			std::memcpy(vertices.data(), mesh.vertexData.data(), mesh.vertexData.size());
+
+			std::vector<Scene::VertexCompact> compactVertices(mesh.numVertices);
+			for (uint32_t idx = 0; idx < mesh.numVertices; idx++)
+			{
+				compactVertex(vertices[idx], compactVertices[idx]);
+			}
+
+			vertexData.resize(compactVertices.size() * sizeof(Scene::VertexCompact));
+			std::memcpy(vertexData.data(), compactVertices.data(), vertexData.size());
+			mesh.vertexSize = sizeof(Scene::VertexCompact);
+		}
+
+		mesh.vertexData = std::move(vertexData);
+	}
+
+	bool canCompactJoints(const tinygltf::Model& gltfModel)
+	{
+		// joints are stored as node indices, the compact layout only has 8 bits for them
+		for (const auto& gltfSkin : gltfModel.skins)
+		{
+			for (auto joint : gltfSkin.joints)
+			{
+				if (joint > 255)
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
 	std::unordered_map<int32_t, int32_t> getParentMap(const tinygltf::Model& gltfModel, const tinygltf::Scene& gltfScene)
 	{
 		std::unordered_map<int32_t, int32_t> parentMap;
@@ -640,8 +914,7 @@ namespace Trinity
 		}
 		else
 		{
-			auto meshes = cache.getResources<Mesh>();
-			fileName.append(std::format("Mesh_{}", meshes.size()));
+			fileName.append(std::format("Mesh_{}", cache.getNumResources<Model>()));
 		}
 
 		fileName.replace_extension("tmesh");
@@ -666,8 +939,7 @@ namespace Trinity
 		}
 		else
 		{
-			auto materials = cache.getResources<Material>();
-			fileName.append(std::format("Material_{}", materials.size()));
+			fileName.append(std::format("Material_{}", cache.getNumResources<Material>()));
 		}
 
 		fileName.replace_extension("tmat");
@@ -732,29 +1004,19 @@ namespace Trinity
 		return material;
 	}
 
-	std::unique_ptr<Image> parseImage(const tinygltf::Image& gltfImage, ResourceCache& cache, const std::string& inputPath,
-		const std::string& imagesPath, bool loadContent = true)
+	Image* parseImage(const tinygltf::Image& gltfImage, size_t imageIndex, ResourceCache& cache, 
+		ContentManifest& manifest, const std::string& inputPath, const std::string& imagesPath)
 	{
-		std::unique_ptr<Image> image{ nullptr };
+		// the pixels are always decoded, their hash names the output file
+		auto image = std::make_unique<Image>();
+		std::string logicalName;
 
 		if (!gltfImage.image.empty())
 		{
-			auto images = cache.getResources<Image>();
-
-			fs::path fileName(imagesPath);
-			fileName.append(std::format("Image_{}", images.size()));
-			fileName.replace_extension("png");
-
-			image = std::make_unique<Image>();
-			if (!image->create(FileSystem::get().sanitizePath(fileName.string()), cache, false))
-			{
-				LogError("Image::create() failed for: %s!!", fileName.c_str());
-				return nullptr;
-			}
-
+			logicalName = !gltfImage.name.empty() ? gltfImage.name : std::format("Image_{}", imageIndex);
 			if (!image->load(gltfImage.image))
 			{
-				LogError("Image::load() failed for: %s!!", fileName.c_str());
+				LogError("Image::load() failed for: %s!!", logicalName.c_str());
 				return nullptr;
 			}
 		}
@@ -762,25 +1024,65 @@ namespace Trinity
 		{
 			auto imageUri = inputPath + "/" + gltfImage.uri;
 
-			fs::path fileName(imagesPath);
-			fileName.append(gltfImage.uri);
-			fileName.replace_extension("png");
-
-			image = std::make_unique<Image>();
-			if (!image->create(FileSystem::get().sanitizePath(fileName.string()), cache, false))
-			{
-				LogError("Image::create() failed for: %s!!", fileName.c_str());
-				return nullptr;
-			}
-
+			logicalName = gltfImage.uri;
 			if (!image->load(imageUri))
 			{
-				LogError("Image::load() failed for: %s!!", fileName.c_str());
+				LogError("Image::load() failed for: %s!!", imageUri.c_str());
 				return nullptr;
 			}
 		}
 
-		return image;
+		const auto imageFileName = Image::getContentFileName(*image, imagesPath, cache);
+		manifest.setEntry("Images/" + logicalName, image->getContentHash(), imageFileName);
+
+		if (cache.isLoaded<Image>(imageFileName))
+		{
+			return cache.getResource<Image>(imageFileName);
+		}
+
+		if (!image->create(imageFileName, cache, false))
+		{
+			LogError("Image::create() failed for: %s!!", imageFileName.c_str());
+			return nullptr;
+		}
+
+		auto* result = image.get();
+		cache.addResource(std::move(image));
+
+		return result;
+	}
+
+	Texture* parseTexture(const tinygltf::Texture& gltfTexture, size_t textureIndex, Image& image, 
+		ResourceCache& cache, ContentManifest& manifest, const std::string& texturesPath, bool loadContent = true)
+	{
+		// the image file is already unique per content, the texture is named after it
+		auto fileName = fs::path(texturesPath);
+		fileName.append(fs::path(image.getFileName()).stem().string());
+		fileName.replace_extension("ttex");
+
+		const auto textureFileName = FileSystem::get().sanitizePath(fileName.string());
+		const auto logicalName = !gltfTexture.name.empty() ? gltfTexture.name : std::format("Texture_{}", textureIndex);
+		manifest.setEntry("Textures/" + logicalName, 
+			HashHelper::combine(image.getContentHash(), (uint64_t)TextureType::TwoD), textureFileName);
+
+		if (cache.isLoaded<Texture>(textureFileName))
+		{
+			return cache.getResource<Texture>(textureFileName);
+		}
+
+		auto texture = std::make_unique<Texture2D>();
+		if (!texture->create(textureFileName, cache, loadContent))
+		{
+			LogError("Texture2D::create() failed for: %s!!", textureFileName.c_str());
+			return nullptr;
+		}
+
+		texture->setImage(&image);
+
+		auto* result = texture.get();
+		cache.addResource(std::move(texture));
+
+		return result;
 	}
 
 	std::unique_ptr<Sampler> parseSampler(const tinygltf::Sampler& gltfSampler, ResourceCache& cache,
@@ -793,8 +1095,7 @@ namespace Trinity
 		}
 		else
 		{
-			auto samplers = cache.getResources<Sampler>();
-			fileName.append(std::format("Sampler_{}", samplers.size()));
+			fileName.append(std::format("Sampler_{}", cache.getNumResources<Sampler>()));
 		}
 
 		fileName.replace_extension("tsamp");
@@ -873,6 +1174,7 @@ namespace Trinity
 		const std::string& texturesPath, 
 		const std::string& samplersPath, 
 		bool hasSkin = false,
+		bool compact = false,
 		bool loadContent = true)
 	{
 		auto defaultSampler = createDefaultSampler(cache, samplersPath, loadContent);
@@ -884,55 +1186,52 @@ namespace Trinity
 			cache.addResource(std::move(sampler));
 		}
 
-		for (const auto& gltfImage : gltfModel.images)
+		auto manifestPath = fs::path(imagesPath).parent_path();
+		manifestPath.append(ContentManifest::kFileName);
+
+		auto* manifest = ContentManifest::getOrCreate(FileSystem::get().sanitizePath(manifestPath.string()), cache);
+		if (!manifest)
+		{
+			LogError("ContentManifest::getOrCreate() failed for: %s!!", manifestPath.string().c_str());
+			return false;
+		}
+
+		std::vector<Image*> images;
+		for (size_t idx = 0; idx < gltfModel.images.size(); idx++)
 		{
-			auto image = parseImage(gltfImage, cache, inputPath, imagesPath, loadContent);
-			cache.addResource(std::move(image));
+			auto* image = parseImage(gltfModel.images[idx], idx, cache, *manifest, inputPath, imagesPath);
+			if (!image)
+			{
+				LogError("parseImage() failed for image: %d!!", (int32_t)idx);
+				return false;
+			}
+
+			images.push_back(image);
 		}
 
 		std::unordered_map<size_t, size_t> texSampMap;
 		size_t numSamplers = gltfModel.samplers.size();
-		size_t numTextures = 0;
 
-		auto images = cache.getResources<Image>();
-		for (const auto& gltfTexture : gltfModel.textures)
+		std::vector<Texture*> textures;
+		for (size_t idx = 0; idx < gltfModel.textures.size(); idx++)
 		{
-			auto* image = images[gltfTexture.source];
-			auto fileName = fs::path(texturesPath);
+			const auto& gltfTexture = gltfModel.textures[idx];
+			auto* texture = parseTexture(gltfTexture, idx, *images[gltfTexture.source], cache, 
+				*manifest, texturesPath, loadContent);
 
-			auto imageFileName = fs::path(image->getFileName());
-
-			fileName.append(imageFileName.filename().string());
-			fileName.replace_extension("ttex");
-
-			auto texture = std::make_unique<Texture2D>();
-			if (!texture->create(FileSystem::get().sanitizePath(fileName.string()), cache, loadContent))
+			if (!texture)
 			{
-				LogError("Texture2D::create() failed for: %s!!", fileName.string().c_str());
+				LogError("parseTexture() failed for texture: %d!!", (int32_t)idx);
 				return false;
 			}
 
 			size_t samplerIndex = gltfTexture.sampler < numSamplers ? gltfTexture.sampler + 1 : 0;
-			texSampMap.insert(std::make_pair(numTextures, samplerIndex));
-
-			texture->setImage(image);
-			cache.addResource(std::move(texture));
-
-			numTextures++;
+			texSampMap.insert(std::make_pair(idx, samplerIndex));
+			textures.push_back(texture);
 		}
 
-		std::vector<Texture*> textures;
 		std::vector<Sampler*> samplers;
-
-		bool hasTextures = cache.hasResource<Texture>();
-		bool hasSamplers = cache.hasResource<Sampler>();
-
-		if (hasTextures)
-		{
-			textures = cache.getResources<Texture>();
-		}
-
-		if (hasSamplers)
+		if (cache.hasResource<Sampler>())
 		{
 			samplers = cache.getResources<Sampler>();
 		}
@@ -945,6 +1244,11 @@ namespace Trinity
 				shaderDefines.push_back("has_skin");
 			}
 
+			if (compact)
+			{
+				shaderDefines.push_back("has_compact_vertex");
+			}
+
 			auto material = parseMaterial(gltfMaterial, cache, materialsPath, loadContent);
 			for (const auto& gltfValue : gltfMaterial.values)
 			{
@@ -980,7 +1284,13 @@ namespace Trinity
 			cache.addResource(std::move(material));
 		}
 
-		auto defaultShader = createDefaultShader(cache, {}, loadContent);
+		std::vector<std::string> defaultDefines;
+		if (compact)
+		{
+			defaultDefines.push_back("has_compact_vertex");
+		}
+
+		auto defaultShader = createDefaultShader(cache, defaultDefines, loadContent);
 		auto defaultMaterial = createDefaultMaterial(cache, materialsPath, loadContent);
 		defaultMaterial->setShader(*defaultShader);
 
@@ -1039,8 +1349,7 @@ namespace Trinity
 			}
 			else
 			{
-				auto animations = cache.getResources<AnimationClip>();
-				fileName.append(std::format("Animation_{}", animations.size()));
+				fileName.append(std::format("Animation_{}", idx));
 			}
 
 			auto clip = std::make_unique<AnimationClip>();
@@ -1088,6 +1397,8 @@ namespace Trinity
 		const std::string& imagesPath, 
 		const std::string& texturesPath, 
 		const std::string& samplersPath, 
+		bool compact = false,
+		bool meshlets = false,
 		bool loadContent = true)
 	{
 		auto scene = std::make_unique<Scene>();
@@ -1101,7 +1412,7 @@ namespace Trinity
 		scene->setComponents(std::move(lights));
 
 		if (!loadMaterials(gltfModel, cache, inputPath, materialsPath, imagesPath, 
-			texturesPath, samplersPath, false, loadContent))
+			texturesPath, samplersPath, false, compact, loadContent))
 		{
 			LogError("GltfImporter::loadMaterials() faile for: %s!!", outputFileName.c_str());
 			return nullptr;
@@ -1200,11 +1511,27 @@ namespace Trinity
 					modelMesh.materialIndex = (uint32_t)gltfPrimitive.material;
 				}
 
+				optimizeMesh(modelMesh);
+				generateLods(modelMesh);
+
+				if (meshlets)
+				{
+					buildMeshlets(modelMesh);
+				}
+
+				compactIndices(modelMesh);
+
+				if (compact)
+				{
+					compactVertices(modelMesh);
+				}
+
 				modelMeshes.push_back(std::move(modelMesh));
 			}
 
 			model->setMeshes(std::move(modelMeshes));
 			model->setMaterials(std::move(materials));
+			model->setCompactVertices(compact);
 			mesh->setModel(*model);
 
 			cache.addResource(std::move(model));
@@ -1306,10 +1633,18 @@ namespace Trinity
 		const std::string& samplersPath, 
 		const std::string& animationsPath = "", 
 		bool animated = false, 
+		bool compact = false,
+		bool meshlets = false,
 		bool loadContent = true)
 	{
+		if (compact && animated && !canCompactJoints(gltfModel))
+		{
+			LogWarning("Joint indices don't fit the compact layout, keeping full vertices for: %s", outputFileName.c_str());
+			compact = false;
+		}
+
 		if (!loadMaterials(gltfModel, cache, inputPath, materialsPath, imagesPath, 
-			texturesPath, samplersPath, animated, loadContent))
+			texturesPath, samplersPath, animated, compact, loadContent))
 		{
 			LogError("GltfImporter::loadMaterials() failed for: %s", outputFileName.c_str());
 			return nullptr;
@@ -1507,12 +1842,28 @@ namespace Trinity
 					modelMesh.materialIndex = (uint32_t)gltfPrimitive.material;
 				}
 
+				optimizeMesh(modelMesh);
+				generateLods(modelMesh);
+
+				if (meshlets)
+				{
+					buildMeshlets(modelMesh);
+				}
+
+				compactIndices(modelMesh);
+
+				if (compact)
+				{
+					compactVertices(modelMesh);
+				}
+
 				modelMeshes.push_back(std::move(modelMesh));
 			}
 		}
 
 		model->setMeshes(std::move(modelMeshes));
 		model->setMaterials(std::move(materials));
+		model->setCompactVertices(compact);
 
 		if (animated)
 		{
@@ -1614,6 +1965,8 @@ namespace Trinity
 			imagesPath.string(), 
 			texturesPath.string(),
 			samplersPath.string(), 
+			mCompactVertices,
+			mMeshlets,
 			loadContent);
 
 		if (!scene)
@@ -1711,6 +2064,8 @@ namespace Trinity
 			samplersPath.string(),
 			animationsPath.string(), 
 			animated, 
+			mCompactVertices,
+			mMeshlets,
 			loadContent);
 
 		if (!model)
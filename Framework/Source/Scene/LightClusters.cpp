@@ -0,0 +1,277 @@
+#include "Scene/LightClusters.h"
+#include "Core/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Trinity
+{
+	bool LightClusters::create()
+	{
+		destroy();
+
+		mClustersBuffer = std::make_unique<StorageBuffer>();
+		if (!mClustersBuffer->create(kNumClusters * sizeof(glm::uvec2)))
+		{
+			LogError("StorageBuffer::create() failed for clusters!!");
+			return false;
+		}
+
+		mIndicesBuffer = std::make_unique<StorageBuffer>();
+		if (!mIndicesBuffer->create(kMinIndexCapacity * sizeof(uint32_t)))
+		{
+			LogError("StorageBuffer::create() failed for light indices!!");
+			return false;
+		}
+
+		mClusters.assign(kNumClusters, glm::uvec2{ 0 });
+		return true;
+	}
+
+	void LightClusters::destroy()
+	{
+		mClustersBuffer = nullptr;
+		mIndicesBuffer = nullptr;
+		mClusterBounds.clear();
+		mClusters.clear();
+		mPairs.clear();
+		mIndices.clear();
+		mProjection = glm::mat4{ 0.0f };
+		mSize = glm::uvec2{ 0 };
+		mNumGlobalLights = 0;
+	}
+
+	bool LightClusters::update(const glm::mat4& view, const glm::mat4& projection, uint32_t width, uint32_t height,
+		const std::vector<LightBounds>& lights)
+	{
+		if (projection != mProjection || mSize != glm::uvec2{ width, height })
+		{
+			updateClusterBounds(projection, width, height);
+		}
+
+		mPairs.clear();
+		mIndices.clear();
+		std::fill(mClusters.begin(), mClusters.end(), glm::uvec2{ 0 });
+
+		// global lights go first and are shaded by every fragment, the clustered
+		// ranges follow them in the same index list
+		for (const auto& light : lights)
+		{
+			if (light.global || !mPerspective)
+			{
+				mIndices.push_back(light.index);
+			}
+		}
+
+		mNumGlobalLights = (uint32_t)mIndices.size();
+
+		if (mPerspective)
+		{
+			for (const auto& light : lights)
+			{
+				if (!light.global)
+				{
+					assignLight(view, projection, light);
+				}
+			}
+		}
+
+		for (const auto& pair : mPairs)
+		{
+			mClusters[pair.x].y++;
+		}
+
+		uint32_t offset = mNumGlobalLights;
+		for (auto& cluster : mClusters)
+		{
+			cluster.x = offset;
+			offset += cluster.y;
+			cluster.y = 0;
+		}
+
+		mIndices.resize(offset);
+		for (const auto& pair : mPairs)
+		{
+			auto& cluster = mClusters[pair.x];
+			mIndices[cluster.x + cluster.y++] = pair.y;
+		}
+
+		return upload();
+	}
+
+	void LightClusters::updateClusterBounds(const glm::mat4& projection, uint32_t width, uint32_t height)
+	{
+		mProjection = projection;
+		mSize = { std::max(width, 1u), std::max(height, 1u) };
+		mTileSize = {
+			std::ceil((float)mSize.x / kNumClustersX),
+			std::ceil((float)mSize.y / kNumClustersY)
+		};
+
+		// orthographic projections put every light in the global list
+		mPerspective = projection[2][3] != 0.0f;
+		if (!mPerspective)
+		{
+			mClusterBounds.clear();
+			return;
+		}
+
+		mNearPlane = projection[3][2] / projection[2][2];
+		mFarPlane = projection[3][2] / (projection[2][2] + 1.0f);
+
+		if (!std::isfinite(mFarPlane) || mFarPlane <= mNearPlane)
+		{
+			mFarPlane = mNearPlane * 10000.0f;
+		}
+
+		const float depthRatio = std::log(mFarPlane / mNearPlane);
+		mDepthScale = kNumClustersZ / depthRatio;
+		mDepthBias = -(float)kNumClustersZ * std::log(mNearPlane) / depthRatio;
+
+		auto toView = [&](float ndcX, float ndcY, float depth) {
+			return glm::vec3{
+				(ndcX + projection[2][0]) * depth / projection[0][0],
+				(ndcY + projection[2][1]) * depth / projection[1][1],
+				-depth
+			};
+		};
+
+		mClusterBounds.resize(kNumClusters);
+
+		for (uint32_t z = 0; z < kNumClustersZ; z++)
+		{
+			const float nearDepth = mNearPlane * std::pow(mFarPlane / mNearPlane, (float)z / kNumClustersZ);
+			const float farDepth = mNearPlane * std::pow(mFarPlane / mNearPlane, (float)(z + 1) / kNumClustersZ);
+
+			for (uint32_t y = 0; y < kNumClustersY; y++)
+			{
+				const float top = 1.0f - 2.0f * (y * mTileSize.y) / mSize.y;
+				const float bottom = 1.0f - 2.0f * ((y + 1) * mTileSize.y) / mSize.y;
+
+				for (uint32_t x = 0; x < kNumClustersX; x++)
+				{
+					const float left = 2.0f * (x * mTileSize.x) / mSize.x - 1.0f;
+					const float right = 2.0f * ((x + 1) * mTileSize.x) / mSize.x - 1.0f;
+
+					BoundingBox bounds{ glm::vec3{ std::numeric_limits<float>::max() },
+						glm::vec3{ std::numeric_limits<float>::lowest() } };
+
+					for (float depth : { nearDepth, farDepth })
+					{
+						bounds.combinePoint(toView(left, top, depth));
+						bounds.combinePoint(toView(right, top, depth));
+						bounds.combinePoint(toView(left, bottom, depth));
+						bounds.combinePoint(toView(right, bottom, depth));
+					}
+
+					mClusterBounds[x + kNumClustersX * (y + kNumClustersY * z)] = bounds;
+				}
+			}
+		}
+	}
+
+	void LightClusters::assignLight(const glm::mat4& view, const glm::mat4& projection, const LightBounds& light)
+	{
+		const glm::vec3 center = glm::vec3(view * glm::vec4(light.position, 1.0f));
+		const float depth = -center.z;
+		const float radius = light.range;
+
+		if (depth + radius < mNearPlane || depth - radius > mFarPlane)
+		{
+			return;
+		}
+
+		auto getSlice = [&](float sliceDepth) {
+			const float slice = std::floor(std::log(sliceDepth) * mDepthScale + mDepthBias);
+			return (uint32_t)std::clamp(slice, 0.0f, (float)kNumClustersZ - 1);
+		};
+
+		const float minDepth = std::max(depth - radius, mNearPlane);
+		const float maxDepth = std::min(depth + radius, mFarPlane);
+
+		// the view space box around the sphere bounds its screen rect, the extremes
+		// of x / depth and y / depth lie on the corners of the box
+		glm::vec2 minNdc{ std::numeric_limits<float>::max() };
+		glm::vec2 maxNdc{ std::numeric_limits<float>::lowest() };
+
+		for (float cornerDepth : { minDepth, depth + radius })
+		{
+			for (float dx : { -radius, radius })
+			{
+				for (float dy : { -radius, radius })
+				{
+					const glm::vec2 ndc{
+						projection[0][0] * (center.x + dx) / cornerDepth - projection[2][0],
+						projection[1][1] * (center.y + dy) / cornerDepth - projection[2][1]
+					};
+
+					minNdc = glm::min(minNdc, ndc);
+					maxNdc = glm::max(maxNdc, ndc);
+				}
+			}
+		}
+
+		if (maxNdc.x < -1.0f || minNdc.x > 1.0f || maxNdc.y < -1.0f || minNdc.y > 1.0f)
+		{
+			return;
+		}
+
+		auto getTile = [](float pixel, float tileSize, uint32_t numTiles) {
+			return (uint32_t)std::clamp(std::floor(pixel / tileSize), 0.0f, (float)numTiles - 1);
+		};
+
+		const uint32_t minX = getTile((minNdc.x + 1.0f) * 0.5f * mSize.x, mTileSize.x, kNumClustersX);
+		const uint32_t maxX = getTile((maxNdc.x + 1.0f) * 0.5f * mSize.x, mTileSize.x, kNumClustersX);
+		const uint32_t minY = getTile((1.0f - maxNdc.y) * 0.5f * mSize.y, mTileSize.y, kNumClustersY);
+		const uint32_t maxY = getTile((1.0f - minNdc.y) * 0.5f * mSize.y, mTileSize.y, kNumClustersY);
+		const uint32_t minZ = getSlice(minDepth);
+		const uint32_t maxZ = getSlice(maxDepth);
+		const float radiusSq = radius * radius;
+
+		for (uint32_t z = minZ; z <= maxZ; z++)
+		{
+			for (uint32_t y = minY; y <= maxY; y++)
+			{
+				for (uint32_t x = minX; x <= maxX; x++)
+				{
+					const uint32_t cluster = x + kNumClustersX * (y + kNumClustersY * z);
+					const auto& bounds = mClusterBounds[cluster];
+
+					const glm::vec3 delta = glm::clamp(center, bounds.min, bounds.max) - center;
+					if (glm::dot(delta, delta) <= radiusSq)
+					{
+						mPairs.push_back({ cluster, light.index });
+					}
+				}
+			}
+		}
+	}
+
+	bool LightClusters::upload()
+	{
+		mClustersBuffer->write(0, kNumClusters * sizeof(glm::uvec2), mClusters.data());
+
+		if (mIndices.empty())
+		{
+			return true;
+		}
+
+		const uint32_t capacity = mIndicesBuffer->getSize() / sizeof(uint32_t);
+		if ((uint32_t)mIndices.size() > capacity)
+		{
+			const uint32_t newCapacity = std::max(capacity * 2, (uint32_t)mIndices.size());
+
+			auto indicesBuffer = std::make_unique<StorageBuffer>();
+			if (!indicesBuffer->create(newCapacity * sizeof(uint32_t)))
+			{
+				LogError("StorageBuffer::create() failed for light indices!!");
+				return false;
+			}
+
+			mIndicesBuffer = std::move(indicesBuffer);
+		}
+
+		mIndicesBuffer->write(0, (uint32_t)mIndices.size() * sizeof(uint32_t), mIndices.data());
+		return true;
+	}
+}
\ No newline at end of file
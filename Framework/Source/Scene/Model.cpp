@@ -10,6 +10,7 @@
 #include "VFS/FileSystem.h"
 #include "Core/ResourceCache.h"
 #include "Core/Logger.h"
+#include <cstring>
 
 namespace Trinity
 {
@@ -21,8 +22,19 @@ namespace Trinity
 	void Model::destroy()
 	{
 		Resource::destroy();
+
+		for (auto& mesh : mMeshes)
+		{
+			releaseResourceRef(mesh.vertexLayout);
+			releaseResourceRef(mesh.vertexBuffer);
+			releaseResourceRef(mesh.positionLayout);
+			releaseResourceRef(mesh.indexBuffer);
+		}
+
+		setMaterials({});
+		setClips({});
+		releaseResourceRef(mSkeleton);
 		mMeshes.clear();
-		mMaterials.clear();
 	}
 
 	bool Model::write()
@@ -35,31 +47,136 @@ namespace Trinity
 		return typeid(Model);
 	}
 
+	uint64_t Model::getCpuMemorySize() const
+	{
+		uint64_t size{ 0 };
+		for (const auto& mesh : mMeshes)
+		{
+			size += mesh.vertexData.size() + mesh.indexData.size() + mesh.meshlets.size() * sizeof(Meshlet);
+		}
+
+		return size;
+	}
+
+	uint32_t Model::getEvictionPriority() const
+	{
+		return 0;
+	}
+
 	void Model::setMeshes(std::vector<Mesh>&& meshes)
 	{
 		mMeshes = std::move(meshes);
+
+		for (auto& mesh : mMeshes)
+		{
+			mesh.bounds = computeBounds(mesh);
+
+			if (mesh.lods.empty() && mesh.numIndices > 0)
+			{
+				mesh.lods.push_back({ 0, mesh.numIndices, 0.0f });
+			}
+		}
 	}
 
 	void Model::setMaterials(std::vector<Material*>&& materials)
 	{
+		for (auto* material : materials)
+		{
+			material->addRef();
+		}
+
+		for (auto* material : mMaterials)
+		{
+			material->release();
+		}
+
 		mMaterials = std::move(materials);
 	}
 
 	void Model::setSkeleton(Skeleton& skeleton)
 	{
-		mSkeleton = &skeleton;
+		setResourceRef(mSkeleton, &skeleton);
 	}
 
 	void Model::setClips(std::vector<AnimationClip*>&& clips)
 	{
+		for (auto* clip : clips)
+		{
+			clip->addRef();
+		}
+
+		for (auto* clip : mClips)
+		{
+			clip->release();
+		}
+
 		mClips = std::move(clips);
 	}
 
 	void Model::addClip(AnimationClip& clip)
 	{
+		clip.addRef();
 		mClips.push_back(&clip);
 	}
 
+	void Model::setCompactVertices(bool compactVertices)
+	{
+		mCompactVertices = compactVertices;
+	}
+
+	bool Model::getDependencies(FileReader& reader, std::vector<ResourceDependency>& dependencies)
+	{
+		mName = reader.readString();
+
+		uint32_t version{ 0 };
+		uint32_t numMaterials{ 0 };
+
+		if (!readHeader(reader, version, numMaterials))
+		{
+			LogError("Model::readHeader() failed for: %s!!", reader.getPath().c_str());
+			return false;
+		}
+
+		for (uint32_t idx = 0; idx < numMaterials; idx++)
+		{
+			dependencies.push_back({
+				.fileName = Resource::getReadPath(reader.getPath(), reader.readString()),
+				.creator = []() -> std::unique_ptr<Resource> {
+					return std::make_unique<PBRMaterial>();
+				},
+				.createResource = false
+			});
+		}
+
+		bool hasSkeleton{ false };
+		reader.read(&hasSkeleton);
+
+		if (hasSkeleton)
+		{
+			dependencies.push_back({
+				.fileName = Resource::getReadPath(reader.getPath(), reader.readString()),
+				.creator = []() -> std::unique_ptr<Resource> {
+					return std::make_unique<Skeleton>();
+				}
+			});
+
+			uint32_t numClips{ 0 };
+			reader.read(&numClips);
+
+			for (uint32_t idx = 0; idx < numClips; idx++)
+			{
+				dependencies.push_back({
+					.fileName = Resource::getReadPath(reader.getPath(), reader.readString()),
+					.creator = []() -> std::unique_ptr<Resource> {
+						return std::make_unique<AnimationClip>();
+					}
+				});
+			}
+		}
+
+		return true;
+	}
+
 	bool Model::read(FileReader& reader, ResourceCache& cache)
 	{
 		if (!Resource::read(reader, cache))
@@ -68,8 +185,14 @@ namespace Trinity
 		}
 
 		auto& fileSystem = FileSystem::get();
+		uint32_t version{ 0 };
 		uint32_t numMaterials{ 0 };
-		reader.read(&numMaterials);
+
+		if (!readHeader(reader, version, numMaterials))
+		{
+			LogError("Model::readHeader() failed for: %s!!", reader.getPath().c_str());
+			return false;
+		}
 
 		std::vector<std::string> materialFileNames;
 		for (uint32_t idx = 0; idx < numMaterials; idx++)
@@ -99,6 +222,7 @@ namespace Trinity
 			}
 			
 			auto* material = cache.getResource<Material>(materialFileName);
+			material->addRef();
 			mMaterials.push_back(material);
 		}
 
@@ -144,15 +268,39 @@ namespace Trinity
 					cache.addResource(std::move(clip));
 				}
 
-				auto* clip = cache.getResource<AnimationClip>(fileName);
-				mClips.push_back(clip);
+				addClip(*cache.getResource<AnimationClip>(fileName));
 			}
 
-			mSkeleton = cache.getResource<Skeleton>(skeletonFileName);
+			setSkeleton(*cache.getResource<Skeleton>(skeletonFileName));
+		}
+
+		// unversioned files only ever stored full vertices and a single lod
+		mCompactVertices = false;
+		if (version > 0)
+		{
+			reader.read(&mCompactVertices);
 		}
 
 		auto vertexLayout = std::make_unique<VertexLayout>();
-		if (hasSkeleton)
+		if (mCompactVertices && hasSkeleton)
+		{
+			vertexLayout->setAttributes({
+				{ wgpu::VertexFormat::Float32x3, 0, 0 },
+				{ wgpu::VertexFormat::Snorm16x2, 12, 1 },
+				{ wgpu::VertexFormat::Float16x2, 16, 2 },
+				{ wgpu::VertexFormat::Uint8x4, 20, 3 },
+				{ wgpu::VertexFormat::Unorm16x4, 24, 4 }
+			});
+		}
+		else if (mCompactVertices)
+		{
+			vertexLayout->setAttributes({
+				{ wgpu::VertexFormat::Float32x3, 0, 0 },
+				{ wgpu::VertexFormat::Snorm16x2, 12, 1 },
+				{ wgpu::VertexFormat::Float16x2, 16, 2 }
+			});
+		}
+		else if (hasSkeleton)
 		{
 			vertexLayout->setAttributes({
 				{ wgpu::VertexFormat::Float32x3, 0, 0 },
@@ -171,6 +319,17 @@ namespace Trinity
 			});
 		}		
 
+		// positions lead every vertex, so depth only passes of static meshes read them
+		// straight out of the full vertex buffer with a position only layout
+		std::unique_ptr<VertexLayout> positionLayout{ nullptr };
+		if (!hasSkeleton)
+		{
+			positionLayout = std::make_unique<VertexLayout>();
+			positionLayout->setAttributes({
+				{ wgpu::VertexFormat::Float32x3, 0, 0 }
+			}, vertexLayout->getSize());
+		}
+
 		uint32_t numMeshes{ 0 };
 		reader.read(&numMeshes);
 
@@ -199,6 +358,18 @@ namespace Trinity
 			reader.read(&mesh.numVertices);
 			reader.read(&mesh.numIndices);
 			reader.read(&mesh.materialIndex);
+			if (version > 0)
+			{
+				reader.readVector(mesh.lods);
+				reader.readVector(mesh.meshlets);
+			}
+
+			if (mesh.lods.empty() && mesh.numIndices > 0)
+			{
+				mesh.lods.push_back({ 0, mesh.numIndices, 0.0f });
+			}
+
+			mesh.bounds = computeBounds(mesh);
 
 			auto vertexBuffer = std::make_unique<VertexBuffer>();
 			if (!vertexBuffer->create(*vertexLayout, mesh.numVertices, mesh.vertexData.data()))
@@ -207,10 +378,15 @@ namespace Trinity
 				return false;
 			}
 
-			mesh.vertexLayout = vertexLayout.get();
-			mesh.vertexBuffer = vertexBuffer.get();
+			setResourceRef(mesh.vertexLayout, vertexLayout.get());
+			setResourceRef(mesh.vertexBuffer, vertexBuffer.get());
 			cache.addResource(std::move(vertexBuffer));
 
+			if (positionLayout != nullptr)
+			{
+				setResourceRef(mesh.positionLayout, positionLayout.get());
+			}
+
 			if (mesh.numIndices > 0)
 			{
 				auto indexFormat = mesh.indexSize == sizeof(uint32_t) ? wgpu::IndexFormat::Uint32 : wgpu::IndexFormat::Uint16;
@@ -222,7 +398,7 @@ namespace Trinity
 					return false;
 				}
 
-				mesh.indexBuffer = indexBuffer.get();
+				setResourceRef(mesh.indexBuffer, indexBuffer.get());
 				cache.addResource(std::move(indexBuffer));
 			}
 
@@ -230,6 +406,11 @@ namespace Trinity
 		}
 
 		cache.addResource(std::move(vertexLayout));
+		if (positionLayout != nullptr)
+		{
+			cache.addResource(std::move(positionLayout));
+		}
+
 		return true;
 	}
 
@@ -241,6 +422,9 @@ namespace Trinity
 		}
 
 		auto& fileSystem = FileSystem::get();
+		writer.write(&kMagic);
+		writer.write(&kVersion);
+
 		const uint32_t numMaterials = (uint32_t)mMaterials.size();
 		writer.write(&numMaterials);
 
@@ -271,6 +455,8 @@ namespace Trinity
 			}
 		}
 
+		writer.write(&mCompactVertices);
+
 		const uint32_t numMeshes = (uint32_t)mMeshes.size();
 		writer.write(&numMeshes);
 
@@ -295,8 +481,53 @@ namespace Trinity
 			writer.write(&mesh.numVertices);
 			writer.write(&mesh.numIndices);
 			writer.write(&mesh.materialIndex);
+			writer.writeVector(mesh.lods);
+			writer.writeVector(mesh.meshlets);
+		}
+
+		return true;
+	}
+
+	bool Model::readHeader(FileReader& reader, uint32_t& version, uint32_t& numMaterials)
+	{
+		uint32_t magic{ 0 };
+		reader.read(&magic);
+
+		if (magic != kMagic)
+		{
+			version = 0;
+			numMaterials = magic;
+			return true;
+		}
+
+		reader.read(&version);
+		if (version > kVersion)
+		{
+			LogError("Unsupported model version: %u!!", version);
+			return false;
 		}
 
+		reader.read(&numMaterials);
 		return true;
 	}
-}
\ No newline at end of file
+
+	BoundingBox Model::computeBounds(const Mesh& mesh)
+	{
+		if (mesh.numVertices == 0 || mesh.vertexSize < sizeof(glm::vec3))
+		{
+			return BoundingBox{ glm::vec3{ 0.0f }, glm::vec3{ 0.0f } };
+		}
+
+		glm::vec3 position{ 0.0f };
+		std::memcpy(&position, mesh.vertexData.data(), sizeof(glm::vec3));
+
+		BoundingBox bounds{ position, position };
+		for (uint32_t idx = 1; idx < mesh.numVertices; idx++)
+		{
+			std::memcpy(&position, mesh.vertexData.data() + (size_t)idx * mesh.vertexSize, sizeof(glm::vec3));
+			bounds.combinePoint(position);
+		}
+
+		return bounds;
+	}
+}
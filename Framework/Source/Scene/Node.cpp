@@ -1,6 +1,7 @@
 #include "Scene/Node.h"
 #include "Scene/ComponentFactory.h"
 #include "Scene/Scene.h"
+#include "Scene/TransformHierarchy.h"
 #include "Scene/Components/Script.h"
 #include "VFS/FileReader.h"
 #include "VFS/FileWriter.h"
@@ -30,12 +31,22 @@ namespace Trinity
 
 	void Node::setParent(Node& parent)
 	{
+		if (auto* hierarchy = mTransform.getHierarchy(); hierarchy != nullptr)
+		{
+			hierarchy->invalidate();
+		}
+
 		mParent = &parent;
 		mTransform.invalidateWorldMatrix();
 	}
 
 	void Node::addChild(Node& child)
 	{
+		if (auto* hierarchy = mTransform.getHierarchy(); hierarchy != nullptr)
+		{
+			hierarchy->invalidate();
+		}
+
 		mChildren.push_back(&child);
 	}
 
@@ -84,6 +95,7 @@ namespace Trinity
 				return false;
 			}
 
+			child->setParent(*this);
 			addChild(*child);
 			scene.addNode(std::move(child));
 		}
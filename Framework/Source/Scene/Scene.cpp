@@ -27,6 +27,15 @@ namespace Trinity
 	{
 		Resource::destroy();
 
+		for (auto& it : mComponents)
+		{
+			for (auto& component : it.second)
+			{
+				component->destroy();
+			}
+		}
+
+		mTransformHierarchy.destroy();
 		mNodes.clear();
 		mComponents.clear();
 	}
@@ -41,6 +50,23 @@ namespace Trinity
 		return typeid(Scene);
 	}
 
+	bool Scene::getDependencies(FileReader& reader, std::vector<ResourceDependency>& dependencies)
+	{
+		Scene scene;
+		scene.mComponentFactory = std::make_unique<ComponentFactory>();
+		scene.registerDefaultComponents();
+		scene.mPendingDependencies = &dependencies;
+
+		ResourceCache cache;
+		if (!scene.read(reader, cache))
+		{
+			LogError("Scene::read() failed while gathering dependencies!!");
+			return false;
+		}
+
+		return true;
+	}
+
 	void Scene::registerDefaultComponents()
 	{
 		mComponentFactory->registerCreator<Light>();
@@ -50,6 +76,16 @@ namespace Trinity
 		mComponentFactory->registerCreator<Animator>();
 	}
 
+	void Scene::updateTransforms()
+	{
+		if (mTransformHierarchy.needsRebuild() && mRoot != nullptr)
+		{
+			mTransformHierarchy.build(*mRoot);
+		}
+
+		mTransformHierarchy.update();
+	}
+
 	bool Scene::hasComponent(const std::type_index& type) const
 	{
 		auto it = mComponents.find(type);
@@ -100,6 +136,7 @@ namespace Trinity
 
 	void Scene::addNode(std::unique_ptr<Node> node)
 	{
+		mTransformHierarchy.invalidate();
 		node->setId((uint32_t)mNodes.size());
 		mNodes.emplace_back(std::move(node));
 	}
@@ -109,11 +146,14 @@ namespace Trinity
 		if (mRoot != nullptr)
 		{
 			mRoot->addChild(child);
+			child.setParent(*mRoot);
 		}
 	}
 
 	void Scene::setNodes(std::vector<std::unique_ptr<Node>> nodes)
 	{
+		mTransformHierarchy.destroy();
+
 		uint32_t id{ 0 };
 		for (auto& node : nodes)
 		{
@@ -125,6 +165,7 @@ namespace Trinity
 
 	void Scene::setRoot(Node& node)
 	{
+		mTransformHierarchy.invalidate();
 		mRoot = &node;
 	}
 
@@ -173,7 +214,15 @@ namespace Trinity
 		auto* mesh = meshPtr.get();
 		meshNode->setComponent(*mesh);
 
-		addChild(*meshNode);
+		if (parent != nullptr)
+		{
+			parent->addChild(*meshNode);
+		}
+		else
+		{
+			addChild(*meshNode);
+		}
+
 		addComponent(std::move(meshPtr), *meshNode);
 		addNode(std::move(meshNode));
 
@@ -205,7 +254,15 @@ namespace Trinity
 		auto* light = lightPtr.get();
 		lightNode->setComponent(*light);
 
-		addChild(*lightNode);
+		if (parent != nullptr)
+		{
+			parent->addChild(*lightNode);
+		}
+		else
+		{
+			addChild(*lightNode);
+		}
+
 		addComponent(std::move(lightPtr), *lightNode);
 		addNode(std::move(lightNode));
 
@@ -258,7 +315,15 @@ namespace Trinity
 		auto* camera = cameraPtr.get();
 		cameraNode->setComponent(*camera);
 
-		addChild(*cameraNode);
+		if (parent != nullptr)
+		{
+			parent->addChild(*cameraNode);
+		}
+		else
+		{
+			addChild(*cameraNode);
+		}
+
 		addComponent(std::move(cameraPtr), *cameraNode);
 		addNode(std::move(cameraNode));
 
@@ -335,6 +400,7 @@ namespace Trinity
 
 	bool Scene::read(FileReader& reader, ResourceCache& cache)
 	{
+		mTransformHierarchy.destroy();
 		mNodes.clear();
 		mComponents.clear();
 
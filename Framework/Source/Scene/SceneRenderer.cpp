@@ -8,6 +8,7 @@
 #include "Scene/Model.h"
 #include "Graphics/PBRMaterial.h"
 #include "Graphics/RenderPipeline.h"
+#include "Graphics/PipelineCache.h"
 #include "Graphics/Material.h"
 #include "Graphics/BindGroup.h"
 #include "Graphics/BindGroupLayout.h"
@@ -18,12 +19,27 @@
 #include "Graphics/RenderPass.h"
 #include "Animation/Skeleton.h"
 #include "Animation/AnimationPose.h"
+#include "Math/Frustum.h"
 #include "Core/Logger.h"
 #include "Core/Debugger.h"
+#include "Core/Clock.h"
 #include "Core/ResourceCache.h"
+#include "Utils/SortHelper.h"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
 
 namespace Trinity
 {
+	// every draw binds a window of kMaxInstancesPerDraw transforms starting at its batch offset
+	static constexpr uint32_t kTransformBindingSize = SceneRenderer::kMaxInstancesPerDraw *
+		sizeof(SceneRenderer::TransformBufferData);
+
+	static uint32_t getRendererIndex(uint64_t sortKey)
+	{
+		return (uint32_t)(sortKey & ((1ull << SceneRenderer::kSortIndexBits) - 1));
+	}
+
 	bool SceneRenderer::prepare(Scene& scene, ResourceCache& cache)
 	{
 		mSceneData.scene = &scene;
@@ -36,6 +52,19 @@ namespace Trinity
 		}
 
 		auto meshes = mSceneData.scene->getComponents<Mesh>();
+
+		uint32_t numRenderers{ 0 };
+		for (auto& mesh : meshes)
+		{
+			numRenderers += (uint32_t)mesh->getSubMeshes().size();
+		}
+
+		if (!setupTransformData(numRenderers))
+		{
+			LogError("setupTransformData() failed!!");
+			return false;
+		}
+
 		for (auto& mesh : meshes)
 		{
 			const auto& subMeshes = mesh->getSubMeshes();
@@ -50,11 +79,150 @@ namespace Trinity
 
 				mRenderers.push_back(std::move(renderData));
 			}
+
+			// the sub meshes of a mesh are adjacent, so a moved node maps to one run of renderers
+			mTransformRenderers[&mesh->getNode()->getTransform()] = std::make_pair(
+				(uint32_t)mRenderers.size() - (uint32_t)subMeshes.size(), (uint32_t)subMeshes.size());
+		}
+
+		// dense ids keep the sort keys small, draws sharing a pipeline or material end up adjacent
+		std::unordered_map<const RenderPipeline*, uint32_t> pipelineIds;
+		std::unordered_map<const BindGroup*, uint32_t> materialIds;
+		std::unordered_map<const VertexBuffer*, uint32_t> geometryIds;
+
+		for (auto& renderData : mRenderers)
+		{
+			renderData.pipelineId = pipelineIds.emplace(renderData.pipeline, (uint32_t)pipelineIds.size()).first->second;
+			renderData.materialId = materialIds.emplace(renderData.materialBindGroup, (uint32_t)materialIds.size()).first->second;
+			renderData.geometryId = geometryIds.emplace(renderData.subMesh->getVertexBuffer(),
+				(uint32_t)geometryIds.size()).first->second;
+		}
+
+		if (mRenderers.size() > (1ull << kSortIndexBits))
+		{
+			LogError("SceneRenderer::prepare() failed, too many renderers: %d!!", (uint32_t)mRenderers.size());
+			return false;
+		}
+
+		if (mGpuCullingEnabled && !setupIndirectDraws())
+		{
+			LogError("setupIndirectDraws() failed!!");
+			return false;
+		}
+
+		// meshlets refine the cpu batches, so renderers the gpu culls per instance are left out
+		if (mMeshletCullingEnabled && !setupMeshlets())
+		{
+			LogError("setupMeshlets() failed!!");
+			return false;
+		}
+
+		// the depth pyramid is tested in the culling stage, so occlusion culling only covers gpu culled draws
+		if (mGpuCullingEnabled && mOcclusionCullingEnabled && !updateDepthPyramid())
+		{
+			LogError("updateDepthPyramid() failed!!");
+			return false;
+		}
+
+		// skinned meshes never get a proxy, so the tree can't hand them out
+		for (uint32_t idx = 0; idx < (uint32_t)mRenderers.size(); idx++)
+		{
+			if (!mRenderers[idx].gpuCulled && mRenderers[idx].mesh->isAnimated())
+			{
+				mUntrackedRenderers.push_back(idx);
+			}
 		}
 
+		mSceneData.scene->updateTransforms();
+		for (auto& renderData : mRenderers)
+		{
+			updateWorldBounds(renderData);
+		}
+
+		mSceneData.scene->getTransformHierarchy().clearChanges();
+
 		return true;
 	}
 
+	void SceneRenderer::setCullingEnabled(bool enabled)
+	{
+		mCullingEnabled = enabled;
+	}
+
+	void SceneRenderer::setGpuCullingEnabled(bool enabled)
+	{
+		mGpuCullingEnabled = enabled;
+	}
+
+	void SceneRenderer::setOcclusionCullingEnabled(bool enabled)
+	{
+		mOcclusionCullingEnabled = enabled;
+	}
+
+	void SceneRenderer::setDepthPrepassEnabled(bool enabled)
+	{
+		mDepthPrepassEnabled = enabled;
+	}
+
+	void SceneRenderer::setMeshletCullingEnabled(bool enabled)
+	{
+		mMeshletCullingEnabled = enabled;
+	}
+
+	void SceneRenderer::setLodThreshold(float threshold)
+	{
+		mLodThreshold = threshold;
+	}
+
+	void SceneRenderer::setDepthPrepass(const Mesh& mesh, bool enabled)
+	{
+		// only renderers that got depth pipelines in prepare() can switch
+		for (auto& renderData : mRenderers)
+		{
+			if (renderData.mesh == &mesh && renderData.depthPipeline != nullptr && !renderData.gpuCulled)
+			{
+				renderData.depthPrepass = enabled;
+				renderData.pipeline = enabled ? renderData.equalPipeline : renderData.defaultPipeline;
+			}
+		}
+	}
+
+	Mesh* SceneRenderer::pick(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, float& distance)
+	{
+		const glm::vec3 invDirection = 1.0f / direction;
+		Mesh* result{ nullptr };
+
+		// the tree is refreshed once per frame in draw(), queries take it as it is
+		distance = maxDistance;
+		mBoundsTree.raycast(origin, direction, maxDistance, [&](uint32_t idx, float) {
+			const auto& renderData = mRenderers[idx];
+
+			float hitDistance{ 0.0f };
+			if (BoundingVolumeHierarchy::intersectRay(renderData.worldBounds, origin, invDirection, distance, hitDistance) &&
+				hitDistance < distance)
+			{
+				distance = hitDistance;
+				result = renderData.mesh;
+			}
+
+			return distance;
+		});
+
+		return result;
+	}
+
+	void SceneRenderer::queryOverlaps(const BoundingBox& bounds, std::vector<Mesh*>& meshes)
+	{
+		mBoundsTree.query(bounds, [&](uint32_t idx) {
+			const auto& renderData = mRenderers[idx];
+			if (renderData.worldBounds.isIntersecting(bounds) &&
+				std::find(meshes.begin(), meshes.end(), renderData.mesh) == meshes.end())
+			{
+				meshes.push_back(renderData.mesh);
+			}
+		});
+	}
+
 	void SceneRenderer::setCamera(const std::string& nodeName)
 	{
 		auto cameraNode = mSceneData.scene->findNode(nodeName);
@@ -72,29 +240,137 @@ namespace Trinity
 
 	void SceneRenderer::draw(RenderPass& renderPass)
 	{
+		mSceneData.scene->updateTransforms();
+		updateBounds();
+
 		if (!updateSceneData())
 		{
 			LogError("updateSceneData() failed!!");
 			return;
 		}
 
-		std::multimap<float, RenderData*> opaqueRenderers;
-		std::multimap<float, RenderData*> transparentRenderers;
+		cullRenderers();
+		selectLods();
+		sortRenderers(kMainPass);
+
+		if (!buildBatches())
+		{
+			LogError("buildBatches() failed!!");
+			return;
+		}
+
+		const bool occlusionCulling = mCullingPass.isOcclusionEnabled() && !mIndirectDraws.empty();
+		if (occlusionCulling && !updateDepthPyramid())
+		{
+			LogError("updateDepthPyramid() failed!!");
+			return;
+		}
+
+		// the culling pass is submitted on its own, so it runs before this render pass
+		if (!updateIndirectDraws())
+		{
+			LogError("updateIndirectDraws() failed!!");
+			return;
+		}
+
+		if (!updateMeshlets())
+		{
+			LogError("updateMeshlets() failed!!");
+			return;
+		}
 
-		getSortedRenderers(opaqueRenderers, transparentRenderers);
 		renderPass.setBindGroup(kSceneBindGroupIndex, *mSceneData.sceneBindGroup);
 
-		for (auto it = opaqueRenderers.begin(); it != opaqueRenderers.end(); it++)
+		mDrawState = {};
+		mStats.numPipelineChanges = 0;
+		mStats.numBindGroupChanges = 0;
+		mStats.numPrepassDraws = 0;
+
+		// depth only draws go first, so the main pass shades every pixel once with an equal depth test
+		const TimePoint prepassStartTime = std::chrono::high_resolution_clock::now();
+		for (const auto& batch : mDrawBatches)
+		{
+			if (mRenderers[getRendererIndex(mSortKeys[batch.firstKey])].depthPrepass)
+			{
+				drawDepth(renderPass, batch);
+			}
+		}
+
+		const TimePoint mainPassStartTime = std::chrono::high_resolution_clock::now();
+		mStats.prepassTime = Duration(mainPassStartTime - prepassStartTime).count();
+
+		mDrawState = {};
+		mStats.numIndirectDraws = (uint32_t)mIndirectDraws.size() * (occlusionCulling ? 2 : 1);
+		mStats.numDrawCalls = (uint32_t)mDrawBatches.size() + mStats.numIndirectDraws + mStats.numPrepassDraws;
+
+		// indirect draws are all opaque, so they go before the sorted batches that end with transparents
+		for (uint32_t idx = 0; idx < (uint32_t)mIndirectDraws.size(); idx++)
+		{
+			draw(renderPass, mIndirectDraws[idx], idx);
+		}
+
+		uint32_t batchIdx{ 0 };
+		for (; batchIdx < (uint32_t)mDrawBatches.size(); batchIdx++)
+		{
+			const auto& batch = mDrawBatches[batchIdx];
+			if (occlusionCulling && mRenderers[getRendererIndex(mSortKeys[batch.firstKey])].transparent)
+			{
+				break;
+			}
+
+			draw(renderPass, batch);
+		}
+
+		if (occlusionCulling)
 		{
-			auto* renderer = it->second;
-			draw(renderPass, *renderer);
+			// the opaque depth so far builds the pyramid, the pass picks up again once
+			// the late phase has found what the early draws missed
+			renderPass.end();
+			renderPass.submit();
+
+			auto* camera = mSceneData.camera;
+			const glm::mat4 viewProj = camera->getProjection() * camera->getView();
+			const auto& swapChain = GraphicsDevice::get().getSwapChain();
+
+			if (!mDepthPyramid.build(swapChain.getDepthStencilView()))
+			{
+				LogError("DepthPyramid::build() failed!!");
+				return;
+			}
+
+			if (!mCullingPass.cull(Frustum(viewProj), viewProj, CullingPhase::Late))
+			{
+				LogError("CullingPass::cull() failed!!");
+				return;
+			}
+
+			if (!renderPass.resume())
+			{
+				LogError("RenderPass::resume() failed!!");
+				return;
+			}
+
+			renderPass.setBindGroup(kSceneBindGroupIndex, *mSceneData.sceneBindGroup);
+			mDrawState = {};
+
+			for (uint32_t idx = 0; idx < (uint32_t)mIndirectDraws.size(); idx++)
+			{
+				draw(renderPass, mIndirectDraws[idx], idx);
+			}
+
+			const auto& cullingStats = mCullingPass.getStats();
+			mStats.numOccluded = cullingStats.numOccluded;
+			mStats.numEarlyInstances = cullingStats.numEarly;
+			mStats.numLateInstances = cullingStats.numLate;
 		}
 
-		for (auto it = transparentRenderers.rbegin(); it != transparentRenderers.rend(); it++)
+		for (; batchIdx < (uint32_t)mDrawBatches.size(); batchIdx++)
 		{
-			auto* renderer = it->second;
-			draw(renderPass, *renderer);
+			draw(renderPass, mDrawBatches[batchIdx]);
 		}
+
+		// cpu encoding time only, the gpu side shows up in the frame time when toggling the prepass
+		mStats.mainPassTime = Duration(std::chrono::high_resolution_clock::now() - mainPassStartTime).count();
 	}
 
 	bool SceneRenderer::setupRenderData(Mesh* mesh, SubMesh* subMesh, RenderData& renderData)
@@ -102,9 +378,9 @@ namespace Trinity
 		renderData.subMesh = subMesh;
 		renderData.mesh = mesh;
 
-		if (!updateMeshData(mesh, mesh->getNode(), renderData))
+		if (!setupMeshData(mesh, renderData))
 		{
-			LogError("updateTransformData() failed!!");
+			LogError("setupMeshData() failed!!");
 			return false;
 		}
 
@@ -160,211 +436,623 @@ namespace Trinity
 			};
 		}
 
-		auto pipeline = std::make_unique<RenderPipeline>();
-		if (!pipeline->create(renderProps))
+		auto* pipeline = PipelineCache::get().getRenderPipeline(renderProps);
+		if (!pipeline)
 		{
-			LogError("RenderPipeline::create() failed!!");
+			LogError("PipelineCache::getRenderPipeline() failed!!");
 			return false;
 		}
 
-		renderData.pipeline = pipeline.get();
+		renderData.pipeline = pipeline;
+		renderData.defaultPipeline = pipeline;
 		renderData.materialBindGroup = material->getBindGroup();
-		mSceneData.cache->addResource(std::move(pipeline));
+		renderData.transparent = material->getAlphaMode() == AlphaMode::Blend;
+
+		if (mDepthPrepassEnabled && !setupDepthPrepass(material, renderProps, renderData))
+		{
+			LogError("setupDepthPrepass() failed!!");
+			return false;
+		}
 
 		return true;
 	}
 
-	bool SceneRenderer::updateMeshData(Mesh* mesh, Node* node, RenderData& renderData)
+	bool SceneRenderer::setupDepthPrepass(const Material* material, const RenderPipelineProperties& renderProps,
+		RenderData& renderData)
 	{
-		if (renderData.transformBuffer == nullptr)
+		// alpha tested materials need their fragment stage for depth, skinned meshes have no position layout
+		if (!renderProps.depthStencil || material->getAlphaMode() != AlphaMode::Opaque ||
+			!renderData.subMesh->hasPositionLayout())
 		{
-			TransformBufferData transformData{};
-			if (node != nullptr)
-			{
-				transformData.transform = node->getTransform().getMatrix();
-				transformData.rotation = glm::transpose(glm::inverse(transformData.transform));
-			}
+			return true;
+		}
+
+		if (mSceneData.depthShader == nullptr)
+		{
+			ShaderPreProcessor processor;
 
-			auto transformBuffer = std::make_unique<UniformBuffer>();
-			if (!transformBuffer->create(sizeof(TransformBufferData), &transformData))
+			auto shader = std::make_unique<Shader>();
+			if (!shader->load(kDepthShader, processor))
 			{
-				LogError("UniformBuffer::create() failed!!");
+				LogError("Shader::load() failed for: %s!!", kDepthShader);
 				return false;
 			}
 
-			std::vector<BindGroupLayoutItem> meshLayoutItems = {
-				{
-					.binding = 0,
-					.shaderStages = wgpu::ShaderStage::Vertex,
-					.bindingLayout = BufferBindingLayout {
-						.type = wgpu::BufferBindingType::Uniform,
-						.minBindingSize = sizeof(TransformBufferData)
-					}
-				}
-			};
-
-			std::vector<BindGroupItem> meshItems = {
-				{
-					.binding = 0,
-					.size = sizeof(TransformBufferData),
-					.resource = BufferBindingResource(*transformBuffer)
-				}
-			};
-
-			if (renderData.mesh->isAnimated())
-			{
-				const auto& invBindPose = renderData.mesh->getInvBindPose();
-				const auto& bindPose = renderData.mesh->getBindPose();
+			mSceneData.depthShader = shader.get();
+			mSceneData.cache->addResource(std::move(shader));
+		}
 
-				auto invBindPoseBuffer = std::make_unique<StorageBuffer>();
-				if (!invBindPoseBuffer->create(sizeof(glm::mat4) * (uint32_t)invBindPose.size(), invBindPose.data()))
-				{
-					LogError("StorageBuffer::create() failed");
-					return false;
-				}
+		// depth pipelines only depend on the vertex layout, so every static opaque mesh shares them
+		RenderPipelineProperties depthProps = {
+			.shader = mSceneData.depthShader,
+			.fsEntry = "",
+			.bindGroupLayouts = {
+				mSceneData.sceneBindGroupLayout,
+				mSceneData.transformBindGroupLayout
+			},
+			.vertexLayouts = { renderData.subMesh->getPositionLayout() },
+			.primitive = renderProps.primitive,
+			.depthStencil = DepthStencilState{
+				.format = renderProps.depthStencil->format,
+				.depthWriteEnabled = true,
+				.depthCompare = wgpu::CompareFunction::Less
+			}
+		};
 
-				auto bindPoseBuffer = std::make_unique<StorageBuffer>();
-				if (!bindPoseBuffer->create(sizeof(glm::mat4) * (uint32_t)bindPose.size(), bindPose.data()))
-				{
-					LogError("StorageBuffer::create() failed");
-					return false;
-				}
+		renderData.depthPipeline = PipelineCache::get().getRenderPipeline(depthProps);
+		if (!renderData.depthPipeline)
+		{
+			LogError("PipelineCache::getRenderPipeline() failed!!");
+			return false;
+		}
 
-				meshLayoutItems.push_back({
-					.binding = 1,
-					.shaderStages = wgpu::ShaderStage::Vertex,
-					.bindingLayout = BufferBindingLayout {
-						.type = wgpu::BufferBindingType::ReadOnlyStorage,
-						.minBindingSize = (uint32_t)invBindPose.size() * (uint32_t)sizeof(glm::mat4)
-					}
-				});
+		RenderPipelineProperties equalProps = renderProps;
+		equalProps.depthStencil->depthWriteEnabled = false;
+		equalProps.depthStencil->depthCompare = wgpu::CompareFunction::Equal;
 
-				meshLayoutItems.push_back({
-					.binding = 2,
-					.shaderStages = wgpu::ShaderStage::Vertex,
-					.bindingLayout = BufferBindingLayout {
-						.type = wgpu::BufferBindingType::ReadOnlyStorage,
-						.minBindingSize = (uint32_t)bindPose.size() * (uint32_t)sizeof(glm::mat4)
-					}
-				});
+		renderData.equalPipeline = PipelineCache::get().getRenderPipeline(equalProps);
+		if (!renderData.equalPipeline)
+		{
+			LogError("PipelineCache::getRenderPipeline() failed!!");
+			return false;
+		}
 
-				meshItems.push_back({
-					.binding = 1,
-					.size = (uint32_t)invBindPose.size() * sizeof(glm::mat4),
-					.resource = BufferBindingResource(*invBindPoseBuffer)
-				});
+		renderData.pipeline = renderData.equalPipeline;
+		renderData.depthPrepass = true;
 
-				meshItems.push_back({
-					.binding = 2,
-					.size = (uint32_t)invBindPose.size() * sizeof(glm::mat4),
-					.resource = BufferBindingResource(*bindPoseBuffer)
-				});
+		return true;
+	}
 
-				renderData.meshInvBindPoseBuffer = invBindPoseBuffer.get();
-				renderData.meshBindPoseBuffer = bindPoseBuffer.get();
-				mSceneData.cache->addResource(std::move(invBindPoseBuffer));
-				mSceneData.cache->addResource(std::move(bindPoseBuffer));
-			}
+	bool SceneRenderer::setupTransformData(uint32_t numRenderers)
+	{
+		if (!mTransformAllocator.create(numRenderers * UniformAllocator::align(sizeof(TransformBufferData)),
+			kTransformBindingSize))
+		{
+			LogError("UniformAllocator::create() failed!!");
+			return false;
+		}
 
-			auto bindGroupLayout = std::make_unique<BindGroupLayout>();
-			if (!bindGroupLayout->create(meshLayoutItems))
+		std::vector<BindGroupLayoutItem> transformLayoutItems = {
 			{
-				LogError("BindGroupLayout::create() failed!!");
-				return false;
+				.binding = 0,
+				.shaderStages = wgpu::ShaderStage::Vertex,
+				.bindingLayout = BufferBindingLayout {
+					.type = wgpu::BufferBindingType::Uniform,
+					.hasDynamicOffset = true,
+					.minBindingSize = kTransformBindingSize
+				}
 			}
+		};
 
-			auto bindGroup = std::make_unique<BindGroup>();
-			if (!bindGroup->create(*bindGroupLayout, meshItems))
+		std::vector<BindGroupItem> transformItems = {
 			{
-				LogError("BindGroup::create() failed!!");
-				return false;
+				.binding = 0,
+				.size = kTransformBindingSize,
+				.resource = BufferBindingResource(*mTransformAllocator.getBuffer())
 			}
+		};
 
-			renderData.transformBuffer = transformBuffer.get();
-			renderData.meshBindGroup = bindGroup.get();
-			renderData.meshBindGroupLayout = bindGroupLayout.get();
-
-			mSceneData.cache->addResource(std::move(transformBuffer));
-			mSceneData.cache->addResource(std::move(bindGroupLayout));
-			mSceneData.cache->addResource(std::move(bindGroup));
+		auto bindGroupLayout = std::make_unique<BindGroupLayout>();
+		if (!bindGroupLayout->create(transformLayoutItems))
+		{
+			LogError("BindGroupLayout::create() failed!!");
+			return false;
 		}
-		else 
+
+		auto bindGroup = std::make_unique<BindGroup>();
+		if (!bindGroup->create(*bindGroupLayout, transformItems))
 		{
-			if (renderData.mesh->isAnimated())
-			{
-				auto& bindPose = renderData.mesh->getBindPose();
-				renderData.meshBindPoseBuffer->write(0, (uint32_t)bindPose.size() *
-					sizeof(glm::mat4), bindPose.data());
-			}
+			LogError("BindGroup::create() failed!!");
+			return false;
+		}
 
-			TransformBufferData transformData{};
-			if (node != nullptr)
-			{
-				transformData.transform = node->getTransform().getMatrix();
-				transformData.rotation = glm::transpose(glm::inverse(transformData.transform));
-			}
+		mSceneData.transformBindGroup = bindGroup.get();
+		mSceneData.transformBindGroupLayout = bindGroupLayout.get();
 
-			renderData.transformBuffer->write(0, sizeof(TransformBufferData), &transformData);
-		}
+		mSceneData.cache->addResource(std::move(bindGroupLayout));
+		mSceneData.cache->addResource(std::move(bindGroup));
 
 		return true;
 	}
 
-	bool SceneRenderer::updateSceneData()
+	bool SceneRenderer::setupMeshData(Mesh* mesh, RenderData& renderData)
 	{
-		if (mSceneData.sceneBuffer == nullptr)
+		// static meshes only need the transform, so they all share the dynamic offset bind group
+		if (!mesh->isAnimated())
 		{
-			SceneBufferData bufferData{};
+			renderData.meshBindGroup = mSceneData.transformBindGroup;
+			renderData.meshBindGroupLayout = mSceneData.transformBindGroupLayout;
+			return true;
+		}
 
-			auto sceneBuffer = std::make_unique<UniformBuffer>();
-			if (!sceneBuffer->create(sizeof(SceneBufferData), &bufferData))
+		const auto& invBindPose = mesh->getInvBindPose();
+		const auto& bindPose = mesh->getBindPose();
+
+		auto invBindPoseBuffer = std::make_unique<StorageBuffer>();
+		if (!invBindPoseBuffer->create(sizeof(glm::mat4) * (uint32_t)invBindPose.size(), invBindPose.data()))
+		{
+			LogError("StorageBuffer::create() failed");
+			return false;
+		}
+
+		auto bindPoseBuffer = std::make_unique<StorageBuffer>();
+		if (!bindPoseBuffer->create(sizeof(glm::mat4) * (uint32_t)bindPose.size(), bindPose.data()))
+		{
+			LogError("StorageBuffer::create() failed");
+			return false;
+		}
+
+		std::vector<BindGroupLayoutItem> meshLayoutItems = {
 			{
-				LogError("UniformBuffer::create() failed!!");
-				return false;
+				.binding = 0,
+				.shaderStages = wgpu::ShaderStage::Vertex,
+				.bindingLayout = BufferBindingLayout {
+					.type = wgpu::BufferBindingType::Uniform,
+					.hasDynamicOffset = true,
+					.minBindingSize = kTransformBindingSize
+				}
+			},
+			{
+				.binding = 1,
+				.shaderStages = wgpu::ShaderStage::Vertex,
+				.bindingLayout = BufferBindingLayout {
+					.type = wgpu::BufferBindingType::ReadOnlyStorage,
+					.minBindingSize = (uint32_t)invBindPose.size() * (uint32_t)sizeof(glm::mat4)
+				}
+			},
+			{
+				.binding = 2,
+				.shaderStages = wgpu::ShaderStage::Vertex,
+				.bindingLayout = BufferBindingLayout {
+					.type = wgpu::BufferBindingType::ReadOnlyStorage,
+					.minBindingSize = (uint32_t)bindPose.size() * (uint32_t)sizeof(glm::mat4)
+				}
 			}
+		};
 
-			if (!updateLights())
+		std::vector<BindGroupItem> meshItems = {
 			{
-				LogError("setupLights() failed!!");
-				return false;
+				.binding = 0,
+				.size = kTransformBindingSize,
+				.resource = BufferBindingResource(*mTransformAllocator.getBuffer())
+			},
+			{
+				.binding = 1,
+				.size = (uint32_t)invBindPose.size() * sizeof(glm::mat4),
+				.resource = BufferBindingResource(*invBindPoseBuffer)
+			},
+			{
+				.binding = 2,
+				.size = (uint32_t)invBindPose.size() * sizeof(glm::mat4),
+				.resource = BufferBindingResource(*bindPoseBuffer)
 			}
+		};
 
-			std::vector<BindGroupLayoutItem> sceneLayoutItems = {
-				{
-					.binding = 0,
-					.shaderStages = wgpu::ShaderStage::Vertex | wgpu::ShaderStage::Fragment,
+		auto bindGroupLayout = std::make_unique<BindGroupLayout>();
+		if (!bindGroupLayout->create(meshLayoutItems))
+		{
+			LogError("BindGroupLayout::create() failed!!");
+			return false;
+		}
+
+		auto bindGroup = std::make_unique<BindGroup>();
+		if (!bindGroup->create(*bindGroupLayout, meshItems))
+		{
+			LogError("BindGroup::create() failed!!");
+			return false;
+		}
+
+		renderData.meshInvBindPoseBuffer = invBindPoseBuffer.get();
+		renderData.meshBindPoseBuffer = bindPoseBuffer.get();
+		renderData.meshBindGroup = bindGroup.get();
+		renderData.meshBindGroupLayout = bindGroupLayout.get();
+
+		mSceneData.cache->addResource(std::move(invBindPoseBuffer));
+		mSceneData.cache->addResource(std::move(bindPoseBuffer));
+		mSceneData.cache->addResource(std::move(bindGroupLayout));
+		mSceneData.cache->addResource(std::move(bindGroup));
+
+		return true;
+	}
+
+	bool SceneRenderer::updateMeshData(Mesh* mesh, Node* node, RenderData& renderData)
+	{
+		if (mesh->isAnimated())
+		{
+			auto& bindPose = mesh->getBindPose();
+			renderData.meshBindPoseBuffer->write(0, (uint32_t)bindPose.size() *
+				sizeof(glm::mat4), bindPose.data());
+		}
+
+		// the normal matrix needs an inverse, so it is only rebuilt when the node moved
+		if (node != nullptr)
+		{
+			const auto& transform = node->getTransform();
+			const auto& worldMatrix = transform.getWorldMatrix();
+
+			if (renderData.transformVersion != transform.getWorldVersion())
+			{
+				renderData.transformData.transform = worldMatrix;
+				renderData.transformData.rotation = glm::transpose(glm::inverse(worldMatrix));
+				renderData.transformVersion = transform.getWorldVersion();
+			}
+		}
+
+		return true;
+	}
+
+	bool SceneRenderer::setupIndirectDraws()
+	{
+		mIndirectRenderers.clear();
+		mIndirectDraws.clear();
+
+		// skinned, transparent and non indexed draws stay on the cpu path
+		std::vector<uint64_t> keys;
+		for (uint32_t idx = 0; idx < (uint32_t)mRenderers.size(); idx++)
+		{
+			auto& renderData = mRenderers[idx];
+			if (!renderData.mesh->isAnimated() && !renderData.transparent && renderData.subMesh->hasIndexBuffer())
+			{
+				// the depth prepass only covers the cpu batches, indirect draws keep the regular depth test
+				renderData.depthPrepass = false;
+				renderData.pipeline = renderData.defaultPipeline;
+
+				keys.push_back(getSortKey(kMainPass, renderData, 0.0f, idx));
+			}
+		}
+
+		std::vector<uint64_t> scratch;
+		SortHelper::radixSort(keys, scratch);
+
+		std::vector<CullingPass::DrawData> draws;
+		std::vector<uint32_t> numInstances;
+		uint32_t outputSize{ 0 };
+
+		for (const auto key : keys)
+		{
+			auto& renderData = mRenderers[getRendererIndex(key)];
+
+			if (mIndirectDraws.empty() || numInstances.back() == kMaxInstancesPerDraw ||
+				!canInstance(mRenderers[mIndirectRenderers[mIndirectDraws.back().firstRenderer]], renderData))
+			{
+				if (!mIndirectDraws.empty())
+				{
+					outputSize += numInstances.back() * (uint32_t)sizeof(TransformBufferData);
+				}
+
+				// every draw binds its window at a dynamic offset, which has to be aligned
+				outputSize = UniformAllocator::align(outputSize);
+
+				mIndirectDraws.push_back({
+					.firstRenderer = (uint32_t)mIndirectRenderers.size(),
+					.transformOffset = outputSize
+				});
+
+				draws.push_back({
+					.args = {
+						.indexCount = renderData.subMesh->getNumIndices()
+					},
+					.firstOutput = outputSize / (uint32_t)sizeof(TransformBufferData)
+				});
+
+				numInstances.push_back(0);
+			}
+
+			numInstances.back()++;
+			renderData.gpuCulled = true;
+			mIndirectRenderers.push_back(getRendererIndex(key));
+		}
+
+		if (!mIndirectDraws.empty())
+		{
+			outputSize += numInstances.back() * (uint32_t)sizeof(TransformBufferData);
+		}
+
+		// the tail keeps the window of the last draw inside the buffer
+		if (!mCullingPass.create((uint32_t)mIndirectRenderers.size(), sizeof(TransformBufferData), std::move(draws),
+			UniformAllocator::align(outputSize) + kTransformBindingSize, wgpu::BufferUsage::Uniform))
+		{
+			LogError("CullingPass::create() failed!!");
+			return false;
+		}
+
+		uint32_t drawIndex{ 0 };
+		for (uint32_t idx = 0; idx < (uint32_t)mIndirectRenderers.size(); idx++)
+		{
+			if (drawIndex + 1 < (uint32_t)mIndirectDraws.size() && mIndirectDraws[drawIndex + 1].firstRenderer == idx)
+			{
+				drawIndex++;
+			}
+
+			mCullingPass.setInstance(idx, {
+				.drawIndex = drawIndex,
+				.payloadIndex = idx
+			});
+		}
+
+		std::vector<BindGroupItem> indirectItems = {
+			{
+				.binding = 0,
+				.size = kTransformBindingSize,
+				.resource = BufferBindingResource(*mCullingPass.getOutputBuffer())
+			}
+		};
+
+		auto bindGroup = std::make_unique<BindGroup>();
+		if (!bindGroup->create(*mSceneData.transformBindGroupLayout, indirectItems))
+		{
+			LogError("BindGroup::create() failed!!");
+			return false;
+		}
+
+		mSceneData.indirectBindGroup = bindGroup.get();
+		mSceneData.cache->addResource(std::move(bindGroup));
+
+		return true;
+	}
+
+	bool SceneRenderer::updateIndirectDraws()
+	{
+		if (mIndirectDraws.empty())
+		{
+			return true;
+		}
+
+		// only renderers that moved are written, the culling pass uploads them as one range
+		for (uint32_t idx = 0; idx < (uint32_t)mIndirectRenderers.size(); idx++)
+		{
+			auto& renderData = mRenderers[mIndirectRenderers[idx]];
+			auto* node = renderData.mesh->getNode();
+
+			// the transform version only moves here for these renderers, pick() may refresh the bounds alone
+			if (renderData.transformVersion == node->getTransform().getWorldVersion())
+			{
+				continue;
+			}
+
+			updateWorldBounds(renderData);
+
+			if (!updateMeshData(renderData.mesh, node, renderData))
+			{
+				LogError("updateMeshData() failed!!");
+				return false;
+			}
+
+			const uint32_t drawIndex = mCullingPass.getInstance(idx).drawIndex;
+			mCullingPass.setInstance(idx, {
+				.center = renderData.worldBounds.getCenter(),
+				.drawIndex = drawIndex,
+				.extents = 0.5f * (renderData.worldBounds.max - renderData.worldBounds.min),
+				.payloadIndex = idx
+			});
+
+			mCullingPass.setPayload(idx, &renderData.transformData);
+		}
+
+		auto* camera = mSceneData.camera;
+		const glm::mat4 viewProj = camera->getProjection() * camera->getView();
+
+		// with occlusion culling this is only the early phase, draw() runs the late one
+		const CullingPhase phase = mCullingPass.isOcclusionEnabled() ? CullingPhase::Early : CullingPhase::All;
+		if (!mCullingPass.cull(Frustum(viewProj), viewProj, phase))
+		{
+			LogError("CullingPass::cull() failed!!");
+			return false;
+		}
+
+		return true;
+	}
+
+	bool SceneRenderer::setupMeshlets()
+	{
+		std::vector<MeshletCullingPass::MeshletData> meshlets;
+		std::vector<uint32_t> indices;
+		std::unordered_map<const IndexBuffer*, uint32_t> indexOffsets;
+		uint32_t numGroups{ 0 };
+
+		// skinned vertices move away from the imported bounds and cones
+		for (auto& renderData : mRenderers)
+		{
+			const auto* subMesh = renderData.subMesh;
+			if (renderData.gpuCulled || renderData.mesh->isAnimated() || !subMesh->hasIndexBuffer() ||
+				subMesh->getNumMeshlets() == 0 || subMesh->getMeshletIndices().empty())
+			{
+				continue;
+			}
+
+			renderData.meshletGroup = numGroups++;
+			renderData.meshletVersion = (uint32_t)-1;
+
+			// instances of a mesh share their source indices, only the output regions are per renderer
+			auto [it, inserted] = indexOffsets.try_emplace(subMesh->getIndexBuffer(), (uint32_t)indices.size());
+			if (inserted)
+			{
+				const auto& meshletIndices = subMesh->getMeshletIndices();
+				indices.insert(indices.end(), meshletIndices.begin(), meshletIndices.end());
+			}
+
+			for (const auto& meshlet : subMesh->getMeshlets())
+			{
+				meshlets.push_back({
+					.center = meshlet.center,
+					.radius = meshlet.radius,
+					.coneAxis = meshlet.coneAxis,
+					.coneCutoff = meshlet.coneCutoff,
+					.firstIndex = it->second + meshlet.firstIndex,
+					.numIndices = meshlet.numIndices,
+					.groupIndex = renderData.meshletGroup
+				});
+			}
+		}
+
+		if (!mMeshletCullingPass.create(std::move(meshlets), indices, numGroups))
+		{
+			LogError("MeshletCullingPass::create() failed!!");
+			return false;
+		}
+
+		return true;
+	}
+
+	bool SceneRenderer::updateMeshlets()
+	{
+		mStats.numMeshlets = 0;
+
+		if (mMeshletCullingPass.getNumMeshlets() == 0)
+		{
+			return true;
+		}
+
+		// buildBatches() has just refreshed the transforms of the visible renderers
+		for (auto idx : mVisibleRenderers)
+		{
+			auto& renderData = mRenderers[idx];
+			if (renderData.meshletGroup == (uint32_t)-1)
+			{
+				continue;
+			}
+
+			if (renderData.meshletVersion != renderData.transformVersion)
+			{
+				mMeshletCullingPass.setGroup(renderData.meshletGroup, {
+					.transform = renderData.transformData.transform,
+					.rotation = renderData.transformData.rotation
+				});
+
+				renderData.meshletVersion = renderData.transformVersion;
+			}
+
+			if (renderData.lod == 0)
+			{
+				mStats.numMeshlets += renderData.subMesh->getNumMeshlets();
+			}
+		}
+
+		auto* camera = mSceneData.camera;
+		const glm::mat4 viewProj = camera->getProjection() * camera->getView();
+		const auto& cameraMatrix = camera->getNode()->getTransform().getWorldMatrix();
+		const bool perspective = camera->getProjection()[2][3] != 0.0f;
+
+		if (!mMeshletCullingPass.cull(Frustum(viewProj), glm::vec3(cameraMatrix[3]),
+			-glm::normalize(glm::vec3(cameraMatrix[2])), perspective))
+		{
+			LogError("MeshletCullingPass::cull() failed!!");
+			return false;
+		}
+
+		const auto& meshletStats = mMeshletCullingPass.getStats();
+		mStats.numMeshletsFrustumCulled = meshletStats.numFrustumCulled;
+		mStats.numMeshletsConeCulled = meshletStats.numConeCulled;
+
+		return true;
+	}
+
+	bool SceneRenderer::updateDepthPyramid()
+	{
+		const auto& swapChain = GraphicsDevice::get().getSwapChain();
+
+		// the pyramid follows the swapchain depth, so a resize makes it again
+		if (mDepthPyramid.getDepthWidth() == swapChain.getWidth() &&
+			mDepthPyramid.getDepthHeight() == swapChain.getHeight())
+		{
+			return true;
+		}
+
+		mDepthPyramid.destroy();
+		if (!mDepthPyramid.create(swapChain.getWidth(), swapChain.getHeight()))
+		{
+			LogError("DepthPyramid::create() failed!!");
+			return false;
+		}
+
+		if (!mCullingPass.setDepthPyramid(&mDepthPyramid))
+		{
+			LogError("CullingPass::setDepthPyramid() failed!!");
+			return false;
+		}
+
+		return true;
+	}
+
+	bool SceneRenderer::updateSceneData()
+	{
+		if (mSceneData.sceneBuffer == nullptr)
+		{
+			SceneBufferData bufferData{};
+
+			auto sceneBuffer = std::make_unique<UniformBuffer>();
+			if (!sceneBuffer->create(sizeof(SceneBufferData), &bufferData))
+			{
+				LogError("UniformBuffer::create() failed!!");
+				return false;
+			}
+
+			if (!updateLights())
+			{
+				LogError("setupLights() failed!!");
+				return false;
+			}
+
+			if (!mLightClusters.create())
+			{
+				LogError("LightClusters::create() failed!!");
+				return false;
+			}
+
+			const std::vector<BindGroupLayoutItem> sceneLayoutItems = {
+				{
+					.binding = 0,
+					.shaderStages = wgpu::ShaderStage::Vertex | wgpu::ShaderStage::Fragment,
 					.bindingLayout = BufferBindingLayout {
 						.type = wgpu::BufferBindingType::Uniform,
 						.minBindingSize = sizeof(SceneBufferData)
 					}
-				}				
-			};
-
-			std::vector<BindGroupItem> sceneItems = {
+				},
 				{
-					.binding = 0,
-					.size = sizeof(SceneBufferData),
-					.resource = BufferBindingResource(*sceneBuffer)
-				}				
-			};
-
-			if (mLights.size() > 0)
-			{
-				sceneLayoutItems.push_back({
 					.binding = 1,
 					.shaderStages = wgpu::ShaderStage::Fragment,
 					.bindingLayout = BufferBindingLayout {
 						.type = wgpu::BufferBindingType::ReadOnlyStorage,
-						.minBindingSize = (uint32_t)mLights.size() * (uint32_t)sizeof(LightBufferData)
+						.minBindingSize = sizeof(LightBufferData)
 					}
-				});
-
-				sceneItems.push_back({
-					.binding = 1,
-					.size = (uint32_t)mLights.size() * sizeof(LightBufferData),
-					.resource = BufferBindingResource(*mSceneData.lightsBuffer)
-				});
-			}
+				},
+				{
+					.binding = 2,
+					.shaderStages = wgpu::ShaderStage::Fragment,
+					.bindingLayout = BufferBindingLayout {
+						.type = wgpu::BufferBindingType::ReadOnlyStorage,
+						.minBindingSize = LightClusters::kNumClusters * sizeof(glm::uvec2)
+					}
+				},
+				{
+					.binding = 3,
+					.shaderStages = wgpu::ShaderStage::Fragment,
+					.bindingLayout = BufferBindingLayout {
+						.type = wgpu::BufferBindingType::ReadOnlyStorage,
+						.minBindingSize = sizeof(uint32_t)
+					}
+				}
+			};
 
 			auto bindGroupLayout = std::make_unique<BindGroupLayout>();
 			if (!bindGroupLayout->create(sceneLayoutItems))
@@ -373,144 +1061,681 @@ namespace Trinity
 				return false;
 			}
 
-			auto bindGroup = std::make_unique<BindGroup>();
-			if (!bindGroup->create(*bindGroupLayout, sceneItems))
-			{
-				LogError("BindGroup::create() failed!!");
-				return false;
-			}
-
 			mSceneData.sceneBuffer = sceneBuffer.get();
-			mSceneData.sceneBindGroup = bindGroup.get();
 			mSceneData.sceneBindGroupLayout = bindGroupLayout.get();
 
 			mSceneData.cache->addResource(std::move(sceneBuffer));
-			mSceneData.cache->addResource(std::move(bindGroup));
 			mSceneData.cache->addResource(std::move(bindGroupLayout));
+
+			if (!createSceneBindGroup())
+			{
+				LogError("SceneRenderer::createSceneBindGroup() failed!!");
+				return false;
+			}
 		}
 		else
 		{
+			if (!updateLights())
+			{
+				LogError("SceneRenderer::updateLights() failed!!");
+				return false;
+			}
+
 			Camera* camera = mSceneData.camera;
 			if (camera != nullptr)
 			{
+				if (!updateClusters())
+				{
+					LogError("SceneRenderer::updateClusters() failed!!");
+					return false;
+				}
+
+				const auto& tileSize = mLightClusters.getTileSize();
+
 				SceneBufferData bufferData = {
 					.view = camera->getView(),
 					.projection = camera->getProjection(),
 					.cameraPos = camera->getNode()->getTransform().getTranslation(),
-					.numLights = (uint32_t)mLights.size()
+					.numLights = (uint32_t)mLights.size(),
+					.clusterSize = {
+						LightClusters::kNumClustersX,
+						LightClusters::kNumClustersY,
+						LightClusters::kNumClustersZ,
+						mLightClusters.getNumGlobalLights()
+					},
+					.clusterParams = {
+						tileSize.x,
+						tileSize.y,
+						mLightClusters.getDepthScale(),
+						mLightClusters.getDepthBias()
+					}
 				};
 
 				mSceneData.sceneBuffer->write(0, sizeof(SceneBufferData), &bufferData);
 			}
+		}
+
+		return true;
+	}
+
+	bool SceneRenderer::updateClusters()
+	{
+		mLightBounds.clear();
+
+		for (auto& lightData : mLights)
+		{
+			const auto& properties = lightData.light->getProperties();
+
+			// lights without a range reach the whole scene and can't be clustered
+			mLightBounds.push_back({
+				.position = glm::vec3(mLightsData[lightData.storageIndex].position),
+				.range = properties.range,
+				.index = lightData.storageIndex,
+				.global = lightData.light->getLightType() == LightType::Directional || properties.range <= 0.0f
+			});
+		}
+
+		const auto& swapChain = GraphicsDevice::get().getSwapChain();
+		Camera* camera = mSceneData.camera;
+
+		if (!mLightClusters.update(camera->getView(), camera->getProjection(), swapChain.getWidth(),
+			swapChain.getHeight(), mLightBounds))
+		{
+			LogError("LightClusters::update() failed!!");
+			return false;
+		}
+
+		if (mLightClusters.getIndicesBuffer() != mSceneData.lightIndicesBuffer)
+		{
+			if (!createSceneBindGroup())
+			{
+				LogError("SceneRenderer::createSceneBindGroup() failed!!");
+				return false;
+			}
+		}
+
+		return true;
+	}
 
-			for (auto& lightData : mLights)
+	bool SceneRenderer::createSceneBindGroup()
+	{
+		const std::vector<BindGroupItem> sceneItems = {
+			{
+				.binding = 0,
+				.size = sizeof(SceneBufferData),
+				.resource = BufferBindingResource(*mSceneData.sceneBuffer)
+			},
+			{
+				.binding = 1,
+				.size = mSceneData.lightsBuffer->getSize(),
+				.resource = BufferBindingResource(*mSceneData.lightsBuffer)
+			},
+			{
+				.binding = 2,
+				.size = mLightClusters.getClustersBuffer()->getSize(),
+				.resource = BufferBindingResource(*mLightClusters.getClustersBuffer())
+			},
 			{
-				updateLightData(lightData.light, lightData.storageIndex);
+				.binding = 3,
+				.size = mLightClusters.getIndicesBuffer()->getSize(),
+				.resource = BufferBindingResource(*mLightClusters.getIndicesBuffer())
 			}
+		};
+
+		auto bindGroup = std::make_unique<BindGroup>();
+		if (!bindGroup->create(*mSceneData.sceneBindGroupLayout, sceneItems))
+		{
+			LogError("BindGroup::create() failed!!");
+			return false;
 		}
 
+		// owned here rather than by the cache since it is rebuilt whenever a bound buffer grows
+		mSceneBindGroup = std::move(bindGroup);
+		mSceneData.sceneBindGroup = mSceneBindGroup.get();
+		mSceneData.lightIndicesBuffer = mLightClusters.getIndicesBuffer();
+
 		return true;
 	}
 
 	bool SceneRenderer::updateLights()
 	{
-		auto lights = mSceneData.scene->getComponents<Light>();
-		if (lights.size() > 0)
+		const auto& scene = *mSceneData.scene;
+		const uint32_t numLights = scene.hasComponent(typeid(Light)) ?
+			(uint32_t)scene.getComponents(typeid(Light)).size() : 0;
+
+		// lights are only ever appended, anything else means the list was replaced
+		if (numLights < (uint32_t)mLights.size() || (!mLights.empty() &&
+			scene.getComponents(typeid(Light))[mLights.size() - 1].get() != mLights.back().light))
 		{
-			std::vector<LightBufferData> lightsData;
-			for (auto* light : lights)
-			{
-				const auto& properties = light->getProperties();
-				auto& transform = light->getNode()->getTransform();
+			mLights.clear();
+			mLightsData.clear();
+		}
 
-				lightsData.push_back({
-					{ transform.getTranslation(), (float)light->getLightType() },
-					{ properties.color, properties.intensity },
-					{ transform.getRotation() * properties.direction, properties.range },
-					{ properties.innerConeAngle, properties.outerConeAngle }
-				});
+		for (uint32_t idx = (uint32_t)mLights.size(); idx < numLights; idx++)
+		{
+			auto* light = static_cast<Light*>(scene.getComponents(typeid(Light))[idx].get());
+			mLights.push_back({ light, idx });
+			mLightsData.push_back({});
+		}
 
-				mLights.push_back({ light, (uint32_t)lightsData.size() - 1 });
-			}
+		const uint32_t capacity = mSceneData.lightsBuffer != nullptr ?
+			mSceneData.lightsBuffer->getSize() / (uint32_t)sizeof(LightBufferData) : 0;
 
+		bool recreate{ false };
+		if (numLights > capacity || capacity == 0)
+		{
+			// the bind group always has a lights binding, so keep at least one entry around
 			auto lightsBuffer = std::make_unique<StorageBuffer>();
-			if (!lightsBuffer->create((uint32_t)lights.size() * sizeof(LightBufferData), lightsData.data()))
+			if (!lightsBuffer->create(std::max({ numLights, capacity * 2, 1u }) * sizeof(LightBufferData)))
 			{
 				LogError("StorageBuffer::create() failed for lights!!");
 				return false;
 			}
 
-			mSceneData.lightsBuffer = lightsBuffer.get();
-			mSceneData.cache->addResource(std::move(lightsBuffer));
-		}		
+			mLightsBuffer = std::move(lightsBuffer);
+			mSceneData.lightsBuffer = mLightsBuffer.get();
+			recreate = true;
+		}
+
+		// dirty lights are packed and written in contiguous runs, short clean gaps
+		// are uploaded along with them since another write costs more than the bytes
+		uint32_t firstDirty{ numLights };
+		uint32_t lastDirty{ 0 };
+		mStats.numLightWrites = 0;
+
+		for (uint32_t idx = 0; idx < numLights; idx++)
+		{
+			if (!packLightData(mLights[idx]) && !recreate)
+			{
+				continue;
+			}
+
+			if (firstDirty == numLights)
+			{
+				firstDirty = idx;
+			}
+			else if (idx - lastDirty - 1 > kMaxLightWriteGap)
+			{
+				writeLightData(firstDirty, lastDirty);
+				firstDirty = idx;
+			}
+
+			lastDirty = idx;
+		}
+
+		if (firstDirty != numLights)
+		{
+			writeLightData(firstDirty, lastDirty);
+		}
+
+		if (recreate && mSceneData.sceneBindGroupLayout != nullptr)
+		{
+			if (!createSceneBindGroup())
+			{
+				LogError("SceneRenderer::createSceneBindGroup() failed!!");
+				return false;
+			}
+		}
 
 		return true;
 	}
 
-	bool SceneRenderer::updateLightData(Light* light, uint32_t index)
+	bool SceneRenderer::packLightData(LightData& lightData)
 	{
-		const auto& properties = light->getProperties();
-		auto& transform = light->getNode()->getTransform();
+		auto* light = lightData.light;
+		const auto& transform = light->getNode()->getTransform();
+		const auto& worldMatrix = transform.getWorldMatrix();
 
-		LightBufferData bufferData = {
-			{ transform.getTranslation(), (float)light->getLightType() },
+		if (lightData.lightVersion == light->getVersion() &&
+			lightData.transformVersion == transform.getWorldVersion())
+		{
+			return false;
+		}
+
+		const auto& properties = light->getProperties();
+		mLightsData[lightData.storageIndex] = {
+			{ glm::vec3(worldMatrix[3]), (float)light->getLightType() },
 			{ properties.color, properties.intensity },
-			{ transform.getRotation() * properties.direction, properties.range },
+			{ glm::mat3(worldMatrix) * properties.direction, properties.range },
 			{ properties.innerConeAngle, properties.outerConeAngle }
 		};
 
-		mSceneData.lightsBuffer->write(sizeof(LightBufferData) * index,
-			sizeof(LightBufferData), &bufferData);
+		lightData.lightVersion = light->getVersion();
+		lightData.transformVersion = transform.getWorldVersion();
 
 		return true;
 	}
 
-	void SceneRenderer::draw(RenderPass& renderPass, RenderData& renderer)
+	void SceneRenderer::writeLightData(uint32_t first, uint32_t last)
 	{
-		if (!updateMeshData(renderer.mesh, renderer.mesh->getNode(), renderer))
+		mSceneData.lightsBuffer->write(first * sizeof(LightBufferData),
+			(last - first + 1) * sizeof(LightBufferData), &mLightsData[first]);
+
+		mStats.numLightWrites++;
+	}
+
+	void SceneRenderer::draw(RenderPass& renderPass, const DrawBatch& batch)
+	{
+		const auto& renderer = mRenderers[getRendererIndex(mSortKeys[batch.firstKey])];
+		setDrawState(renderPass, renderer, renderer.meshBindGroup, batch.transformOffset);
+		drawSubMesh(renderPass, renderer, batch.numInstances);
+	}
+
+	void SceneRenderer::draw(RenderPass& renderPass, const IndirectDraw& indirectDraw, uint32_t drawIndex)
+	{
+		const auto& renderer = mRenderers[mIndirectRenderers[indirectDraw.firstRenderer]];
+		setDrawState(renderPass, renderer, mSceneData.indirectBindGroup, indirectDraw.transformOffset);
+
+		renderPass.drawIndexedIndirect(*mCullingPass.getArgsBuffer(), drawIndex * sizeof(DrawIndexedIndirectArgs));
+	}
+
+	void SceneRenderer::drawDepth(RenderPass& renderPass, const DrawBatch& batch)
+	{
+		const auto& renderer = mRenderers[getRendererIndex(mSortKeys[batch.firstKey])];
+
+		if (mDrawState.pipeline != renderer.depthPipeline)
+		{
+			renderPass.setPipeline(*renderer.depthPipeline);
+			mDrawState.pipeline = renderer.depthPipeline;
+			mStats.numPipelineChanges++;
+		}
+
+		if (mDrawState.meshBindGroup != renderer.meshBindGroup || mDrawState.transformOffset != batch.transformOffset)
+		{
+			renderPass.setBindGroup(kDepthTransformBindGroupIndex, *renderer.meshBindGroup, 1, &batch.transformOffset);
+			mDrawState.meshBindGroup = renderer.meshBindGroup;
+			mDrawState.transformOffset = batch.transformOffset;
+			mStats.numBindGroupChanges++;
+		}
+
+		const auto* vertexBuffer = renderer.subMesh->getVertexBuffer();
+		if (mDrawState.vertexBuffer != vertexBuffer)
+		{
+			renderPass.setVertexBuffer(0, *vertexBuffer);
+			mDrawState.vertexBuffer = vertexBuffer;
+		}
+
+		if (renderer.subMesh->hasIndexBuffer())
+		{
+			const auto* indexBuffer = getIndexBuffer(renderer);
+			if (mDrawState.indexBuffer != indexBuffer)
+			{
+				renderPass.setIndexBuffer(*indexBuffer);
+				mDrawState.indexBuffer = indexBuffer;
+			}
+		}
+
+		drawSubMesh(renderPass, renderer, batch.numInstances);
+		mStats.numPrepassDraws++;
+	}
+
+	void SceneRenderer::drawSubMesh(RenderPass& renderPass, const RenderData& renderer, uint32_t numInstances)
+	{
+		const auto* subMesh = renderer.subMesh;
+		if (!subMesh->hasIndexBuffer())
+		{
+			renderPass.draw(subMesh->getNumVertices(), numInstances, 0, 0);
+			return;
+		}
+
+		// the full detail lod draws the meshlets that survived culling, they never share a batch
+		if (isMeshletDraw(renderer))
 		{
-			LogError("updateTransformData() failed!!");
+			renderPass.drawIndexedIndirect(*mMeshletCullingPass.getArgsBuffer(),
+				renderer.meshletGroup * sizeof(DrawIndexedIndirectArgs));
 			return;
 		}
 
-		renderPass.setPipeline(*renderer.pipeline);
-		renderPass.setBindGroup(kMaterialBindGroupIndex, *renderer.materialBindGroup);
-		renderPass.setBindGroup(kTransformBindGroupIndex, *renderer.meshBindGroup);
-		renderPass.setVertexBuffer(0, *renderer.subMesh->getVertexBuffer());
+		const auto& lods = subMesh->getLods();
+		if (renderer.lod < (uint32_t)lods.size())
+		{
+			const auto& lod = lods[renderer.lod];
+			renderPass.drawIndexed(lod.numIndices, numInstances, lod.firstIndex, 0, 0);
+		}
+		else
+		{
+			renderPass.drawIndexed(subMesh->getNumIndices(), numInstances, subMesh->getIndexOffset(), 0, 0);
+		}
+	}
+
+	void SceneRenderer::setDrawState(RenderPass& renderPass, const RenderData& renderer, const BindGroup* meshBindGroup,
+		uint32_t transformOffset)
+	{
+		if (mDrawState.pipeline != renderer.pipeline)
+		{
+			renderPass.setPipeline(*renderer.pipeline);
+			mDrawState.pipeline = renderer.pipeline;
+			mStats.numPipelineChanges++;
+		}
+
+		if (mDrawState.materialBindGroup != renderer.materialBindGroup)
+		{
+			renderPass.setBindGroup(kMaterialBindGroupIndex, *renderer.materialBindGroup);
+			mDrawState.materialBindGroup = renderer.materialBindGroup;
+			mStats.numBindGroupChanges++;
+		}
+
+		if (mDrawState.meshBindGroup != meshBindGroup || mDrawState.transformOffset != transformOffset)
+		{
+			renderPass.setBindGroup(kTransformBindGroupIndex, *meshBindGroup, 1, &transformOffset);
+			mDrawState.meshBindGroup = meshBindGroup;
+			mDrawState.transformOffset = transformOffset;
+			mStats.numBindGroupChanges++;
+		}
+
+		const auto* vertexBuffer = renderer.subMesh->getVertexBuffer();
+		if (mDrawState.vertexBuffer != vertexBuffer)
+		{
+			renderPass.setVertexBuffer(0, *vertexBuffer);
+			mDrawState.vertexBuffer = vertexBuffer;
+		}
 
 		if (renderer.subMesh->hasIndexBuffer())
 		{
-			renderPass.setIndexBuffer(*renderer.subMesh->getIndexBuffer());
-			renderPass.drawIndexed(renderer.subMesh->getNumIndices(), 1, 0, 0, 0);
+			const auto* indexBuffer = getIndexBuffer(renderer);
+			if (mDrawState.indexBuffer != indexBuffer)
+			{
+				renderPass.setIndexBuffer(*indexBuffer);
+				mDrawState.indexBuffer = indexBuffer;
+			}
+		}
+	}
+
+	bool SceneRenderer::isMeshletDraw(const RenderData& renderer) const
+	{
+		return renderer.meshletGroup != (uint32_t)-1 && renderer.lod == 0;
+	}
+
+	const IndexBuffer* SceneRenderer::getIndexBuffer(const RenderData& renderer) const
+	{
+		// culled meshlets are compacted into the pass' own indices, which replace the mesh's
+		return isMeshletDraw(renderer) ? mMeshletCullingPass.getIndexBuffer() : renderer.subMesh->getIndexBuffer();
+	}
+
+	void SceneRenderer::updateWorldBounds(RenderData& renderData)
+	{
+		const auto& transform = renderData.mesh->getNode()->getTransform();
+		const auto& worldMatrix = transform.getWorldMatrix();
+
+		if (renderData.worldVersion == transform.getWorldVersion())
+		{
+			return;
+		}
+
+		renderData.worldBounds = renderData.subMesh->getBounds().getTransformed(worldMatrix);
+		renderData.worldVersion = transform.getWorldVersion();
+
+		// skinned meshes stay out of the tree, their bind pose bounds don't follow the animation
+		if (renderData.mesh->isAnimated())
+		{
+			return;
+		}
+
+		if (renderData.proxyId == BoundingVolumeHierarchy::kNullNode)
+		{
+			renderData.proxyId = mBoundsTree.createProxy(renderData.worldBounds,
+				(uint32_t)(&renderData - mRenderers.data()));
 		}
 		else
 		{
-			renderPass.draw(renderer.subMesh->getNumVertices(), 1, 0, 0);
+			mBoundsTree.moveProxy(renderData.proxyId, renderData.worldBounds);
 		}
 	}
 
-	void SceneRenderer::getSortedRenderers(std::multimap<float, RenderData*>& opaqueRenderers, 
-		std::multimap<float, RenderData*>& transparentRenderers)
+	void SceneRenderer::updateBounds()
 	{
-		auto cameraTransform = mSceneData.camera->getNode()->getTransform().getWorldMatrix();
-		for (auto& renderData : mRenderers)
+		auto& hierarchy = mSceneData.scene->getTransformHierarchy();
+
+		// only renderers whose node moved since the last frame touch the tree
+		if (hierarchy.hasChangesOverflowed())
 		{
-			const auto& bounds = renderData.mesh->getBounds();
-			auto* node = renderData.mesh->getNode();
-			auto transform = node->getTransform().getWorldMatrix();
+			for (auto& renderData : mRenderers)
+			{
+				updateWorldBounds(renderData);
+			}
+		}
+		else
+		{
+			for (const auto* transform : hierarchy.getChangedTransforms())
+			{
+				auto it = mTransformRenderers.find(transform);
+				if (it == mTransformRenderers.end())
+				{
+					continue;
+				}
+
+				for (uint32_t idx = 0; idx < it->second.second; idx++)
+				{
+					updateWorldBounds(mRenderers[it->second.first + idx]);
+				}
+			}
+		}
+
+		hierarchy.clearChanges();
+	}
+
+	void SceneRenderer::cullRenderers()
+	{
+		auto* camera = mSceneData.camera;
+		Frustum frustum(camera->getProjection() * camera->getView());
+
+		mVisibleRenderers.clear();
+
+		if (!mCullingEnabled)
+		{
+			for (uint32_t idx = 0; idx < (uint32_t)mRenderers.size(); idx++)
+			{
+				if (!mRenderers[idx].gpuCulled)
+				{
+					mVisibleRenderers.push_back(idx);
+				}
+			}
+		}
+		else
+		{
+			mVisibleRenderers.insert(mVisibleRenderers.end(), mUntrackedRenderers.begin(), mUntrackedRenderers.end());
+
+			// the tree works on fattened bounds, so its candidates are re-tested in one batch
+			mCandidateRenderers.clear();
+			mBoundsTree.query(frustum, [&](uint32_t idx) {
+				if (!mRenderers[idx].gpuCulled)
+				{
+					mCandidateRenderers.push_back(idx);
+				}
+			});
+
+			mCandidateBounds.resize((uint32_t)mCandidateRenderers.size());
+			for (uint32_t idx = 0; idx < (uint32_t)mCandidateRenderers.size(); idx++)
+			{
+				mCandidateBounds.set(idx, mRenderers[mCandidateRenderers[idx]].worldBounds);
+			}
+
+			mCandidateBounds.cull(frustum, mCandidateVisibility);
+
+			for (uint32_t idx = 0; idx < (uint32_t)mCandidateRenderers.size(); idx++)
+			{
+				if (BoundingBoxBatch::isVisible(mCandidateVisibility, idx))
+				{
+					mVisibleRenderers.push_back(mCandidateRenderers[idx]);
+				}
+			}
+		}
+
+		mStats.numVisible = (uint32_t)mVisibleRenderers.size();
+		mStats.numCulled = (uint32_t)(mRenderers.size() - mIndirectRenderers.size()) - mStats.numVisible;
+	}
+
+	void SceneRenderer::selectLods()
+	{
+		auto* camera = mSceneData.camera;
+		const auto& projection = camera->getProjection();
+		const glm::vec3 cameraPosition = glm::vec3(camera->getNode()->getTransform().getWorldMatrix()[3]);
+		const bool perspective = projection[2][3] != 0.0f;
+
+		// pixels covered by one world unit at a distance of one
+		const float pixelScale = 0.5f * projection[1][1] * (float)GraphicsDevice::get().getSwapChain().getHeight();
+
+		for (auto idx : mVisibleRenderers)
+		{
+			auto& renderData = mRenderers[idx];
+			const auto& lods = renderData.subMesh->getLods();
+			renderData.lod = 0;
+
+			if (lods.size() < 2 || mLodThreshold <= 0.0f)
+			{
+				continue;
+			}
+
+			// the closest point of the bounds gives the largest error on screen
+			const glm::vec3 closest = glm::clamp(cameraPosition, renderData.worldBounds.min, renderData.worldBounds.max);
+			const float distance = perspective ? glm::length(closest - cameraPosition) : 1.0f;
+
+			if (distance <= 0.0f)
+			{
+				continue;
+			}
+
+			const auto& worldMatrix = renderData.mesh->getNode()->getTransform().getWorldMatrix();
+			const float worldScale = std::max({ glm::length(glm::vec3(worldMatrix[0])),
+				glm::length(glm::vec3(worldMatrix[1])), glm::length(glm::vec3(worldMatrix[2])) });
+
+			const float errorScale = worldScale * pixelScale / distance;
+			for (uint32_t lod = (uint32_t)lods.size() - 1; lod > 0; lod--)
+			{
+				if (lods[lod].error * errorScale <= mLodThreshold)
+				{
+					renderData.lod = lod;
+					break;
+				}
+			}
+		}
+	}
+
+	void SceneRenderer::sortRenderers(uint32_t pass)
+	{
+		auto* camera = mSceneData.camera;
+		const glm::vec3 cameraPosition = glm::vec3(camera->getNode()->getTransform().getWorldMatrix()[3]);
+
+		mSortKeys.clear();
+		mSortKeys.reserve(mVisibleRenderers.size());
+
+		for (auto idx : mVisibleRenderers)
+		{
+			const auto& renderData = mRenderers[idx];
+			const float distance = glm::length(cameraPosition - renderData.worldBounds.getCenter());
+
+			mSortKeys.push_back(getSortKey(pass, renderData, distance, idx));
+		}
+
+		SortHelper::radixSort(mSortKeys, mSortScratch);
+	}
+
+	bool SceneRenderer::buildBatches()
+	{
+		mDrawBatches.clear();
+
+		// instancing candidates are adjacent after sorting, so batches are runs of sort keys
+		for (uint32_t idx = 0; idx < (uint32_t)mSortKeys.size(); idx++)
+		{
+			auto& renderData = mRenderers[getRendererIndex(mSortKeys[idx])];
+			if (!updateMeshData(renderData.mesh, renderData.mesh->getNode(), renderData))
+			{
+				LogError("updateMeshData() failed!!");
+				return false;
+			}
+
+			if (!mDrawBatches.empty())
+			{
+				auto& batch = mDrawBatches.back();
+				const auto& first = mRenderers[getRendererIndex(mSortKeys[batch.firstKey])];
+
+				if (batch.numInstances < kMaxInstancesPerDraw && canInstance(first, renderData))
+				{
+					batch.numInstances++;
+					continue;
+				}
+			}
+
+			mDrawBatches.push_back({
+				.firstKey = idx,
+				.numInstances = 1
+			});
+		}
+
+		// transforms of all batches go into this frame's region with one upload
+		mTransformAllocator.begin();
 
-			BoundingBox worldBounds{ bounds.min, bounds.max };
-			worldBounds.transform(transform);
+		for (auto& batch : mDrawBatches)
+		{
+			auto* transforms = (TransformBufferData*)mTransformAllocator.allocate(
+				batch.numInstances * sizeof(TransformBufferData), batch.transformOffset);
 
-			float distance = glm::length(glm::vec3(cameraTransform[3]) - worldBounds.getCenter());
-			if (renderData.subMesh->getMaterial()->getAlphaMode() == AlphaMode::Blend)
+			if (transforms == nullptr)
 			{
-				transparentRenderers.emplace(distance, &renderData);
+				LogError("UniformAllocator::allocate() failed!!");
+				return false;
 			}
-			else
+
+			for (uint32_t idx = 0; idx < batch.numInstances; idx++)
 			{
-				opaqueRenderers.emplace(distance, &renderData);
+				transforms[idx] = mRenderers[getRendererIndex(mSortKeys[batch.firstKey + idx])].transformData;
 			}
 		}
+
+		mTransformAllocator.upload();
+		return true;
+	}
+
+	bool SceneRenderer::canInstance(const RenderData& first, const RenderData& renderData)
+	{
+		// skinned meshes have their own bind group, so comparing those keeps them out of batches
+		return first.pipeline == renderData.pipeline &&
+			first.materialBindGroup == renderData.materialBindGroup &&
+			first.meshBindGroup == renderData.meshBindGroup &&
+			first.subMesh->getVertexBuffer() == renderData.subMesh->getVertexBuffer() &&
+			first.subMesh->getIndexBuffer() == renderData.subMesh->getIndexBuffer() &&
+			first.subMesh->getNumVertices() == renderData.subMesh->getNumVertices() &&
+			first.subMesh->getNumIndices() == renderData.subMesh->getNumIndices() &&
+			first.lod == renderData.lod &&
+			first.meshletGroup == renderData.meshletGroup;
+	}
+
+	uint64_t SceneRenderer::getSortKey(uint32_t pass, const RenderData& renderData, float distance, uint32_t index)
+	{
+		// the bits of a positive float below the sign order the same way as the float itself,
+		// which gives depth buckets that are finer close to the camera
+		uint32_t distanceBits{ 0 };
+		const float clampedDistance = std::max(distance, 0.0f);
+		std::memcpy(&distanceBits, &clampedDistance, sizeof(float));
+
+		const uint64_t pipeline = renderData.pipelineId & ((1u << kSortPipelineBits) - 1);
+		const uint64_t material = renderData.materialId & ((1u << kSortMaterialBits) - 1);
+
+		uint64_t key = pass & ((1u << kSortPassBits) - 1);
+		key = (key << 1) | (renderData.transparent ? 1 : 0);
+
+		if (renderData.transparent)
+		{
+			// back to front for blending, state changes come second
+			const uint64_t depth = distanceBits >> (31 - kSortDepthBits);
+
+			key = (key << kSortDepthBits) | (~depth & ((1u << kSortDepthBits) - 1));
+			key = (key << kSortPipelineBits) | pipeline;
+			key = (key << kSortMaterialBits) | material;
+		}
+		else
+		{
+			// grouped by state and geometry first so instances end up adjacent,
+			// then roughly front to back within a group for early depth rejection
+			const uint64_t geometry = renderData.geometryId & ((1u << kSortGeometryBits) - 1);
+			const uint64_t depth = distanceBits >> (31 - kSortCoarseDepthBits);
+
+			key = (key << kSortPipelineBits) | pipeline;
+			key = (key << kSortMaterialBits) | material;
+			key = (key << kSortGeometryBits) | geometry;
+			key = (key << kSortCoarseDepthBits) | depth;
+		}
+
+		return (key << kSortIndexBits) | index;
 	}
 }
\ No newline at end of file
@@ -19,6 +19,11 @@ namespace Trinity
 	void Skybox::destroy()
 	{
 		Resource::destroy();
+
+		releaseResourceRef(mMaterial);
+		releaseResourceRef(mVertexLayout);
+		releaseResourceRef(mVertexBuffer);
+		releaseResourceRef(mIndexBuffer);
 	}
 
 	bool Skybox::write()
@@ -52,7 +57,7 @@ namespace Trinity
 
 	void Skybox::setMaterial(Material& material)
 	{
-		mMaterial = &material;
+		setResourceRef(mMaterial, &material);
 	}
 
 	void Skybox::setSize(float size)
@@ -126,9 +131,9 @@ namespace Trinity
 			return false;
 		}
 
-		mVertexLayout = vertexLayout.get();
-		mVertexBuffer = vertexBuffer.get();
-		mIndexBuffer = indexBuffer.get();
+		setResourceRef(mVertexLayout, vertexLayout.get());
+		setResourceRef(mVertexBuffer, vertexBuffer.get());
+		setResourceRef(mIndexBuffer, indexBuffer.get());
 
 		cache.addResource(std::move(vertexLayout));
 		cache.addResource(std::move(vertexBuffer));
@@ -7,32 +7,41 @@
 #include "Core/Logger.h"
 #include "Core/Debugger.h"
 #include "Core/Image.h"
+#include "Core/ContentManifest.h"
 #include "Core/ResourceCache.h"
 #include "VFS/FileSystem.h"
+#include "Utils/HashHelper.h"
 
 namespace Trinity
 {
-	static std::unique_ptr<Image> createImage(const std::string& imagePath, ResourceCache& cache,
-		const std::string& imagesPath, bool loadContent = true)
+	static Image* createImage(const std::string& imagePath, ResourceCache& cache, ContentManifest& manifest,
+		const std::string& imagesPath)
 	{
-		fs::path fileName(imagesPath);
-		fileName.append(fs::path(imagePath).filename().string());
-		fileName.replace_extension("png");
-
 		auto image = std::make_unique<Image>();
-		if (!image->create(FileSystem::get().sanitizePath(fileName.string()), cache, loadContent))
+		if (!image->load(imagePath))
 		{
-			LogError("Image::create() failed for: '%s'", fileName.string().c_str());
+			LogError("Image::load() failed for: '%s'", imagePath.c_str());
 			return nullptr;
 		}
 
-		if (!image->load(imagePath))
+		const auto imageFileName = Image::getContentFileName(*image, imagesPath, cache);
+		manifest.setEntry("Images/" + fs::path(imagePath).filename().string(), image->getContentHash(), imageFileName);
+
+		if (cache.isLoaded<Image>(imageFileName))
 		{
-			LogError("Image::load() failed for: '%s'", imagePath.c_str());
+			return cache.getResource<Image>(imageFileName);
+		}
+
+		if (!image->create(imageFileName, cache, false))
+		{
+			LogError("Image::create() failed for: '%s'", imageFileName.c_str());
 			return nullptr;
 		}
 
-		return image;
+		auto* result = image.get();
+		cache.addResource(std::move(image));
+
+		return result;
 	}
 
 	static std::unique_ptr<Sampler> createSampler(ResourceCache& cache, const std::string& samplersPath, bool loadContent = true)
@@ -57,22 +66,44 @@ namespace Trinity
 		return sampler;
 	}
 
-	static std::unique_ptr<Texture> createTexture(std::vector<Image*>&& images, ResourceCache& cache,
-		const std::string& texturesPath, bool loadContent = true)
+	static Texture* createTexture(const std::string& imagePath, std::vector<Image*>&& images, ResourceCache& cache,
+		ContentManifest& manifest, const std::string& texturesPath, bool loadContent = true)
 	{
+		// the image files are already unique per content, the texture is named after them
+		uint64_t hash = HashHelper::combine(HashHelper::kSeed, (uint64_t)TextureType::Cube);
+		std::string textureName = "cube";
+
+		for (auto* image : images)
+		{
+			hash = HashHelper::combine(hash, image->getContentHash());
+			textureName += "_" + fs::path(image->getFileName()).stem().string();
+		}
+
 		auto fileName = fs::path(texturesPath);
-		fileName.append(fs::path(images[0]->getFileName()).filename().string());
+		fileName.append(textureName);
 		fileName.replace_extension("ttex");
 
+		const auto textureFileName = FileSystem::get().sanitizePath(fileName.string());
+		manifest.setEntry("Textures/" + fs::path(imagePath).filename().string(), hash, textureFileName);
+
+		if (cache.isLoaded<Texture>(textureFileName))
+		{
+			return cache.getResource<Texture>(textureFileName);
+		}
+
 		auto texture = std::make_unique<TextureCube>();
-		if (!texture->create(FileSystem::get().sanitizePath(fileName.string()), cache, loadContent))
+		if (!texture->create(textureFileName, cache, loadContent))
 		{
-			LogError("Sampler::create() failed!!");
+			LogError("TextureCube::create() failed for: '%s'", textureFileName.c_str());
 			return nullptr;
 		}
 
 		texture->setImages(std::move(images));
-		return texture;
+
+		auto* result = texture.get();
+		cache.addResource(std::move(texture));
+
+		return result;
 	}
 
 	std::unique_ptr<Shader> createShader(ResourceCache& cache, const std::vector<std::string>& defines, bool loadContent = true)
@@ -116,37 +147,32 @@ namespace Trinity
 			return nullptr;
 		}
 
+		auto manifestPath = fs::path(imagesPath).parent_path();
+		manifestPath.append(ContentManifest::kFileName);
+
+		auto* manifest = ContentManifest::getOrCreate(FileSystem::get().sanitizePath(manifestPath.string()), cache);
+		if (!manifest)
+		{
+			LogError("ContentManifest::getOrCreate() failed for: '%s'", manifestPath.string().c_str());
+			return nullptr;
+		}
+
 		std::vector<Image*> images;
-		if (envMapFileNames.size() == 1)
+		for (auto& envMapFileName : envMapFileNames)
 		{
-			auto envMapImage = createImage(envMapFileNames[0], cache, imagesPath, loadContent);
+			auto* envMapImage = createImage(envMapFileName, cache, *manifest, imagesPath);
 			if (!envMapImage)
 			{
-				LogError("createImage() failed for: '%s'", envMapFileNames[0].c_str());
+				LogError("createImage() failed for: '%s'", envMapFileName.c_str());
 				return nullptr;
 			}
 
-			images.push_back(envMapImage.get());
-			cache.addResource(std::move(envMapImage));
-		}
-		else
-		{
-			std::vector<Image*> images;
-			for (auto& envMapFileName : envMapFileNames)
-			{
-				auto envMapImage = createImage(envMapFileName, cache, imagesPath, loadContent);
-				if (!envMapImage)
-				{
-					LogError("createImage() failed for: '%s'", envMapFileName.c_str());
-					return nullptr;
-				}
-
-				images.push_back(envMapImage.get());
-				cache.addResource(std::move(envMapImage));
-			}
+			images.push_back(envMapImage);
 		}
 		
-		auto envMapTexture = createTexture(std::move(images), cache, texturesPath, loadContent);
+		auto* envMapTexture = createTexture(envMapFileNames[0], std::move(images), cache, *manifest,
+			texturesPath, loadContent);
+
 		if (!envMapTexture)
 		{
 			LogError("createTexture() failed for: '%s'", envMapFileNames[0].c_str());
@@ -180,7 +206,6 @@ namespace Trinity
 		material->setShaderDefines(std::move(shaderDefines));
 		material->setShader(*shader);
 
-		cache.addResource(std::move(envMapTexture));
 		cache.addResource(std::move(defaultSampler));
 		cache.addResource(std::move(shader));
 
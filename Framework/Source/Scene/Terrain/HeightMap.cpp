@@ -23,6 +23,11 @@ namespace Trinity
 		return Resource::write();
 	}
 
+	bool HeightMap::canReadAsync() const
+	{
+		return true;
+	}
+
 	bool HeightMap::load(const std::string& fileName)
 	{
 		auto file = FileSystem::get().openFile(fileName, FileOpenMode::OpenRead);
@@ -119,6 +124,11 @@ namespace Trinity
 		return typeid(HeightMap);
 	}
 
+	uint64_t HeightMap::getCpuMemorySize() const
+	{
+		return mData.size() * sizeof(uint16_t);
+	}
+
 	bool HeightMap::read(FileReader& reader, ResourceCache& cache)
 	{
 		if (!Resource::read(reader, cache))
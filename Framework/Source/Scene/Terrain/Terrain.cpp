@@ -19,6 +19,9 @@ namespace Trinity
 	void Terrain::destroy()
 	{
 		Resource::destroy();
+
+		releaseResourceRef(mHeightMap);
+		releaseResourceRef(mMaterial);
 	}
 
 	bool Terrain::write()
@@ -38,12 +41,12 @@ namespace Trinity
 
 	void Terrain::setHeightMap(HeightMap& heightMap)
 	{
-		mHeightMap = &heightMap;
+		setResourceRef(mHeightMap, &heightMap);
 	}
 
 	void Terrain::setMaterial(Material& material)
 	{
-		mMaterial = &material;
+		setResourceRef(mMaterial, &material);
 	}
 
 	void Terrain::setNumLODs(uint32_t numLODs)
@@ -135,8 +138,8 @@ namespace Trinity
 			cache.addResource(std::move(material));
 		}
 
-		mHeightMap = cache.getResource<HeightMap>(heightMapFileName);
-		mMaterial = cache.getResource<Material>(materialFileName);
+		setResourceRef(mHeightMap, cache.getResource<HeightMap>(heightMapFileName));
+		setResourceRef(mMaterial, cache.getResource<Material>(materialFileName));
 
 		return true;
 	}
@@ -9,33 +9,42 @@
 #include "Core/Logger.h"
 #include "Core/Debugger.h"
 #include "Core/Image.h"
+#include "Core/ContentManifest.h"
 #include "Core/ResourceCache.h"
 #include "VFS/FileSystem.h"
+#include "Utils/HashHelper.h"
 #include <format>
 
 namespace Trinity
 {
-	static std::unique_ptr<Image> createImage(const std::string& imagePath, ResourceCache& cache, 
-		const std::string& imagesPath, bool loadContent = true)
+	static Image* createImage(const std::string& imagePath, ResourceCache& cache, ContentManifest& manifest,
+		const std::string& imagesPath)
 	{
-		fs::path fileName(imagesPath);
-		fileName.append(fs::path(imagePath).filename().string());
-		fileName.replace_extension("png");
-
 		auto image = std::make_unique<Image>();
-		if (!image->create(FileSystem::get().sanitizePath(fileName.string()), cache, loadContent))
+		if (!image->load(imagePath))
 		{
-			LogError("Image::create() failed for: '%s'", fileName.string().c_str());
+			LogError("Image::load() failed for: '%s'", imagePath.c_str());
 			return nullptr;
 		}
 
-		if (!image->load(imagePath))
+		const auto imageFileName = Image::getContentFileName(*image, imagesPath, cache);
+		manifest.setEntry("Images/" + fs::path(imagePath).filename().string(), image->getContentHash(), imageFileName);
+
+		if (cache.isLoaded<Image>(imageFileName))
 		{
-			LogError("Image::load() failed for: '%s'", imagePath.c_str());
+			return cache.getResource<Image>(imageFileName);
+		}
+
+		if (!image->create(imageFileName, cache, false))
+		{
+			LogError("Image::create() failed for: '%s'", imageFileName.c_str());
 			return nullptr;
 		}
 
-		return image;
+		auto* result = image.get();
+		cache.addResource(std::move(image));
+
+		return result;
 	}
 
 	static std::unique_ptr<HeightMap> createHeightMap(const std::string& heightMapPath, ResourceCache& cache,
@@ -99,24 +108,39 @@ namespace Trinity
 		return sampler;
 	}
 
-	static std::unique_ptr<Texture> createTexture(Image& image, bool hasMipmaps, ResourceCache& cache, 
-		const std::string& texturesPath, bool loadContent = true)
+	static Texture* createTexture(const std::string& imagePath, Image& image, bool hasMipmaps, ResourceCache& cache,
+		ContentManifest& manifest, const std::string& texturesPath, bool loadContent = true)
 	{
+		// the image file is already unique per content, the texture is named after it
 		auto fileName = fs::path(texturesPath);
-		fileName.append(fs::path(image.getFileName()).filename().string());
+		fileName.append(fs::path(image.getFileName()).stem().string() + (hasMipmaps ? "_mips" : ""));
 		fileName.replace_extension("ttex");
 
+		const auto textureFileName = FileSystem::get().sanitizePath(fileName.string());
+
+		uint64_t hash = HashHelper::combine(image.getContentHash(), (uint64_t)TextureType::TwoD);
+		hash = HashHelper::combine(hash, hasMipmaps ? 1 : 0);
+		manifest.setEntry("Textures/" + fs::path(imagePath).filename().string(), hash, textureFileName);
+
+		if (cache.isLoaded<Texture>(textureFileName))
+		{
+			return cache.getResource<Texture>(textureFileName);
+		}
+
 		auto texture = std::make_unique<Texture2D>();
-		if (!texture->create(FileSystem::get().sanitizePath(fileName.string()), cache, loadContent))
+		if (!texture->create(textureFileName, cache, loadContent))
 		{
-			LogError("Sampler::create() failed!!");
+			LogError("Texture2D::create() failed for: '%s'", textureFileName.c_str());
 			return nullptr;
 		}
 
 		texture->setImage(&image);
 		texture->setHasMipmaps(hasMipmaps);
 
-		return texture;
+		auto* result = texture.get();
+		cache.addResource(std::move(texture));
+
+		return result;
 	}
 
 	static std::unique_ptr<Shader> createShader(ResourceCache& cache, const std::vector<std::string>& defines, bool loadContent = true)
@@ -161,44 +185,50 @@ namespace Trinity
 			return nullptr;
 		}
 
-		auto blendMapImage = createImage(blendMapFileName, cache, imagesPath, loadContent);
-		if (!blendMapImage)
+		auto manifestPath = fs::path(imagesPath).parent_path();
+		manifestPath.append(ContentManifest::kFileName);
+
+		auto* manifest = ContentManifest::getOrCreate(FileSystem::get().sanitizePath(manifestPath.string()), cache);
+		if (!manifest)
 		{
-			LogError("createImage() failed for: '%s'", blendMapFileName.c_str());
+			LogError("ContentManifest::getOrCreate() failed for: '%s'", manifestPath.string().c_str());
 			return nullptr;
 		}
 
-		std::vector<std::unique_ptr<Image>> layerImages;
-		for (auto& layerFileName : layerFileNames)
+		auto* blendMapImage = createImage(blendMapFileName, cache, *manifest, imagesPath);
+		if (!blendMapImage)
 		{
-			auto image = createImage(layerFileName, cache, imagesPath, loadContent);
-			if (!image)
-			{
-				LogError("createImage() failed for: '%s'", layerFileName.c_str());
-				return nullptr;
-			}
-
-			layerImages.push_back(std::move(image));
+			LogError("createImage() failed for: '%s'", blendMapFileName.c_str());
+			return nullptr;
 		}
 
-		auto blendMapTexture = createTexture(*blendMapImage, false, cache, texturesPath, loadContent);
+		auto* blendMapTexture = createTexture(blendMapFileName, *blendMapImage, false, cache, 
+			*manifest, texturesPath, loadContent);
+
 		if (!blendMapTexture)
 		{
 			LogError("createTexture() failed for: '%s'", blendMapFileName.c_str());
 			return nullptr;
 		}
 
-		std::vector<std::unique_ptr<Texture>> layerTextures;
-		for (auto& image : layerImages)
+		std::vector<Texture*> layerTextures;
+		for (auto& layerFileName : layerFileNames)
 		{
-			auto texture = createTexture(*image, true, cache, texturesPath, loadContent);
+			auto* image = createImage(layerFileName, cache, *manifest, imagesPath);
+			if (!image)
+			{
+				LogError("createImage() failed for: '%s'", layerFileName.c_str());
+				return nullptr;
+			}
+
+			auto* texture = createTexture(layerFileName, *image, true, cache, *manifest, texturesPath, loadContent);
 			if (!texture)
 			{
-				LogError("createTexture() failed for: '%s'", image->getFileName().c_str());
+				LogError("createTexture() failed for: '%s'", layerFileName.c_str());
 				return nullptr;
 			}
 
-			layerTextures.push_back(std::move(texture));
+			layerTextures.push_back(texture);
 		}
 
 		auto fileName = fs::path(materialsPath);
@@ -237,15 +267,6 @@ namespace Trinity
 		material->setShaderDefines(std::move(shaderDefines));
 		material->setShader(*shader);
 
-		cache.addResource(std::move(blendMapImage));
-		cache.addResource(std::move(blendMapTexture));
-
-		for (uint32_t idx = 0; idx < numLayerTextures; idx++)
-		{
-			cache.addResource(std::move(layerImages[idx]));
-			cache.addResource(std::move(layerTextures[idx]));
-		}
-
 		cache.addResource(std::move(defaultSampler));
 		cache.addResource(std::move(shader));
 
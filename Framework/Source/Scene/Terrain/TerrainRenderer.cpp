@@ -8,6 +8,7 @@
 #include "Scene/Components/Light.h"
 #include "Scene/Scene.h"
 #include "Graphics/RenderPipeline.h"
+#include "Graphics/PipelineCache.h"
 #include "Graphics/Material.h"
 #include "Graphics/BindGroup.h"
 #include "Graphics/BindGroupLayout.h"
@@ -168,16 +169,15 @@ namespace Trinity
 			};
 		}
 
-		auto pipeline = std::make_unique<RenderPipeline>();
-		if (!pipeline->create(renderProps))
+		auto* pipeline = PipelineCache::get().getRenderPipeline(renderProps);
+		if (!pipeline)
 		{
-			LogError("RenderPipeline::create() failed!!");
+			LogError("PipelineCache::getRenderPipeline() failed!!");
 			return false;
 		}
 
-		mSceneData.pipeline = pipeline.get();
+		mSceneData.pipeline = pipeline;
 		mSceneData.materialBindGroup = material->getBindGroup();
-		mSceneData.cache->addResource(std::move(pipeline));
 
 		return true;
 	}
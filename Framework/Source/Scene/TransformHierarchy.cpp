@@ -0,0 +1,270 @@
+#include "Scene/TransformHierarchy.h"
+#include "Scene/Node.h"
+#include "Scene/Components/Transform.h"
+#include <algorithm>
+#include <thread>
+
+namespace Trinity
+{
+	void TransformHierarchy::build(Node& root)
+	{
+		destroy();
+
+		std::vector<std::pair<Node*, uint32_t>> traverseNodes;
+		traverseNodes.push_back(std::make_pair(&root, kInvalidIndex));
+
+		while (!traverseNodes.empty())
+		{
+			auto [node, parent] = traverseNodes.back();
+			traverseNodes.pop_back();
+
+			const uint32_t index = (uint32_t)mTransforms.size();
+			auto& transform = node->getTransform();
+
+			mTransforms.push_back(&transform);
+			mParents.push_back(parent);
+			mLocalMatrices.push_back(transform.getMatrix());
+			mWorldMatrices.push_back(glm::mat4(1.0f));
+			mDirtyFlags.push_back(kLocalDirty);
+
+			transform.setHierarchy(this, index);
+
+			const auto& children = node->getChildren();
+			for (auto it = children.rbegin(); it != children.rend(); ++it)
+			{
+				traverseNodes.push_back(std::make_pair(*it, index));
+			}
+		}
+
+		buildSubtrees();
+
+		mDirty = true;
+		mNeedsRebuild = false;
+	}
+
+	void TransformHierarchy::destroy()
+	{
+		for (auto* transform : mTransforms)
+		{
+			transform->setHierarchy(nullptr, kInvalidIndex);
+		}
+
+		mTransforms.clear();
+		mParents.clear();
+		mLocalMatrices.clear();
+		mWorldMatrices.clear();
+		mDirtyFlags.clear();
+		mSubtreeRoots.clear();
+		mSubtrees.clear();
+		mChunks.clear();
+		mChunkChanges.clear();
+		mChangedTransforms.clear();
+		mChangesOverflowed = true;
+
+		mDirty = false;
+		mNeedsRebuild = true;
+	}
+
+	void TransformHierarchy::invalidate()
+	{
+		if (!mNeedsRebuild)
+		{
+			destroy();
+		}
+	}
+
+	void TransformHierarchy::markDirty(uint32_t index)
+	{
+		mDirtyFlags[index] |= kLocalDirty;
+		mDirty = true;
+	}
+
+	void TransformHierarchy::setParallel(bool parallel)
+	{
+		mParallel = parallel;
+
+#ifndef __EMSCRIPTEN__
+		// the workers live as long as parallel updates are on, the calling thread takes a share too
+		const uint32_t numThreads = std::thread::hardware_concurrency();
+		if (mParallel && mJobSystem == nullptr && numThreads > 1)
+		{
+			mJobSystem = std::make_unique<JobSystem>();
+			mJobSystem->create(numThreads - 1);
+		}
+		else if (!mParallel)
+		{
+			mJobSystem = nullptr;
+		}
+#endif
+	}
+
+	void TransformHierarchy::update()
+	{
+		if (!mDirty || mTransforms.empty())
+		{
+			return;
+		}
+
+		const uint32_t numTransforms = (uint32_t)mTransforms.size();
+
+		if (mParallel && mJobSystem != nullptr && mChunks.size() > 1 && numTransforms >= kMinParallelTransforms)
+		{
+			// the split roots go first in array order, which puts every parent ahead of its children
+			for (auto root : mSubtreeRoots)
+			{
+				updateRange(root, root + 1, mChangedTransforms);
+			}
+
+			mChunkChanges.resize(mChunks.size());
+			mJobSystem->run((uint32_t)mChunks.size(), [this](uint32_t chunkIndex) {
+				const auto& chunk = mChunks[chunkIndex];
+				auto& changed = mChunkChanges[chunkIndex];
+
+				changed.clear();
+				for (uint32_t idx = chunk.first; idx < chunk.second; idx++)
+				{
+					updateRange(mSubtrees[idx].first, mSubtrees[idx].second, changed);
+				}
+			});
+
+			for (const auto& changed : mChunkChanges)
+			{
+				mChangedTransforms.insert(mChangedTransforms.end(), changed.begin(), changed.end());
+			}
+		}
+		else
+		{
+			updateRange(0, numTransforms, mChangedTransforms);
+		}
+
+		// changes pile up until clearChanges(), past one entry per transform the list
+		// is dropped and readers have to look at everything
+		if (mChangesOverflowed || mChangedTransforms.size() > mTransforms.size())
+		{
+			mChangedTransforms.clear();
+			mChangesOverflowed = true;
+		}
+
+		std::fill(mDirtyFlags.begin(), mDirtyFlags.end(), (uint8_t)0);
+		mDirty = false;
+	}
+
+	void TransformHierarchy::clearChanges()
+	{
+		mChangedTransforms.clear();
+		mChangesOverflowed = false;
+	}
+
+	void TransformHierarchy::buildSubtrees()
+	{
+		const uint32_t numTransforms = (uint32_t)mParents.size();
+
+		auto getChildren = [this, numTransforms](uint32_t root, std::vector<std::pair<uint32_t, uint32_t>>& subtrees) {
+			uint32_t end = root + 1;
+			while (end < numTransforms && mParents[end] != kInvalidIndex && mParents[end] >= root)
+			{
+				end++;
+			}
+
+			uint32_t child{ kInvalidIndex };
+			for (uint32_t idx = root + 1; idx < end; idx++)
+			{
+				if (mParents[idx] == root)
+				{
+					if (child != kInvalidIndex)
+					{
+						subtrees.push_back(std::make_pair(child, idx));
+					}
+
+					child = idx;
+				}
+			}
+
+			if (child != kInvalidIndex)
+			{
+				subtrees.push_back(std::make_pair(child, end));
+			}
+		};
+
+		if (numTransforms == 0)
+		{
+			return;
+		}
+
+		// a root with a handful of children gives too few subtrees to spread, so the largest
+		// ones are split further, their roots are updated serially ahead of the rest
+		mSubtreeRoots.push_back(0);
+		getChildren(0, mSubtrees);
+
+		while (mSubtrees.size() < kMinParallelSubtrees)
+		{
+			auto largest = std::max_element(mSubtrees.begin(), mSubtrees.end(), [](const auto& a, const auto& b) {
+				return a.second - a.first < b.second - b.first;
+			});
+
+			if (largest == mSubtrees.end() || largest->second - largest->first < 2)
+			{
+				break;
+			}
+
+			const uint32_t root = largest->first;
+			mSubtrees.erase(largest);
+			mSubtreeRoots.push_back(root);
+			getChildren(root, mSubtrees);
+		}
+
+		std::sort(mSubtreeRoots.begin(), mSubtreeRoots.end());
+		std::sort(mSubtrees.begin(), mSubtrees.end());
+
+		// subtrees are handed out in runs of roughly equal size, each run stays with one worker
+		const uint32_t numChunks = std::max(1u, std::thread::hardware_concurrency());
+		const uint32_t chunkSize = (numTransforms + numChunks - 1) / numChunks;
+
+		uint32_t chunkTransforms{ 0 };
+		for (uint32_t idx = 0; idx < (uint32_t)mSubtrees.size(); idx++)
+		{
+			if (mChunks.empty() || chunkTransforms >= chunkSize)
+			{
+				mChunks.push_back(std::make_pair(idx, idx));
+				chunkTransforms = 0;
+			}
+
+			mChunks.back().second = idx + 1;
+			chunkTransforms += mSubtrees[idx].second - mSubtrees[idx].first;
+		}
+	}
+
+	void TransformHierarchy::updateRange(uint32_t start, uint32_t end, std::vector<Transform*>& changed)
+	{
+		for (uint32_t idx = start; idx < end; idx++)
+		{
+			const uint32_t parent = mParents[idx];
+			if (parent != kInvalidIndex && mDirtyFlags[parent] != 0)
+			{
+				mDirtyFlags[idx] |= kWorldDirty;
+			}
+
+			if (mDirtyFlags[idx] == 0)
+			{
+				continue;
+			}
+
+			if (mDirtyFlags[idx] & kLocalDirty)
+			{
+				mLocalMatrices[idx] = mTransforms[idx]->getMatrix();
+			}
+
+			if (parent != kInvalidIndex)
+			{
+				mWorldMatrices[idx] = mWorldMatrices[parent] * mLocalMatrices[idx];
+			}
+			else
+			{
+				mWorldMatrices[idx] = mLocalMatrices[idx];
+			}
+
+			mTransforms[idx]->mWorldVersion++;
+			changed.push_back(mTransforms[idx]);
+		}
+	}
+}
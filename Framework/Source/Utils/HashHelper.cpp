@@ -0,0 +1,34 @@
+#include "Utils/HashHelper.h"
+#include <format>
+
+namespace Trinity
+{
+	uint64_t HashHelper::hash(const void* data, size_t size, uint64_t seed)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		uint64_t result = seed;
+
+		for (size_t idx = 0; idx < size; idx++)
+		{
+			result ^= bytes[idx];
+			result *= 1099511628211ull;
+		}
+
+		return result;
+	}
+
+	uint64_t HashHelper::hash(const std::string& str, uint64_t seed)
+	{
+		return hash(str.data(), str.size(), seed);
+	}
+
+	uint64_t HashHelper::combine(uint64_t seed, uint64_t value)
+	{
+		return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+	}
+
+	std::string HashHelper::toString(uint64_t hash)
+	{
+		return std::format("{:016x}", hash);
+	}
+}
@@ -0,0 +1,60 @@
+#include "Utils/SortHelper.h"
+#include <utility>
+
+namespace Trinity
+{
+	void SortHelper::radixSort(std::vector<uint64_t>& keys, std::vector<uint64_t>& scratch)
+	{
+		const uint32_t numKeys = (uint32_t)keys.size();
+		if (numKeys < 2)
+		{
+			return;
+		}
+
+		uint32_t histograms[kNumRadixPasses][kRadixSize]{};
+		for (const auto key : keys)
+		{
+			for (uint32_t pass = 0; pass < kNumRadixPasses; pass++)
+			{
+				histograms[pass][(key >> (pass * kRadixBits)) & (kRadixSize - 1)]++;
+			}
+		}
+
+		scratch.resize(numKeys);
+
+		auto* src = &keys;
+		auto* dst = &scratch;
+
+		for (uint32_t pass = 0; pass < kNumRadixPasses; pass++)
+		{
+			auto& histogram = histograms[pass];
+			const uint32_t shift = pass * kRadixBits;
+
+			// every key shares this digit, the pass would leave the order unchanged
+			if (histogram[((*src)[0] >> shift) & (kRadixSize - 1)] == numKeys)
+			{
+				continue;
+			}
+
+			uint32_t offset{ 0 };
+			for (uint32_t digit = 0; digit < kRadixSize; digit++)
+			{
+				const uint32_t count = histogram[digit];
+				histogram[digit] = offset;
+				offset += count;
+			}
+
+			for (const auto key : *src)
+			{
+				(*dst)[histogram[(key >> shift) & (kRadixSize - 1)]++] = key;
+			}
+
+			std::swap(src, dst);
+		}
+
+		if (src != &keys)
+		{
+			keys.swap(scratch);
+		}
+	}
+}
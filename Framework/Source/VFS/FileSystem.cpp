@@ -1,4 +1,5 @@
 #include "VFS/FileSystem.h"
+#include "VFS/MemoryFile.h"
 #include "Core/Debugger.h"
 #include "Core/Logger.h"
 
@@ -50,6 +51,14 @@ namespace Trinity
 
 	bool FileSystem::isExist(const std::string& filePath) const
 	{
+		{
+			std::lock_guard<std::mutex> lock(mMemoryFilesMutex);
+			if (mMemoryFiles.contains(filePath))
+			{
+				return true;
+			}
+		}
+
 		for (auto& it : mStorages)
 		{
 			std::string alias = it.first;
@@ -169,8 +178,67 @@ namespace Trinity
 		return false;
 	}
 
+	bool FileSystem::moveFile(const std::string& from, const std::string& to) const
+	{
+		for (auto& it : mStorages)
+		{
+			std::string alias = it.first;
+			std::string path = from;
+
+			if (path.starts_with(alias))
+			{
+				return it.second->moveFile(from, to);
+			}
+		}
+
+		return false;
+	}
+
+	bool FileSystem::removeFile(const std::string& filePath) const
+	{
+		for (auto& it : mStorages)
+		{
+			std::string alias = it.first;
+			std::string path = filePath;
+
+			if (path.starts_with(alias))
+			{
+				return it.second->removeFile(filePath);
+			}
+		}
+
+		return false;
+	}
+
+	void FileSystem::addMemoryFile(const std::string& filePath, std::vector<uint8_t>&& data)
+	{
+		std::lock_guard<std::mutex> lock(mMemoryFilesMutex);
+		mMemoryFiles[filePath] = std::move(data);
+	}
+
+	void FileSystem::removeMemoryFile(const std::string& filePath)
+	{
+		std::lock_guard<std::mutex> lock(mMemoryFilesMutex);
+		mMemoryFiles.erase(filePath);
+	}
+
 	std::unique_ptr<File> FileSystem::openFile(const std::string& filePath, FileOpenMode openMode)
 	{
+		if (openMode == FileOpenMode::OpenRead)
+		{
+			std::lock_guard<std::mutex> lock(mMemoryFilesMutex);
+
+			auto it = mMemoryFiles.find(filePath);
+			if (it != mMemoryFiles.end())
+			{
+				auto file = std::make_unique<MemoryFile>();
+				file->create(filePath, std::move(it->second));
+				mMemoryFiles.erase(it);
+
+				return file;
+			}
+		}
+
 		for (auto& it : mStorages)
 		{
 			std::string alias = it.first;
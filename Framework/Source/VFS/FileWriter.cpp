@@ -1,7 +1,50 @@
 #include "VFS/FileWriter.h"
+#include "Core/Logger.h"
 
 namespace Trinity
 {
+	FileWriter::FileWriter(File& file, uint32_t bufferSize)
+		: mFile(file), mBufferSize(bufferSize)
+	{
+		mBuffer.reserve(mBufferSize);
+	}
+
+	FileWriter::~FileWriter()
+	{
+		flush();
+	}
+
+	bool FileWriter::writeBytes(const void* data, uint32_t size, uint32_t* writeSize)
+	{
+		if (writeSize)
+		{
+			*writeSize = 0;
+		}
+
+		if (mBuffer.size() + size > mBufferSize)
+		{
+			if (!flush())
+			{
+				return false;
+			}
+		}
+
+		if (size >= mBufferSize)
+		{
+			return mFile.write(data, size, writeSize);
+		}
+
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		mBuffer.insert(mBuffer.end(), bytes, bytes + size);
+
+		if (writeSize)
+		{
+			*writeSize = size;
+		}
+
+		return true;
+	}
+
 	bool FileWriter::writeString(const std::string& str)
 	{
 		uint32_t len = (uint32_t)str.length();
@@ -21,6 +64,30 @@ namespace Trinity
 
 	bool FileWriter::seek(SeekOrigin origin, uint32_t offset)
 	{
+		if (!flush())
+		{
+			return false;
+		}
+
 		return mFile.seek(origin, offset);
 	}
-}
\ No newline at end of file
+
+	bool FileWriter::flush()
+	{
+		if (mBuffer.empty())
+		{
+			return true;
+		}
+
+		const bool result = mFile.write(mBuffer.data(), (uint32_t)mBuffer.size());
+		mBuffer.clear();
+
+		if (!result)
+		{
+			LogError("File::write() failed for: %s!!", mFile.getPath().c_str());
+			return false;
+		}
+
+		return true;
+	}
+}
@@ -130,6 +130,27 @@ namespace Trinity
 		return ec.value() == 0;
 	}
 
+	bool Folder::moveFile(const std::string& from, const std::string& to)
+	{
+		std::string actualFrom = getActualPath(from);
+		std::string actualTo = getActualPath(to);
+
+		std::error_code ec;
+		fs::rename(actualFrom, actualTo, ec);
+
+		return ec.value() == 0;
+	}
+
+	bool Folder::removeFile(const std::string& filePath)
+	{
+		std::string actualPath = getActualPath(filePath);
+
+		std::error_code ec;
+		fs::remove(actualPath, ec);
+
+		return ec.value() == 0;
+	}
+
 	std::string Folder::getActualPath(const std::string& virtualPath) const
 	{
 		std::string alias = mAlias;
@@ -0,0 +1,105 @@
+#include "VFS/MemoryFile.h"
+#include "Core/Logger.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Trinity
+{
+	bool MemoryFile::create(const std::string& filePath, std::vector<uint8_t>&& data, FileOpenMode fileOpenMode)
+	{
+		mData = std::move(data);
+		mOpenMode = fileOpenMode;
+		mPath = filePath;
+		mSize = (uint32_t)mData.size();
+		mPosition = fileOpenMode == FileOpenMode::Append ? mSize : 0;
+
+		return true;
+	}
+
+	std::vector<uint8_t> MemoryFile::release()
+	{
+		mSize = 0;
+		mPosition = 0;
+
+		return std::move(mData);
+	}
+
+	bool MemoryFile::isEOF() const
+	{
+		return mPosition >= mSize;
+	}
+
+	bool MemoryFile::seek(SeekOrigin origin, int32_t offset)
+	{
+		int64_t position{ 0 };
+
+		switch (origin)
+		{
+		case SeekOrigin::Beginning:
+			position = offset;
+			break;
+
+		case SeekOrigin::Current:
+			position = (int64_t)mPosition + offset;
+			break;
+
+		case SeekOrigin::End:
+			position = (int64_t)mSize + offset;
+			break;
+
+		default:
+			break;
+		}
+
+		mPosition = (uint32_t)std::clamp<int64_t>(position, 0, mSize);
+		return true;
+	}
+
+	bool MemoryFile::read(void* data, uint32_t size, uint32_t* readSize)
+	{
+		if (!canRead())
+		{
+			LogError("File not opened for reading: %s", mPath.c_str());
+			return false;
+		}
+
+		const uint32_t numBytes = std::min(size, mSize - mPosition);
+		if (numBytes > 0)
+		{
+			std::memcpy(data, mData.data() + mPosition, numBytes);
+			mPosition += numBytes;
+		}
+
+		if (readSize)
+		{
+			*readSize = numBytes;
+		}
+
+		return true;
+	}
+
+	bool MemoryFile::write(const void* data, uint32_t size, uint32_t* writeSize)
+	{
+		if (canRead())
+		{
+			LogError("File not opened for writing: %s", mPath.c_str());
+			return false;
+		}
+
+		if (mPosition + size > mData.size())
+		{
+			mData.resize(mPosition + size);
+		}
+
+		std::memcpy(mData.data() + mPosition, data, size);
+		mPosition += size;
+		mSize = std::max(mSize, mPosition);
+
+		if (writeSize)
+		{
+			*writeSize = size;
+		}
+
+		return true;
+	}
+}
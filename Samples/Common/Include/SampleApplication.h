@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Core/Application.h"
+#include "Core/Clock.h"
 
 namespace Trinity
 {
@@ -42,11 +43,14 @@ namespace Trinity
 		virtual void update(float deltaTime) override;
 		virtual void onResize() override;
 		virtual void onSceneLoaded();
+		virtual bool preload(const std::string& fileName);
 
 	protected:
 
 		std::unique_ptr<Scene> mScene{ nullptr };
 		std::unique_ptr<SceneRenderer> mSceneRenderer{ nullptr };
 		std::vector<Script*> mScripts;
+		TimePoint mStartTime;
+		bool mStarted{ false };
 	};
 }
\ No newline at end of file
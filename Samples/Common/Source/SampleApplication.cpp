@@ -5,13 +5,19 @@
 #include "Scene/ComponentFactory.h"
 #include "Scene/Components/Script.h"
 #include "Graphics/RenderPass.h"
+#include "Graphics/PipelineCache.h"
+#include "Graphics/BlobCache.h"
 #include "Core/Logger.h"
 #include "Core/ResourceCache.h"
+#include "Core/PreloadManifest.h"
+#include "VFS/FileSystem.h"
 
 namespace Trinity
 {
 	bool SampleApplication::init()
 	{
+		mStartTime = std::chrono::high_resolution_clock::now();
+
 		if (!Application::init())
 		{
 			return false;
@@ -20,6 +26,7 @@ namespace Trinity
 		if (mConfig.contains("scene"))
 		{
 			std::string sceneFile = mConfig["scene"].get<std::string>();
+			preload(sceneFile);
 
 			SceneLoader sceneLoader;
 			mScene = sceneLoader.loadScene(sceneFile, *mResourceCache);
@@ -35,6 +42,7 @@ namespace Trinity
 		else if (mConfig.contains("model"))
 		{
 			std::string modelFile = mConfig["model"].get<std::string>();
+			preload(modelFile);
 
 			SceneLoader sceneLoader;
 			mScene = sceneLoader.loadSceneWithModel(modelFile, *mResourceCache);
@@ -84,6 +92,22 @@ namespace Trinity
 	{
 		Application::update(deltaTime);
 
+		if (!mStarted)
+		{
+			Duration startupTime = std::chrono::high_resolution_clock::now() - mStartTime;
+			LogInfo("Startup took %.2f ms", startupTime.count());
+			LogInfo("Render pipelines: %d created in %.2f ms, %d reused", mPipelineCache->getNumCreated(),
+				mPipelineCache->getCreateTime(), mPipelineCache->getNumReused());
+
+			if (mBlobCache != nullptr)
+			{
+				LogInfo("Pipeline blob cache (%s): %d hits, %d misses, %d stored",
+					mBlobCache->isWarm() ? "warm" : "cold", mBlobCache->getNumHits(),
+					mBlobCache->getNumMisses(), mBlobCache->getNumStored());
+			}
+			mStarted = true;
+		}
+
 		if (mScene != nullptr)
 		{
 			for (auto& script : mScripts)
@@ -109,4 +133,22 @@ namespace Trinity
 	void SampleApplication::onSceneLoaded()
 	{
 	}
+
+	bool SampleApplication::preload(const std::string& fileName)
+	{
+		auto manifestFileName = PreloadManifest::getManifestFileName(fileName);
+		if (!FileSystem::get().isExist(manifestFileName))
+		{
+			return false;
+		}
+
+		PreloadManifest manifest;
+		if (!manifest.create(manifestFileName, *mResourceCache))
+		{
+			LogWarning("PreloadManifest::create() failed for: %s", manifestFileName.c_str());
+			return false;
+		}
+
+		return mResourceCache->preload(manifest);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,41 @@
+#define MAX_INSTANCES 512
+
+struct Transform
+{
+  model: mat4x4<f32>,
+  rotation: mat4x4<f32>
+};
+
+struct PerFrameData
+{
+  view: mat4x4<f32>,
+  proj: mat4x4<f32>,
+  camera_pos: vec3<f32>,
+  num_lights: u32
+};
+
+@group(0)
+@binding(0)
+var<uniform> per_frame_data: PerFrameData;
+
+@group(1)
+@binding(0)
+var<uniform> transforms: array<Transform, MAX_INSTANCES>;
+
+struct VertexOutput
+{
+  @invariant @builtin(position) clip_position: vec4<f32>
+};
+
+@vertex
+fn vs_main(@location(0) position: vec3<f32>, @builtin(instance_index) instance_index: u32) -> VertexOutput
+{
+  let transform = transforms[instance_index];
+
+  // has to match the position math of the main pass exactly, it's depth tested for equality
+  var out: VertexOutput;
+  var local_pos = transform.model * vec4<f32>(position, 1.0);
+  out.clip_position = per_frame_data.proj * per_frame_data.view * local_pos;
+
+  return out;
+}
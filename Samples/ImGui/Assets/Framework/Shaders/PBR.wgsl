@@ -1,5 +1,7 @@
 #define DIRECTIONAL_LIGHT 0
 #define POINT_LIGHT 1
+#define SPOT_LIGHT 2
+#define MAX_INSTANCES 512
 
 struct Transform
 {
@@ -12,7 +14,9 @@ struct PerFrameData
   view: mat4x4<f32>,
   proj: mat4x4<f32>,
   camera_pos: vec3<f32>,
-  num_lights: u32
+  num_lights: u32,
+  cluster_size: vec4<u32>,
+  cluster_params: vec4<f32>
 };
 
 struct Light
@@ -41,6 +45,14 @@ var<uniform> per_frame_data: PerFrameData;
 @binding(1)
 var<storage, read> lights: array<Light>;
 
+@group(0)
+@binding(2)
+var<storage, read> clusters: array<vec2<u32>>;
+
+@group(0)
+@binding(3)
+var<storage, read> light_indices: array<u32>;
+
 @group(1)
 @binding(0)
 var<uniform> material: PBRMaterial;
@@ -77,7 +89,7 @@ var metallic_roughness_texture: texture_2d<f32>;
 
 @group(2)
 @binding(0)
-var<uniform> transform: Transform;
+var<uniform> transforms: array<Transform, MAX_INSTANCES>;
 
 #ifdef HAS_SKIN
 @group(2)
@@ -92,7 +104,11 @@ var<storage, read> bindPose: array<mat4x4<f32>>;
 struct VertexInput
 {
   @location(0) position: vec3<f32>,
+#ifdef HAS_COMPACT_VERTEX
+  @location(1) normal: vec2<f32>,
+#else
   @location(1) normal: vec3<f32>,
+#endif
   @location(2) uv: vec2<f32>,
 #ifdef HAS_SKIN
   @location(3) joints: vec4<u32>,
@@ -102,7 +118,7 @@ struct VertexInput
 
 struct FragmentInput
 {
-  @builtin(position) clip_position: vec4<f32>,
+  @invariant @builtin(position) clip_position: vec4<f32>,
   @location(0) position: vec3<f32>,
   @location(1) uv: vec2<f32>,
   @location(2) normal: vec3<f32>
@@ -205,11 +221,26 @@ fn apply_directional_light(light: Light, normal: vec3<f32>) -> vec3<f32>
   return ndotl * light.color.w * light.color.rgb;
 }
 
+fn get_range_attenuation(light: Light, dist: f32) -> f32
+{
+  var atten = 1.0 / max(dist * dist, 0.0001);
+  if (light.direction.w <= 0.0)
+  {
+    return atten;
+  }
+
+  // fades out at the range so the light never reaches past its clusters
+  var ratio = dist / light.direction.w;
+  var falloff = f_saturate(1.0 - ratio * ratio * ratio * ratio);
+
+  return atten * falloff * falloff;
+}
+
 fn apply_point_light(light: Light, in_pos: vec3<f32>, normal: vec3<f32>) -> vec3<f32>
 {
   var world_to_light = light.position.xyz - in_pos.xyz;
   var dist = length(world_to_light);
-  var atten = 1.0 / (dist * dist);
+  var atten = get_range_attenuation(light, dist);
 
   world_to_light = normalize(world_to_light);
   var ndotl = clamp(dot(normal, world_to_light), 0.0, 1.0);
@@ -217,39 +248,109 @@ fn apply_point_light(light: Light, in_pos: vec3<f32>, normal: vec3<f32>) -> vec3
   return ndotl * light.color.w * atten * light.color.rgb;
 }
 
+fn apply_spot_light(light: Light, in_pos: vec3<f32>, normal: vec3<f32>) -> vec3<f32>
+{
+  var world_to_light = normalize(light.position.xyz - in_pos.xyz);
+  var cos_outer = cos(light.info.y);
+  var scale = 1.0 / max(cos(light.info.x) - cos_outer, 0.001);
+  var cone = f_saturate((dot(normalize(light.direction.xyz), -world_to_light) - cos_outer) * scale);
+
+  return apply_point_light(light, in_pos, normal) * cone * cone;
+}
+
 fn get_light_direction(light: Light, in_pos: vec3<f32>) -> vec3<f32>
 {
   if (light.position.w == DIRECTIONAL_LIGHT)
   {
-    return -light.direction.xyz;
+    return normalize(-light.direction.xyz);
+  }
+
+  return normalize(light.position.xyz - in_pos.xyz);
+}
+
+fn shade_light(light: Light, in_pos: vec3<f32>, n: vec3<f32>, v: vec3<f32>, ndotv: f32, f0: vec3<f32>, f90: f32,
+  diffuse_color: vec3<f32>, roughness: f32) -> vec3<f32>
+{
+  var l = get_light_direction(light, in_pos);
+  var h = normalize(v + l);
+
+  var ldoth = f_saturate(dot(l, h));
+  var ndoth = f_saturate(dot(n, h));
+  var ndotl = f_saturate(dot(n, l));
+
+  var f = f_schlick(f0, f90, ldoth);
+  var d = d_ggx(ndoth, roughness);
+  var vis = v_smith_ggx_correlated(ndotv, ndotl, roughness);
+  var fr = f * d * vis;
+  var fd = fr_disney_diffuse(ndotv, ndotl, ldoth, roughness);
+  var brdf = diffuse_color * (vec3<f32>(1.0) - f) * fd + fr;
+
+  if (light.position.w == DIRECTIONAL_LIGHT)
+  {
+    return apply_directional_light(light, n) * brdf;
   }
 
   if (light.position.w == POINT_LIGHT)
   {
-    return light.position.xyz - in_pos.xyz;
+    return apply_point_light(light, in_pos, n) * brdf;
   }
 
-  return -light.direction.xyz;
+  return apply_spot_light(light, in_pos, n) * brdf;
 }
 
+fn get_cluster(frag_coord: vec2<f32>, in_pos: vec3<f32>) -> vec2<u32>
+{
+  var size = per_frame_data.cluster_size;
+  var params = per_frame_data.cluster_params;
+  var view_depth = -(per_frame_data.view * vec4<f32>(in_pos, 1.0)).z;
+
+  var tile = min(vec2<u32>(frag_coord / params.xy), size.xy - vec2<u32>(1u));
+  var slice = u32(clamp(floor(log(max(view_depth, 0.0001)) * params.z + params.w), 0.0, f32(size.z - 1u)));
+
+  return clusters[tile.x + size.x * (tile.y + size.y * slice)];
+}
+
+#ifdef HAS_COMPACT_VERTEX
+fn decode_octahedral(e: vec2<f32>) -> vec3<f32>
+{
+  var n = vec3<f32>(e, 1.0 - abs(e.x) - abs(e.y));
+  let t = max(-n.z, 0.0);
+  n.x += select(t, -t, n.x >= 0.0);
+  n.y += select(t, -t, n.y >= 0.0);
+
+  return normalize(n);
+}
+#endif
+
 @vertex
-fn vs_main(in: VertexInput) -> FragmentInput
+fn vs_main(in: VertexInput, @builtin(instance_index) instance_index: u32) -> FragmentInput
 {
+  let transform = transforms[instance_index];
+
 #ifdef HAS_SKIN
   var skin = (bindPose[in.joints.x] * invBindPose[in.joints.x]) * in.weights.x;
     skin += (bindPose[in.joints.y] * invBindPose[in.joints.y]) * in.weights.y;
     skin += (bindPose[in.joints.z] * invBindPose[in.joints.z]) * in.weights.z;
     skin += (bindPose[in.joints.w] * invBindPose[in.joints.w]) * in.weights.w;
-#else
-  var skin = mat4x4<f32>(vec4<f32>(1.0, 0.0, 0.0, 0.0), vec4<f32>(0.0, 1.0, 0.0, 0.0),
-    vec4<f32>(0.0, 0.0, 1.0, 0.0), vec4<f32>(0.0, 0.0, 0.0, 1.0));
 #endif
  
   var out: FragmentInput;
+
+  // static meshes skip the skin matrix, the depth prepass repeats this math exactly
+#ifdef HAS_SKIN
   var local_pos = transform.model * skin * vec4<f32>(in.position, 1.0);
+#else
+  var local_pos = transform.model * vec4<f32>(in.position, 1.0);
+#endif
+
+#ifdef HAS_COMPACT_VERTEX
+  var in_normal = decode_octahedral(in.normal);
+#else
+  var in_normal = in.normal;
+#endif
 
   out.uv = in.uv;  
-  out.normal = (transform.rotation * vec4<f32>(in.normal, 0.0)).xyz;
+  out.normal = (transform.rotation * vec4<f32>(in_normal, 0.0)).xyz;
   out.clip_position = per_frame_data.proj * per_frame_data.view * local_pos;
   out.position = local_pos.xyz;
 
@@ -285,31 +386,17 @@ fn fs_main(in: FragmentInput) -> FragmentOutput
   var light_contribution = vec3<f32>(0.0);
   var diffuse_color = base_color.rgb * (1.0 - metallic);
 
-  for (var i: u32 = 0; i < per_frame_data.num_lights; i++)
+  for (var i: u32 = 0; i < per_frame_data.cluster_size.w; i++)
+  {
+    light_contribution += shade_light(lights[light_indices[i]], in.position, n, v, ndotv, f0, f90,
+      diffuse_color, roughness);
+  }
+
+  var cluster = get_cluster(in.clip_position.xy, in.position);
+  for (var i: u32 = 0; i < cluster.y; i++)
   {
-    var light = lights[i];
-    var l = get_light_direction(light, in.position);
-    var h = normalize(v + l);
-
-    var ldoth = f_saturate(dot(l, h));
-    var ndoth = f_saturate(dot(n, h));
-    var ndotl = f_saturate(dot(n, l));
-
-    var f = f_schlick(f0, f90, ldoth);
-    var d = d_ggx(ndoth, roughness);
-    var vis = v_smith_ggx_correlated(ndotv, ndotl, roughness);
-    var fr = f * d * vis;
-    var fd = fr_disney_diffuse(ndotv, ndotl, ldoth, roughness);
-
-    if ( light.position.w == DIRECTIONAL_LIGHT)
-    {
-      light_contribution += apply_directional_light(light, n) * (diffuse_color * (vec3<f32>(1.0) - f) * fd + fr);
-    }
-
-    if ( light.position.w == POINT_LIGHT)
-    {
-      light_contribution += apply_point_light(light, in.position, n) * (diffuse_color * (vec3<f32>(1.0) - f) * fd + fr);
-    }
+    light_contribution += shade_light(lights[light_indices[cluster.x + i]], in.position, n, v, ndotv, f0, f90,
+      diffuse_color, roughness);
   }
 
   var irradiance = vec3<f32>(0.5);
@@ -0,0 +1,60 @@
+@group(0)
+@binding(0)
+var depth_texture: texture_depth_2d;
+
+@group(0)
+@binding(0)
+var src_texture: texture_2d<f32>;
+
+@group(0)
+@binding(1)
+var dst_texture: texture_storage_2d<r32float, write>;
+
+@compute
+@workgroup_size(8, 8)
+fn cs_copy(@builtin(global_invocation_id) id: vec3<u32>)
+{
+  let dst_size = textureDimensions(dst_texture);
+  if (id.x >= dst_size.x || id.y >= dst_size.y)
+  {
+    return;
+  }
+
+  // the base level is a power of two at or below the depth buffer size, so a texel
+  // covers up to 3x3 depth samples and keeps the farthest one to stay conservative
+  let src_size = textureDimensions(depth_texture);
+  let begin = (id.xy * src_size) / dst_size;
+  let end = min(((id.xy + 1u) * src_size + dst_size - 1u) / dst_size, src_size);
+
+  var depth = 0.0;
+  for (var y = begin.y; y < end.y; y++)
+  {
+    for (var x = begin.x; x < end.x; x++)
+    {
+      depth = max(depth, textureLoad(depth_texture, vec2<i32>(i32(x), i32(y)), 0));
+    }
+  }
+
+  textureStore(dst_texture, vec2<i32>(id.xy), vec4<f32>(depth, 0.0, 0.0, 0.0));
+}
+
+@compute
+@workgroup_size(8, 8)
+fn cs_reduce(@builtin(global_invocation_id) id: vec3<u32>)
+{
+  let dst_size = textureDimensions(dst_texture);
+  if (id.x >= dst_size.x || id.y >= dst_size.y)
+  {
+    return;
+  }
+
+  let last = vec2<i32>(textureDimensions(src_texture, 0)) - 1;
+  let coord = vec2<i32>(id.xy) * 2;
+
+  let d0 = textureLoad(src_texture, min(coord, last), 0).r;
+  let d1 = textureLoad(src_texture, min(coord + vec2<i32>(1, 0), last), 0).r;
+  let d2 = textureLoad(src_texture, min(coord + vec2<i32>(0, 1), last), 0).r;
+  let d3 = textureLoad(src_texture, min(coord + vec2<i32>(1, 1), last), 0).r;
+
+  textureStore(dst_texture, vec2<i32>(id.xy), vec4<f32>(max(max(d0, d1), max(d2, d3)), 0.0, 0.0, 0.0));
+}
@@ -0,0 +1,143 @@
+struct CullParams
+{
+  planes: array<vec4<f32>, 6>,
+  camera_pos: vec3<f32>,
+  num_meshlets: u32,
+  camera_dir: vec3<f32>,
+  perspective: u32
+};
+
+struct CullStats
+{
+  num_frustum_culled: atomic<u32>,
+  num_cone_culled: atomic<u32>
+};
+
+struct Meshlet
+{
+  center: vec3<f32>,
+  radius: f32,
+  cone_axis: vec3<f32>,
+  cone_cutoff: f32,
+  first_index: u32,
+  num_indices: u32,
+  group_index: u32,
+  padding: u32
+};
+
+struct Transform
+{
+  model: mat4x4<f32>,
+  rotation: mat4x4<f32>
+};
+
+struct DrawArgs
+{
+  index_count: atomic<u32>,
+  instance_count: u32,
+  first_index: u32,
+  base_vertex: i32,
+  first_instance: u32
+};
+
+@group(0)
+@binding(0)
+var<uniform> params: CullParams;
+
+@group(0)
+@binding(1)
+var<storage, read> meshlets: array<Meshlet>;
+
+@group(0)
+@binding(2)
+var<storage, read> transforms: array<Transform>;
+
+@group(0)
+@binding(3)
+var<storage, read_write> draws: array<DrawArgs>;
+
+@group(0)
+@binding(4)
+var<storage, read_write> stats: CullStats;
+
+@group(0)
+@binding(5)
+var<storage, read> source_indices: array<u32>;
+
+@group(0)
+@binding(6)
+var<storage, read_write> indices: array<u32>;
+
+fn is_visible(center: vec3<f32>, radius: f32) -> bool
+{
+  for (var idx = 0u; idx < 6u; idx++)
+  {
+    let plane = params.planes[idx];
+    if (dot(center, plane.xyz) + plane.w < -radius)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+fn is_backfacing(center: vec3<f32>, radius: f32, axis: vec3<f32>, cutoff: f32) -> bool
+{
+  // every triangle normal lies within the cone, so it faces away wherever the whole sphere
+  // sees the cone from behind, orthographic cameras look along a single direction
+  if (params.perspective != 0u)
+  {
+    let view = center - params.camera_pos;
+    return dot(view, axis) >= cutoff * length(view) + radius;
+  }
+
+  return dot(params.camera_dir, axis) >= cutoff;
+}
+
+@compute
+@workgroup_size(64)
+fn cs_main(@builtin(global_invocation_id) id: vec3<u32>)
+{
+  if (id.x >= params.num_meshlets)
+  {
+    return;
+  }
+
+  let meshlet = meshlets[id.x];
+  let transform = transforms[meshlet.group_index];
+
+  let scale = vec3<f32>(length(transform.model[0].xyz), length(transform.model[1].xyz), length(transform.model[2].xyz));
+  let max_scale = max(scale.x, max(scale.y, scale.z));
+  let min_scale = min(scale.x, min(scale.y, scale.z));
+
+  let center = (transform.model * vec4<f32>(meshlet.center, 1.0)).xyz;
+  let radius = meshlet.radius * max_scale;
+
+  if (!is_visible(center, radius))
+  {
+    atomicAdd(&stats.num_frustum_culled, 1u);
+    return;
+  }
+
+  // non uniform scale bends the normals out of the cone, those meshlets are always drawn
+  if (meshlet.cone_cutoff < 1.0 && max_scale - min_scale <= 0.001 * max_scale)
+  {
+    let axis = normalize((transform.rotation * vec4<f32>(meshlet.cone_axis, 0.0)).xyz);
+    if (is_backfacing(center, radius, axis, meshlet.cone_cutoff))
+    {
+      atomicAdd(&stats.num_cone_culled, 1u);
+      return;
+    }
+  }
+
+  // survivors are appended to the output region of their group, which is drawn with a single
+  // indirect draw whose index count is the total appended here
+  let offset = atomicAdd(&draws[meshlet.group_index].index_count, meshlet.num_indices);
+  let first_index = draws[meshlet.group_index].first_index + offset;
+
+  for (var idx = 0u; idx < meshlet.num_indices; idx++)
+  {
+    indices[first_index + idx] = source_indices[meshlet.first_index + idx];
+  }
+}
@@ -40,6 +40,8 @@ namespace Trinity
 		if (mConfig.contains("terrain"))
 		{
 			auto terrainFile = mConfig["terrain"].get<std::string>();
+			preload(terrainFile);
+
 			mTerrain = std::make_unique<Terrain>();
 
 			if (!mTerrain->create(terrainFile, *mResourceCache))
@@ -61,6 +63,8 @@ namespace Trinity
 		if (mConfig.contains("skybox"))
 		{
 			auto skyboxFile = mConfig["skybox"].get<std::string>();
+			preload(skyboxFile);
+
 			mSkybox = std::make_unique<Skybox>();
 
 			if (!mSkybox->create(skyboxFile, *mResourceCache))
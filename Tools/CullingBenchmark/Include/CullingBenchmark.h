@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Core/ConsoleApplication.h"
+#include "Math/BoundingBox.h"
+#include "Math/BoundingBoxBatch.h"
+#include "Math/Frustum.h"
+#include <vector>
+
+namespace Trinity
+{
+	class CullingBenchmark : public ConsoleApplication
+	{
+	public:
+
+		CullingBenchmark() = default;
+		~CullingBenchmark() = default;
+
+		CullingBenchmark(const CullingBenchmark&) = delete;
+		CullingBenchmark& operator = (const CullingBenchmark&) = delete;
+
+		CullingBenchmark(CullingBenchmark&&) noexcept = default;
+		CullingBenchmark& operator = (CullingBenchmark&&) noexcept = default;
+
+		void setInstanceCounts(std::vector<uint32_t>&& instanceCounts);
+		void setNumQueries(uint32_t numQueries);
+
+	protected:
+
+		virtual void execute() override;
+		virtual void runBoundsTree(uint32_t numInstances);
+		virtual void runBatchCulling(uint32_t numInstances);
+		virtual void runReferenceCulling(const std::vector<BoundingBox>& boxes, const BoundingBoxBatch& batch,
+			const std::vector<Frustum>& frustums);
+
+	private:
+
+		std::vector<uint32_t> mInstanceCounts;
+		uint32_t mNumQueries{ 0 };
+	};
+}
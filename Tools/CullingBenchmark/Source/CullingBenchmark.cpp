@@ -0,0 +1,348 @@
+#include "CullingBenchmark.h"
+#include "Math/BoundingVolumeHierarchy.h"
+#include "Math/BoundingBoxBatch.h"
+#include "Math/Frustum.h"
+#include "Graphics/CullingPass.h"
+#include "Core/Logger.h"
+#include "CLI/App.hpp"
+#include "CLI/Formatter.hpp"
+#include "CLI/Config.hpp"
+#include <chrono>
+#include <random>
+
+namespace Trinity
+{
+	using BenchmarkClock = std::chrono::steady_clock;
+
+	static double getElapsedMs(BenchmarkClock::time_point startTime)
+	{
+		return std::chrono::duration<double, std::milli>(BenchmarkClock::now() - startTime).count();
+	}
+
+	void CullingBenchmark::setInstanceCounts(std::vector<uint32_t>&& instanceCounts)
+	{
+		mInstanceCounts = std::move(instanceCounts);
+	}
+
+	void CullingBenchmark::setNumQueries(uint32_t numQueries)
+	{
+		mNumQueries = numQueries;
+	}
+
+	void CullingBenchmark::execute()
+	{
+		mResult = true;
+		mShouldExit = true;
+
+		for (auto numInstances : mInstanceCounts)
+		{
+			runBoundsTree(numInstances);
+			runBatchCulling(numInstances);
+		}
+	}
+
+	void CullingBenchmark::runBoundsTree(uint32_t numInstances)
+	{
+		// instances scattered over a square world, like props or trees on a terrain
+		const float worldSize = 20.0f * std::sqrt((float)numInstances);
+
+		std::mt19937 rng{ numInstances };
+		std::uniform_real_distribution<float> position{ 0.0f, worldSize };
+		std::uniform_real_distribution<float> size{ 0.5f, 4.0f };
+
+		std::vector<BoundingBox> boxes(numInstances);
+		for (auto& box : boxes)
+		{
+			const glm::vec3 center{ position(rng), size(rng), position(rng) };
+			const glm::vec3 extents{ size(rng), size(rng), size(rng) };
+
+			box = { center - extents, center + extents };
+		}
+
+		BoundingVolumeHierarchy tree;
+		std::vector<uint32_t> proxies(numInstances);
+
+		auto startTime = BenchmarkClock::now();
+		for (uint32_t idx = 0; idx < numInstances; idx++)
+		{
+			proxies[idx] = tree.createProxy(boxes[idx], idx);
+		}
+
+		const double buildTime = getElapsedMs(startTime);
+
+		std::uniform_int_distribution<uint32_t> instance{ 0, numInstances - 1 };
+		std::uniform_real_distribution<float> offset{ -1.0f, 1.0f };
+
+		startTime = BenchmarkClock::now();
+		for (uint32_t idx = 0; idx < numInstances / 10; idx++)
+		{
+			const uint32_t moved = instance(rng);
+			const glm::vec3 delta{ offset(rng), 0.0f, offset(rng) };
+
+			boxes[moved] = { boxes[moved].min + delta, boxes[moved].max + delta };
+			tree.moveProxy(proxies[moved], boxes[moved]);
+		}
+
+		const double updateTime = getElapsedMs(startTime);
+
+		std::vector<Frustum> frustums(mNumQueries);
+		for (auto& frustum : frustums)
+		{
+			const glm::vec3 eye{ position(rng), 10.0f, position(rng) };
+			const glm::vec3 target{ position(rng), 0.0f, position(rng) };
+
+			frustum.fromMatrix(glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f) *
+				glm::lookAt(eye, target, glm::vec3(0.0f, 1.0f, 0.0f)));
+		}
+
+		uint64_t numBruteForce{ 0 };
+		startTime = BenchmarkClock::now();
+
+		for (const auto& frustum : frustums)
+		{
+			for (const auto& box : boxes)
+			{
+				numBruteForce += frustum.intersect(box) != Intersection::Outside ? 1 : 0;
+			}
+		}
+
+		const double bruteForceTime = getElapsedMs(startTime) / mNumQueries;
+
+		uint64_t numTree{ 0 };
+		startTime = BenchmarkClock::now();
+
+		for (const auto& frustum : frustums)
+		{
+			tree.query(frustum, [&](uint32_t idx) {
+				numTree += frustum.intersect(boxes[idx]) != Intersection::Outside ? 1 : 0;
+			});
+		}
+
+		const double treeTime = getElapsedMs(startTime) / mNumQueries;
+
+		uint64_t numOverlaps{ 0 };
+		startTime = BenchmarkClock::now();
+
+		for (uint32_t idx = 0; idx < mNumQueries; idx++)
+		{
+			const glm::vec3 center{ position(rng), 0.0f, position(rng) };
+			const BoundingBox bounds{ center - glm::vec3(25.0f), center + glm::vec3(25.0f) };
+
+			tree.query(bounds, [&](uint32_t) {
+				numOverlaps++;
+			});
+		}
+
+		const double overlapTime = getElapsedMs(startTime) / mNumQueries;
+
+		uint32_t numHits{ 0 };
+		startTime = BenchmarkClock::now();
+
+		for (uint32_t idx = 0; idx < mNumQueries; idx++)
+		{
+			const glm::vec3 origin{ position(rng), 2.0f, position(rng) };
+			const glm::vec3 direction = glm::normalize(glm::vec3(offset(rng), 0.0f, offset(rng)) + glm::vec3(0.0f, 0.0001f, 0.0f));
+			const glm::vec3 invDirection = 1.0f / direction;
+
+			float closest = worldSize;
+			bool hit{ false };
+
+			tree.raycast(origin, direction, closest, [&](uint32_t proxy, float) {
+				float distance{ 0.0f };
+				if (BoundingVolumeHierarchy::intersectRay(boxes[proxy], origin, invDirection, closest, distance) && distance < closest)
+				{
+					closest = distance;
+					hit = true;
+				}
+
+				return closest;
+			});
+
+			numHits += hit ? 1 : 0;
+		}
+
+		const double rayTime = getElapsedMs(startTime) / mNumQueries;
+
+		LogInfo("%u instances: build %.2f ms, move 10%% %.2f ms, height %u", numInstances, buildTime, updateTime, tree.getHeight());
+		LogInfo("  frustum: brute force %.4f ms, tree %.4f ms (%llu / %llu visible)", bruteForceTime, treeTime,
+			(unsigned long long)numTree, (unsigned long long)numBruteForce);
+		LogInfo("  overlap %.4f ms (%llu candidates), raycast %.4f ms (%u hits)", overlapTime,
+			(unsigned long long)numOverlaps, rayTime, numHits);
+
+		if (numTree != numBruteForce)
+		{
+			LogError("Tree and brute force visibility mismatch for %u instances!!", numInstances);
+			mResult = false;
+		}
+	}
+
+	void CullingBenchmark::runBatchCulling(uint32_t numInstances)
+	{
+		const float worldSize = 20.0f * std::sqrt((float)numInstances);
+
+		std::mt19937 rng{ numInstances };
+		std::uniform_real_distribution<float> position{ 0.0f, worldSize };
+		std::uniform_real_distribution<float> size{ 0.5f, 4.0f };
+
+		std::vector<BoundingBox> boxes(numInstances);
+		BoundingBoxBatch batch;
+		batch.resize(numInstances);
+
+		for (uint32_t idx = 0; idx < numInstances; idx++)
+		{
+			const glm::vec3 center{ position(rng), size(rng), position(rng) };
+			const glm::vec3 extents{ size(rng), size(rng), size(rng) };
+
+			boxes[idx] = { center - extents, center + extents };
+			batch.set(idx, boxes[idx]);
+		}
+
+		std::vector<Frustum> frustums(mNumQueries);
+		for (auto& frustum : frustums)
+		{
+			const glm::vec3 eye{ position(rng), 10.0f, position(rng) };
+			const glm::vec3 target{ position(rng), 0.0f, position(rng) };
+
+			frustum.fromMatrix(glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f) *
+				glm::lookAt(eye, target, glm::vec3(0.0f, 1.0f, 0.0f)));
+		}
+
+		uint64_t numContains{ 0 };
+		auto startTime = BenchmarkClock::now();
+
+		for (const auto& frustum : frustums)
+		{
+			for (const auto& box : boxes)
+			{
+				numContains += frustum.contains(box) ? 1 : 0;
+			}
+		}
+
+		const double containsTime = getElapsedMs(startTime) / mNumQueries;
+
+		std::vector<uint64_t> scalarVisibility;
+		std::vector<uint64_t> visibility;
+		uint32_t numMismatches{ 0 };
+		double scalarTime{ 0.0 };
+		double simdTime{ 0.0 };
+
+		for (const auto& frustum : frustums)
+		{
+			startTime = BenchmarkClock::now();
+			batch.cullScalar(frustum, scalarVisibility);
+			scalarTime += getElapsedMs(startTime);
+
+			startTime = BenchmarkClock::now();
+			batch.cull(frustum, visibility);
+			simdTime += getElapsedMs(startTime);
+
+			numMismatches += scalarVisibility != visibility ? 1 : 0;
+		}
+
+		LogInfo("  batch: Frustum::contains %.4f ms, scalar %.4f ms, simd %.4f ms (%llu visible by contains)", containsTime,
+			scalarTime / mNumQueries, simdTime / mNumQueries, (unsigned long long)numContains);
+
+		if (numMismatches > 0)
+		{
+			LogError("SIMD and scalar culling disagree for %u of %u frustums!!", numMismatches, mNumQueries);
+			mResult = false;
+		}
+
+		runReferenceCulling(boxes, batch, frustums);
+	}
+
+	void CullingBenchmark::runReferenceCulling(const std::vector<BoundingBox>& boxes, const BoundingBoxBatch& batch,
+		const std::vector<Frustum>& frustums)
+	{
+		// the reference of the gpu culling shader has to agree with the cpu batch test box for box
+		constexpr uint32_t kNumDraws = 16;
+		const uint32_t numInstances = (uint32_t)boxes.size();
+
+		std::vector<CullingPass::InstanceData> instances(numInstances);
+		std::vector<CullingPass::DrawData> draws(kNumDraws);
+
+		for (uint32_t idx = 0; idx < numInstances; idx++)
+		{
+			instances[idx] = {
+				.center = boxes[idx].getCenter(),
+				.drawIndex = idx % kNumDraws,
+				.extents = 0.5f * (boxes[idx].max - boxes[idx].min),
+				.payloadIndex = idx
+			};
+		}
+
+		for (uint32_t idx = 1; idx < kNumDraws; idx++)
+		{
+			draws[idx].firstOutput = draws[idx - 1].firstOutput + (numInstances + kNumDraws - 1 - (idx - 1)) / kNumDraws;
+		}
+
+		std::vector<DrawIndexedIndirectArgs> args;
+		std::vector<uint32_t> outputs;
+		std::vector<uint64_t> scalarVisibility;
+		std::vector<uint64_t> referenceVisibility;
+		uint32_t numMismatches{ 0 };
+		double referenceTime{ 0.0 };
+
+		for (const auto& frustum : frustums)
+		{
+			auto startTime = BenchmarkClock::now();
+			CullingPass::cullReference(frustum, instances, draws, args, outputs);
+			referenceTime += getElapsedMs(startTime);
+
+			batch.cullScalar(frustum, scalarVisibility);
+			referenceVisibility.assign(scalarVisibility.size(), 0);
+
+			// every surviving payload has to sit inside the output window of its own draw
+			bool valid{ true };
+			for (uint32_t drawIdx = 0; drawIdx < kNumDraws; drawIdx++)
+			{
+				for (uint32_t slot = 0; slot < args[drawIdx].instanceCount; slot++)
+				{
+					const uint32_t payload = outputs[draws[drawIdx].firstOutput + slot];
+					if (payload >= numInstances || instances[payload].drawIndex != drawIdx)
+					{
+						valid = false;
+						continue;
+					}
+
+					referenceVisibility[payload >> 6] |= 1ull << (payload & 63);
+				}
+			}
+
+			numMismatches += !valid || referenceVisibility != scalarVisibility ? 1 : 0;
+		}
+
+		LogInfo("  reference: gpu culling reference %.4f ms", referenceTime / mNumQueries);
+
+		if (numMismatches > 0)
+		{
+			LogError("GPU culling reference and scalar culling disagree for %u of %u frustums!!", numMismatches,
+				(uint32_t)frustums.size());
+			mResult = false;
+		}
+	}
+}
+
+using namespace Trinity;
+
+int main(int argc, char* argv[])
+{
+	CLI::App cliApp{ "Culling Benchmark" };
+	std::vector<uint32_t> instanceCounts{ 1000, 5000, 10000, 50000, 100000 };
+	uint32_t numQueries{ 100 };
+
+	cliApp.add_option<std::vector<uint32_t>>("-n, --instances, instances", instanceCounts, "Instance Counts");
+	cliApp.add_option<uint32_t>("-q, --queries, queries", numQueries, "Queries Per Count");
+	CLI11_PARSE(cliApp, argc, argv);
+
+	static CullingBenchmark app;
+	app.setInstanceCounts(std::move(instanceCounts));
+	app.setNumQueries(numQueries);
+
+	if (!app.run(LogLevel::Info))
+	{
+		return -1;
+	}
+
+	return 0;
+}
@@ -20,6 +20,8 @@ namespace Trinity
 		void setFileName(const std::string& fileName);
 		void setOutputFileName(const std::string& fileName);
 		void setAnimated(bool animated);
+		void setCompact(bool compact);
+		void setMeshlets(bool meshlets);
 
 	protected:
 
@@ -30,5 +32,7 @@ namespace Trinity
 		std::string mFileName;
 		std::string mOutputFileName;
 		bool mAnimated{ false };
+		bool mCompact{ false };
+		bool mMeshlets{ false };
 	};
 }
\ No newline at end of file
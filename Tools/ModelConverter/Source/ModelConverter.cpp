@@ -12,6 +12,8 @@
 #include "Core/Debugger.h"
 #include "Core/ResourceCache.h"
 #include "Core/Image.h"
+#include "Core/ContentManifest.h"
+#include "Core/PreloadManifest.h"
 #include "VFS/FileSystem.h"
 #include "VFS/DiskFile.h"
 #include "CLI/App.hpp"
@@ -35,6 +37,16 @@ namespace Trinity
 		mAnimated = animated;
 	}
 
+	void ModelConverter::setCompact(bool compact)
+	{
+		mCompact = compact;
+	}
+
+	void ModelConverter::setMeshlets(bool meshlets)
+	{
+		mMeshlets = meshlets;
+	}
+
 	void ModelConverter::execute()
 	{
 		auto& fileSystem = FileSystem::get();
@@ -58,7 +70,11 @@ namespace Trinity
 		}
 
 		auto resourceCache = std::make_unique<ResourceCache>();
-		auto model = GltfImporter().importModel(mFileName, mOutputFileName, *resourceCache, mAnimated, false);
+		GltfImporter importer;
+		importer.setCompactVertices(mCompact);
+		importer.setMeshlets(mMeshlets);
+
+		auto model = importer.importModel(mFileName, mOutputFileName, *resourceCache, mAnimated, false);
 
 		if (!model)
 		{
@@ -70,6 +86,7 @@ namespace Trinity
 		auto images = resourceCache->getResources<Image>();
 		auto samplers = resourceCache->getResources<Sampler>();
 		auto textures = resourceCache->getResources<Texture>();
+		auto manifests = resourceCache->getResources<ContentManifest>();
 		auto materials = resourceCache->getResources<Material>();
 		auto skeletons = resourceCache->getResources<Skeleton>();
 		auto clips = resourceCache->getResources<AnimationClip>();
@@ -104,6 +121,16 @@ namespace Trinity
 			}
 		}
 
+		for (auto* manifest : manifests)
+		{
+			if (!manifest->write())
+			{
+				LogError("ContentManifest::write() failed!!");
+				mResult = false;
+				return;
+			}
+		}
+
 		for (auto* material : materials)
 		{
 			if (!material->write())
@@ -140,6 +167,17 @@ namespace Trinity
 			mResult = false;
 			return;
 		}
+
+		PreloadManifest preloadManifest;
+		preloadManifest.setFileName(PreloadManifest::getManifestFileName(mOutputFileName));
+		preloadManifest.addResources(*resourceCache);
+
+		if (!preloadManifest.write())
+		{
+			LogError("PreloadManifest::write() failed for: %s!!", preloadManifest.getFileName().c_str());
+			mResult = false;
+			return;
+		}
 	}
 }
 
@@ -151,16 +189,22 @@ int main(int argc, char* argv[])
 	std::string fileName;
 	std::string outputFileName;
 	bool animated{ false };
+	bool compact{ false };
+	bool meshlets{ false };
 
 	cliApp.add_option<std::string>("-f, --filename, filename", fileName, "Filename")->required();
 	cliApp.add_option<std::string>("-o, --output, output", outputFileName, "Output Filename")->required();
 	cliApp.add_option<bool>("-a, --animated, animated", animated, "Animated?");
+	cliApp.add_option<bool>("-c, --compact, compact", compact, "Compact vertices?");
+	cliApp.add_option<bool>("-m, --meshlets, meshlets", meshlets, "Build meshlets?");
 	CLI11_PARSE(cliApp, argc, argv);
 
 	static ModelConverter app;
 	app.setFileName(fileName);
 	app.setOutputFileName(outputFileName);
 	app.setAnimated(animated);
+	app.setCompact(compact);
+	app.setMeshlets(meshlets);
 
 	if (!app.run(LogLevel::Info))
 	{
@@ -19,6 +19,8 @@ namespace Trinity
 
 		virtual void setFileName(const std::string& fileName);
 		virtual void setOutputFileName(const std::string& fileName);
+		virtual void setCompact(bool compact);
+		virtual void setMeshlets(bool meshlets);
 
 	protected:
 
@@ -28,5 +30,7 @@ namespace Trinity
 
 		std::string mFileName;
 		std::string mOutputFileName;
+		bool mCompact{ false };
+		bool mMeshlets{ false };
 	};
 }
\ No newline at end of file
@@ -10,6 +10,8 @@
 #include "Core/Debugger.h"
 #include "Core/ResourceCache.h"
 #include "Core/Image.h"
+#include "Core/ContentManifest.h"
+#include "Core/PreloadManifest.h"
 #include "VFS/FileSystem.h"
 #include "VFS/DiskFile.h"
 #include "CLI/App.hpp"
@@ -28,6 +30,16 @@ namespace Trinity
 		mOutputFileName = fileName;
 	}
 
+	void SceneConverter::setCompact(bool compact)
+	{
+		mCompact = compact;
+	}
+
+	void SceneConverter::setMeshlets(bool meshlets)
+	{
+		mMeshlets = meshlets;
+	}
+
 	void SceneConverter::execute()
 	{
 		auto& fileSystem = FileSystem::get();
@@ -50,7 +62,11 @@ namespace Trinity
 			return;
 		}
 
-		auto scene = GltfImporter().importScene(mFileName, mOutputFileName, *mResourceCache, false);
+		GltfImporter importer;
+		importer.setCompactVertices(mCompact);
+		importer.setMeshlets(mMeshlets);
+
+		auto scene = importer.importScene(mFileName, mOutputFileName, *mResourceCache, false);
 		if (!scene)
 		{
 			LogError("GltfImporter::importScene() failed for: %s!!", mFileName.c_str());
@@ -61,6 +77,7 @@ namespace Trinity
 		auto images = mResourceCache->getResources<Image>();
 		auto samplers = mResourceCache->getResources<Sampler>();
 		auto textures = mResourceCache->getResources<Texture>();
+		auto manifests = mResourceCache->getResources<ContentManifest>();
 		auto materials = mResourceCache->getResources<Material>();
 		auto models = mResourceCache->getResources<Model>();
 
@@ -94,6 +111,16 @@ namespace Trinity
 			}
 		}
 
+		for (auto* manifest : manifests)
+		{
+			if (!manifest->write())
+			{
+				LogError("ContentManifest::write() failed!!");
+				mResult = false;
+				return;
+			}
+		}
+
 		for (auto* material : materials)
 		{
 			if (!material->write())
@@ -120,6 +147,17 @@ namespace Trinity
 			mResult = false;
 			return;
 		}
+
+		PreloadManifest preloadManifest;
+		preloadManifest.setFileName(PreloadManifest::getManifestFileName(mOutputFileName));
+		preloadManifest.addResources(*mResourceCache);
+
+		if (!preloadManifest.write())
+		{
+			LogError("PreloadManifest::write() failed for: %s!!", preloadManifest.getFileName().c_str());
+			mResult = false;
+			return;
+		}
 	}
 }
 
@@ -130,14 +168,20 @@ int main(int argc, char* argv[])
 	CLI::App cliApp{ "Scene Converter" };
 	std::string fileName;
 	std::string outputFileName;
+	bool compact{ false };
+	bool meshlets{ false };
 
 	cliApp.add_option<std::string>("-f, --filename, filename", fileName, "Filename")->required();
 	cliApp.add_option<std::string>("-o, --output, output", outputFileName, "Output Filename")->required();
+	cliApp.add_option<bool>("-c, --compact, compact", compact, "Compact vertices?");
+	cliApp.add_option<bool>("-m, --meshlets, meshlets", meshlets, "Build meshlets?");
 	CLI11_PARSE(cliApp, argc, argv);
 
 	static SceneConverter app;
 	app.setFileName(fileName);
 	app.setOutputFileName(outputFileName);
+	app.setCompact(compact);
+	app.setMeshlets(meshlets);
 
 	if (!app.run(LogLevel::Info))
 	{
@@ -10,6 +10,8 @@
 #include "Core/Logger.h"
 #include "Core/Debugger.h"
 #include "Core/Image.h"
+#include "Core/ContentManifest.h"
+#include "Core/PreloadManifest.h"
 #include "Core/ResourceCache.h"
 #include "VFS/FileSystem.h"
 #include "CLI/App.hpp"
@@ -59,6 +61,7 @@ namespace Trinity
 		auto images = resourceCache->getResources<Image>();
 		auto samplers = resourceCache->getResources<Sampler>();
 		auto textures = resourceCache->getResources<Texture>();
+		auto manifests = resourceCache->getResources<ContentManifest>();
 		auto materials = resourceCache->getResources<Material>();
 
 		for (auto* image : images)
@@ -91,6 +94,16 @@ namespace Trinity
 			}
 		}
 
+		for (auto* manifest : manifests)
+		{
+			if (!manifest->write())
+			{
+				LogError("ContentManifest::write() failed!!");
+				mResult = false;
+				return;
+			}
+		}
+
 		for (auto* material : materials)
 		{
 			if (!material->write())
@@ -107,6 +120,17 @@ namespace Trinity
 			mResult = false;
 			return;
 		}
+
+		PreloadManifest preloadManifest;
+		preloadManifest.setFileName(PreloadManifest::getManifestFileName(mOutputFileName));
+		preloadManifest.addResources(*resourceCache);
+
+		if (!preloadManifest.write())
+		{
+			LogError("PreloadManifest::write() failed for: %s!!", preloadManifest.getFileName().c_str());
+			mResult = false;
+			return;
+		}
 	}
 }
 
@@ -11,6 +11,8 @@
 #include "Core/Logger.h"
 #include "Core/Debugger.h"
 #include "Core/Image.h"
+#include "Core/ContentManifest.h"
+#include "Core/PreloadManifest.h"
 #include "Core/ResourceCache.h"
 #include "VFS/FileSystem.h"
 #include "VFS/DiskFile.h"
@@ -91,6 +93,7 @@ namespace Trinity
 		auto images = resourceCache->getResources<Image>();
 		auto samplers = resourceCache->getResources<Sampler>();
 		auto textures = resourceCache->getResources<Texture>();
+		auto manifests = resourceCache->getResources<ContentManifest>();
 		auto materials = resourceCache->getResources<Material>();
 		auto heightMaps = resourceCache->getResources<HeightMap>();
 
@@ -124,6 +127,16 @@ namespace Trinity
 			}
 		}
 
+		for (auto* manifest : manifests)
+		{
+			if (!manifest->write())
+			{
+				LogError("ContentManifest::write() failed!!");
+				mResult = false;
+				return;
+			}
+		}
+
 		for (auto* material : materials)
 		{
 			if (!material->write())
@@ -150,6 +163,17 @@ namespace Trinity
 			mResult = false;
 			return;
 		}
+
+		PreloadManifest preloadManifest;
+		preloadManifest.setFileName(PreloadManifest::getManifestFileName(outputFileName));
+		preloadManifest.addResources(*resourceCache);
+
+		if (!preloadManifest.write())
+		{
+			LogError("PreloadManifest::write() failed for: %s!!", preloadManifest.getFileName().c_str());
+			mResult = false;
+			return;
+		}
 	}
 }
 